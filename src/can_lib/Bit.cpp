@@ -33,34 +33,19 @@
 #include "TimeQuanta.h"
 #include "FrameFlags.h"
 #include "Bit.h"
+#include "BitFrame.h"
 
 
-can::Bit::Bit(BitFrame *parent, BitKind kind, BitVal val, FrameFlags* frm_flags,
-              BitTiming* nbt, BitTiming* dbt):
+can::Bit::Bit(BitFrame *parent, BitKind kind, BitVal val, StuffKind stuff_kind):
               kind_(kind),
               val_(val),
-              stuff_kind_(StuffKind::NoStuff),
-              parent_(parent),
-              frm_flags_(frm_flags),
-              nbt_(nbt),
-              dbt_(dbt)
-{
-    ConstructTQs();
-}
+              stuff_kind_(stuff_kind),
+              parent_(parent != nullptr ? parent->self_.get() : nullptr)
+{}
 
 
-can::Bit::Bit(BitFrame *parent, BitKind kind, BitVal val, FrameFlags* frm_flags,
-              BitTiming* nbt, BitTiming* dbt, StuffKind stuff_kind) :
-              kind_(kind),
-              val_(val),
-              stuff_kind_(stuff_kind),
-              parent_(parent),
-              frm_flags_(frm_flags),
-              nbt_(nbt),
-              dbt_(dbt)
-{
-    ConstructTQs();
-}
+std::atomic<uint64_t> can::Bit::timing_epoch_(0);
+
 
 const can::BitPhase can::Bit::def_bit_phases[] =
     {BitPhase::Sync, BitPhase::Prop, BitPhase::Ph1, BitPhase::Ph2};
@@ -93,9 +78,9 @@ bool can::Bit::IsStuffBit()
 
 std::string can::Bit::GetBitKindName()
 {
-    for (size_t i = 0; i < sizeof(bit_kind_names_) / sizeof(BitKindName); i++)
-        if (bit_kind_names_[i].kind == kind_)
-            return bit_kind_names_[i].name;
+    size_t kind = static_cast<size_t>(kind_);
+    if (kind < sizeof(bit_kind_names_) / sizeof(bit_kind_names_[0]))
+        return std::string(bit_kind_names_[kind]);
     return "<INVALID_BIT_TYPE_NAME>";
 }
 
@@ -144,9 +129,18 @@ bool can::Bit::IsSingleBitField()
 }
 
 
+
+
 bool can::Bit::HasPhase(BitPhase phase)
 {
-    for (auto &tq : tqs_)
+    Detail *detail = GetDetail();
+    if (detail == nullptr || !detail->materialized) {
+        uint32_t phase_tqs[4], phase_brp[4];
+        GetPhases(phase_tqs, phase_brp);
+        return phase_tqs[static_cast<size_t>(phase)] > 0;
+    }
+
+    for (auto &tq : detail->tqs)
         if (tq.bit_phase() == phase)
             return true;
 
@@ -156,18 +150,22 @@ bool can::Bit::HasPhase(BitPhase phase)
 
 bool can::Bit::HasNonDefVals()
 {
-    for (auto &tq : tqs_)
-        if (tq.HasNonDefVals())
-            return true;
-
-    return false;
+    Detail *detail = GetDetail();
+    return detail != nullptr && !detail->forced.empty();
 }
 
 
 size_t can::Bit::GetPhaseLenTQ(BitPhase phase)
 {
-    return std::count_if(tqs_.begin(), tqs_.end(),
-            [phase](TimeQuanta tq)
+    Detail *detail = GetDetail();
+    if (detail == nullptr || !detail->materialized) {
+        uint32_t phase_tqs[4], phase_brp[4];
+        GetPhases(phase_tqs, phase_brp);
+        return phase_tqs[static_cast<size_t>(phase)];
+    }
+
+    return std::count_if(detail->tqs.begin(), detail->tqs.end(),
+            [phase](const TimeQuanta &tq)
         {
             if (tq.bit_phase() == phase)
                 return true;
@@ -178,11 +176,18 @@ size_t can::Bit::GetPhaseLenTQ(BitPhase phase)
 
 size_t can::Bit::GetPhaseLenCycles(BitPhase phase)
 {
+    Detail *detail = GetDetail();
+    if (detail == nullptr || !detail->materialized) {
+        uint32_t phase_tqs[4], phase_brp[4];
+        GetPhases(phase_tqs, phase_brp);
+        return phase_tqs[static_cast<size_t>(phase)] * phase_brp[static_cast<size_t>(phase)];
+    }
+
     size_t num_cycles = 0;
 
-    for (auto &tq : tqs_)
+    for (auto &tq : detail->tqs)
         if (tq.bit_phase() == phase)
-            num_cycles += tq.getLengthCycles();
+            num_cycles += tq.len_;
 
     return num_cycles;
 }
@@ -190,28 +195,74 @@ size_t can::Bit::GetPhaseLenCycles(BitPhase phase)
 
 size_t can::Bit::GetLenTQ()
 {
-    size_t n_tqs = 0;
-
-    for (auto &phase : def_bit_phases)
-        n_tqs += GetPhaseLenTQ(phase);
+    Detail *detail = GetDetail();
+    if (detail == nullptr || !detail->materialized) {
+        uint32_t phase_tqs[4], phase_brp[4];
+        GetPhases(phase_tqs, phase_brp);
+        return phase_tqs[0] + phase_tqs[1] + phase_tqs[2] + phase_tqs[3];
+    }
 
-    return n_tqs;
+    return detail->tqs.size();
 }
 
 
 size_t can::Bit::GetLenCycles()
 {
-    size_t n_cycles = 0;
+    Detail *detail = GetDetail();
+    if (detail == nullptr) {
+        // Bits without bit rate shift are most common
+        BitTiming *nbt = frame()->nbt_;
+        if (frame()->frm_flags_.is_brs() == BrsFlag::NoShift ||
+            frame()->frm_flags_.is_fdf() == FrameKind::Can20)
+            return (1 + nbt->prop_ + nbt->ph1_ + nbt->ph2_) * nbt->brp_;
+
+        BitTiming *tseg1_bt = GetPhaseBitTiming(BitPhase::Ph1);
+        BitTiming *tseg2_bt = GetPhaseBitTiming(BitPhase::Ph2);
+        return (1 + tseg1_bt->prop_ + tseg1_bt->ph1_) * tseg1_bt->brp_ +
+               tseg2_bt->ph2_ * tseg2_bt->brp_;
+    }
+    if (!detail->materialized) {
+        uint32_t phase_tqs[4], phase_brp[4];
+        GetPhases(phase_tqs, phase_brp);
+        return phase_tqs[0] * phase_brp[0] + phase_tqs[1] * phase_brp[1] +
+               phase_tqs[2] * phase_brp[2] + phase_tqs[3] * phase_brp[3];
+    }
+
+    if (detail->tqs.empty())
+        return 0;
+    return detail->tqs.back().offset_ + detail->tqs.back().len_;
+}
+
+
+size_t can::Bit::GetTQLenCycles(size_t index)
+{
+    assert(index < GetLenTQ() && "Bit does not have so many time quantas");
+
+    Detail *detail = GetDetail();
+    if (detail != nullptr && detail->materialized)
+        return detail->tqs[index].len_;
+
+    uint32_t phase_tqs[4], phase_brp[4];
+    GetPhases(phase_tqs, phase_brp);
+
+    size_t phase = 0;
+    while (index >= phase_tqs[phase])
+        index -= phase_tqs[phase++];
+    return phase_brp[phase];
+}
 
-    for (auto &phase : def_bit_phases)
-        n_cycles += GetPhaseLenCycles(phase);
 
-    return n_cycles;
+bool can::Bit::IsMaterialized()
+{
+    Detail *detail = GetDetail();
+    return detail != nullptr && detail->materialized;
 }
 
 
 size_t can::Bit::ShortenPhase(BitPhase phase, size_t n_tqs)
 {
+    timing_epoch_++;
+
     size_t phase_len = GetPhaseLenTQ(phase);
     size_t shorten_by = n_tqs;
 
@@ -223,22 +274,37 @@ size_t can::Bit::ShortenPhase(BitPhase phase, size_t n_tqs)
     if (phase_len < n_tqs)
         shorten_by = phase_len;
 
-    // Following assumes that phase is contiguous within a bit (resonable assumption)
-    auto tq_it = GetLastTQIter(phase);
-    for (size_t i = 0; i < shorten_by; i++)
-    {
-        tq_it = tqs_.erase(tq_it);
-        if (tqs_.empty())
-            break;
-        tq_it--;
+    Detail &detail = MakeDetail();
+    if (!detail.materialized) {
+        detail.phase_tqs[static_cast<size_t>(phase)] -= static_cast<uint32_t>(shorten_by);
+        return shorten_by;
     }
 
+    // Following assumes that phase is contiguous within a bit (resonable assumption)
+    size_t last = static_cast<size_t>(GetLastTQIter(phase) - detail.tqs.begin());
+    EraseTQs(last + 1 - shorten_by, shorten_by);
+
     return shorten_by;
 }
 
 
 void can::Bit::LengthenPhase(BitPhase phase, size_t n_tqs)
 {
+    timing_epoch_++;
+
+    BitTiming *timing = GetPhaseBitTiming(phase);
+    size_t p = static_cast<size_t>(phase);
+    Detail &detail = MakeDetail();
+
+    // Phase can be kept compact only if all its time quantas have equal length
+    if (!detail.materialized &&
+        (detail.phase_tqs[p] == 0 || detail.phase_brp[p] == timing->brp_))
+    {
+        detail.phase_tqs[p] += static_cast<uint32_t>(n_tqs);
+        detail.phase_brp[p] = static_cast<uint32_t>(timing->brp_);
+        return;
+    }
+
     auto tq_iter = GetLastTQIter(phase);
 
     /*
@@ -249,19 +315,16 @@ void can::Bit::LengthenPhase(BitPhase phase, size_t n_tqs)
     if (GetPhaseLenTQ(phase) > 0)
         tq_iter++;
 
-    BitTiming *timing = GetPhaseBitTiming(phase);
-    for (size_t i = 0; i < n_tqs; i++)
-        tqs_.insert(tq_iter, TimeQuanta(this, timing->brp_, phase));
+    InsertTQs(static_cast<size_t>(tq_iter - detail.tqs.begin()), n_tqs, timing->brp_, phase);
 }
 
 
-std::list<can::TimeQuanta>::iterator can::Bit::GetTQIter(size_t index)
+std::vector<can::TimeQuanta>::iterator can::Bit::GetTQIter(size_t index)
 {
-    assert(index < tqs_.size() && "Bit does not have so many time quantas");
+    Detail &detail = Materialize();
+    assert(index < detail.tqs.size() && "Bit does not have so many time quantas");
 
-    auto tq_iter = tqs_.begin();
-    std::advance(tq_iter, index);
-    return tq_iter;
+    return detail.tqs.begin() + static_cast<std::ptrdiff_t>(index);
 }
 
 
@@ -270,39 +333,56 @@ can::TimeQuanta* can::Bit::GetTQ(size_t index)
     return &(*GetTQIter(index));
 }
 
-can::Cycle* can::Bit::GetCycle(size_t index)
+can::Cycle can::Bit::GetCycle(size_t index)
 {
-    auto tq = GetTQIter(0);
-    auto cycle = tq->GetCycleBitValIter(0);
-    size_t cnt = 0;
-    while (cnt != index) {
-        if (&(*cycle) == tq->getCycleBitValue(tq->getLengthCycles() - 1)) {
-            tq++;
-            cycle = tq->GetCycleBitValIter(0);
-        } else {
-            cycle++;
-        }
-        cnt++;
-    }
-    return &(*cycle);
+    Materialize();
+    assert(index < GetLenCycles() && "Bit does not have so many cycles");
+
+    return Cycle(this, index);
+}
+
+size_t can::Bit::GetCycleIndex(can::Cycle cycle)
+{
+    assert(cycle.bit() == this && "Cycle is not part of this bit");
+
+    return cycle.offset();
 }
 
-size_t can::Bit::GetCycleIndex(can::Cycle* cycle)
+size_t can::Bit::GetValRunEnd(size_t offset, BitVal *val)
 {
-    auto tq = GetTQIter(0);
-    auto curr_cycle = tq->GetCycleBitValIter(0);
-    size_t cnt = 0;
-    while (&(*curr_cycle) != cycle) {
-        if (&(*curr_cycle) == tq->getCycleBitValue(tq->getLengthCycles() - 1)) {
-            tq++;
-            assert (tq != tqs_.end());
-            curr_cycle = tq->GetCycleBitValIter(0);
-        } else {
-            curr_cycle++;
+    size_t len = GetLenCycles();
+    Detail *detail = GetDetail();
+    if (detail == nullptr || detail->forced.empty()) {
+        *val = val_;
+        return len;
+    }
+
+    std::vector<ForcedRun> &forced = detail->forced;
+    const ForcedRun *run = FindForcedRun(offset);
+    BitVal run_val = (run == nullptr) ? val_ : run->val;
+
+    // Walk alternating default / forced segments until value changes
+    auto it = std::lower_bound(forced.begin(), forced.end(), offset,
+                    [](const ForcedRun &r, size_t off) { return r.offset + r.len <= off; });
+    size_t pos = offset;
+    while (pos < len)
+    {
+        size_t seg_end = len;
+        BitVal seg_val = val_;
+        if (it != forced.end() && it->offset <= pos) {
+            seg_end = it->offset + it->len;
+            seg_val = it->val;
+            it++;
+        } else if (it != forced.end()) {
+            seg_end = it->offset;
         }
-        cnt++;
+        if (seg_val != run_val)
+            break;
+        pos = seg_end;
     }
-    return cnt;
+
+    *val = run_val;
+    return pos;
 }
 
 can::TimeQuanta* can::Bit::GetTQ(BitPhase phase, size_t index)
@@ -312,11 +392,12 @@ can::TimeQuanta* can::Bit::GetTQ(BitPhase phase, size_t index)
     assert(phase_len > 0 && "Bit phase does not exist");
     assert(index < phase_len && "Bit does not have so many time quantas");
 
+    Materialize();
+
     // Assumes phase is contiguous, reasonable assumption.
     auto time_quanta_iterator = GetFirstTQIter(phase);
-    std::advance(time_quanta_iterator, index);
 
-    return &(*time_quanta_iterator);
+    return &time_quanta_iterator[static_cast<std::ptrdiff_t>(index)];
 }
 
 
@@ -325,9 +406,7 @@ bool can::Bit::ForceTQ(size_t index, BitVal value)
     if (index >= GetLenTQ())
         return false;
 
-    auto tq_iter = tqs_.begin();
-    std::advance(tq_iter, index);
-    tq_iter->ForceVal(value);
+    Materialize().tqs[index].ForceVal(value);
 
     return true;
 }
@@ -344,14 +423,11 @@ size_t can::Bit::ForceTQ(size_t start, size_t end, BitVal value)
     if (end >= len_tq)
         end_index_clamp = len_tq - 1;
 
-    auto tq_it = tqs_.begin();
-    std::advance(tq_it, start);
+    Detail &detail = Materialize();
 
     size_t i = 0;
-    for (; i <= end_index_clamp - start; i++) {
-        tq_it->ForceVal(value);
-        tq_it++;
-    }
+    for (; i <= end_index_clamp - start; i++)
+        detail.tqs[start + i].ForceVal(value);
 
     return i;
 }
@@ -456,8 +532,8 @@ can::BitPhase can::Bit::NextBitPhase(BitPhase phase)
 
 can::BitRate can::Bit::GetPhaseBitRate(BitPhase phase)
 {
-    if (frm_flags_->is_fdf() == FrameKind::CanFd &&
-        frm_flags_->is_brs() == BrsFlag::DoShift)
+    if (frame()->frm_flags_.is_fdf() == FrameKind::CanFd &&
+        frame()->frm_flags_.is_brs() == BrsFlag::DoShift)
     {
         switch (kind_) {
         case BitKind::Brs:
@@ -489,33 +565,47 @@ can::BitRate can::Bit::GetPhaseBitRate(BitPhase phase)
 can::BitTiming* can::Bit::GetPhaseBitTiming(BitPhase phase)
 {
     if (GetPhaseBitRate(phase) == BitRate::Nominal)
-        return nbt_;
+        return frame()->nbt_;
 
-    return dbt_;
+    return frame()->dbt_;
 }
 
 
 void can::Bit::CorrectPh2LenToNominal()
 {
+    timing_epoch_++;
+
     /* If bit Phase 2 is in data bit rate, then correct its lenght to nominal */
 
-    if (GetPhaseBitTiming(BitPhase::Ph2) == dbt_)
+    if (GetPhaseBitTiming(BitPhase::Ph2) == frame()->dbt_)
     {
+        BitTiming *nbt = frame()->nbt_;
+
         std::cout << "Compensating PH2 of " << GetBitKindName() <<
                      " bit due to inserted Error frame!" << std::endl;
         std::cout << "Lenght before compensation: " <<
                     std::to_string(GetLenCycles()) << std::endl;
 
+        Detail &detail = MakeDetail();
+        if (!detail.materialized) {
+            detail.phase_tqs[static_cast<size_t>(BitPhase::Ph2)] =
+                static_cast<uint32_t>(nbt->ph2_);
+            detail.phase_brp[static_cast<size_t>(BitPhase::Ph2)] =
+                static_cast<uint32_t>(nbt->brp_);
+            std::cout << "Lenght after compensation: " <<
+                        std::to_string(GetLenCycles()) << std::endl;
+            return;
+        }
+
         // Remove all PH2 phases
-        for (auto tqIter = tqs_.begin(); tqIter != tqs_.end();)
-             if (tqIter->bit_phase() == BitPhase::Ph2)
-                 tqIter = tqs_.erase(tqIter);
+        for (size_t i = 0; i < detail.tqs.size();)
+             if (detail.tqs[i].bit_phase() == BitPhase::Ph2)
+                 EraseTQs(i, 1);
              else
-                 tqIter++;
+                 i++;
 
         // Re-create again with nominal bit timing
-        for (size_t i = 0; i < nbt_->ph2_; i++)
-            tqs_.push_back(TimeQuanta(this, nbt_->brp_, BitPhase::Ph2));
+        InsertTQs(detail.tqs.size(), nbt->ph2_, nbt->brp_, BitPhase::Ph2);
 
         std::cout << "Lenght after compensation: " <<
                     std::to_string(GetLenCycles()) << std::endl;
@@ -524,11 +614,14 @@ void can::Bit::CorrectPh2LenToNominal()
 }
 
 
-std::list<can::TimeQuanta>::iterator can::Bit::GetFirstTQIter(BitPhase phase)
+std::vector<can::TimeQuanta>::iterator can::Bit::GetFirstTQIter(BitPhase phase)
 {
+    Detail &detail = Materialize();
+
     if (HasPhase(phase))
     {
-        return std::find_if(tqs_.begin(), tqs_.end(), [phase](TimeQuanta tq)
+        return std::find_if(detail.tqs.begin(), detail.tqs.end(),
+            [phase](const TimeQuanta &tq)
             {
                 if (tq.bit_phase() == phase)
                     return true;
@@ -539,18 +632,20 @@ std::list<can::TimeQuanta>::iterator can::Bit::GetFirstTQIter(BitPhase phase)
 }
 
 
-std::list<can::TimeQuanta>::iterator can::Bit::GetLastTQIter(BitPhase phase)
+std::vector<can::TimeQuanta>::iterator can::Bit::GetLastTQIter(BitPhase phase)
 {
+    Detail &detail = Materialize();
+
     if (HasPhase(phase))
     {
         auto iterator = GetFirstTQIter(phase);
 
-        assert(iterator != tqs_.end() && "Should not point the the end!");
+        assert(iterator != detail.tqs.end() && "Should not point the the end!");
 
-        std::list<can::TimeQuanta>::iterator rv = iterator;
+        std::vector<can::TimeQuanta>::iterator rv = iterator;
         while (true) {
             iterator++;
-            if (iterator == tqs_.end())
+            if (iterator == detail.tqs.end())
                 return rv;
             if (iterator->bit_phase() != phase)
                 return rv;
@@ -561,26 +656,298 @@ std::list<can::TimeQuanta>::iterator can::Bit::GetLastTQIter(BitPhase phase)
 }
 
 
-void can::Bit::ConstructTQs()
+void can::Bit::GetDefPhases(uint32_t *phase_tqs, uint32_t *phase_brp)
 {
-    BitTiming *tseg1_bt = nbt_;
-    BitTiming *tseg2_bt = nbt_;
+    BitTiming *tseg1_bt = frame()->nbt_;
+    BitTiming *tseg2_bt = frame()->nbt_;
 
     // Here Assume that PH1 has the same bit rate as TSEG1 which is reasonable
     // as there is no bit-rate shift within TSEG1
     if (GetPhaseBitRate(BitPhase::Ph1) == BitRate::Data)
-        tseg1_bt = dbt_;
+        tseg1_bt = frame()->dbt_;
     if (GetPhaseBitRate(BitPhase::Ph2) == BitRate::Data)
-        tseg2_bt = dbt_;
-
-    // Construct TSEG 1
-    tqs_.push_back(TimeQuanta(this, tseg1_bt->brp_, BitPhase::Sync));
-    for (size_t i = 0; i < tseg1_bt->prop_; i++)
-        tqs_.push_back(TimeQuanta(this, tseg1_bt->brp_, BitPhase::Prop));
-    for (size_t i = 0; i < tseg1_bt->ph1_; i++)
-        tqs_.push_back(TimeQuanta(this, tseg1_bt->brp_, BitPhase::Ph1));
-
-    // Construct TSEG 2
-    for (size_t i = 0; i < tseg2_bt->ph2_; i++)
-        tqs_.push_back(TimeQuanta(this, tseg2_bt->brp_, BitPhase::Ph2));
-}
\ No newline at end of file
+        tseg2_bt = frame()->dbt_;
+
+    phase_tqs[static_cast<size_t>(BitPhase::Sync)] = 1;
+    phase_tqs[static_cast<size_t>(BitPhase::Prop)] = static_cast<uint32_t>(tseg1_bt->prop_);
+    phase_tqs[static_cast<size_t>(BitPhase::Ph1)] = static_cast<uint32_t>(tseg1_bt->ph1_);
+    phase_tqs[static_cast<size_t>(BitPhase::Ph2)] = static_cast<uint32_t>(tseg2_bt->ph2_);
+
+    phase_brp[static_cast<size_t>(BitPhase::Sync)] = static_cast<uint32_t>(tseg1_bt->brp_);
+    phase_brp[static_cast<size_t>(BitPhase::Prop)] = static_cast<uint32_t>(tseg1_bt->brp_);
+    phase_brp[static_cast<size_t>(BitPhase::Ph1)] = static_cast<uint32_t>(tseg1_bt->brp_);
+    phase_brp[static_cast<size_t>(BitPhase::Ph2)] = static_cast<uint32_t>(tseg2_bt->brp_);
+}
+
+
+void can::Bit::GetPhases(uint32_t *phase_tqs, uint32_t *phase_brp)
+{
+    Detail *detail = GetDetail();
+    if (detail == nullptr) {
+        GetDefPhases(phase_tqs, phase_brp);
+        return;
+    }
+    std::copy(detail->phase_tqs, detail->phase_tqs + 4, phase_tqs);
+    std::copy(detail->phase_brp, detail->phase_brp + 4, phase_brp);
+}
+
+
+can::Bit::Detail* can::Bit::GetDetail()
+{
+    if (!has_detail_)
+        return nullptr;
+
+    auto it = frame()->bit_details_.find(slot_);
+    if (it == frame()->bit_details_.end())
+        return nullptr;
+    return &it->second;
+}
+
+
+can::Bit::Detail& can::Bit::MakeDetail()
+{
+    Detail *detail = GetDetail();
+    if (detail != nullptr)
+        return *detail;
+
+    // Time quantas are not created here, only lengths of phases are stored. Most of bits
+    // are never accessed on time quanta / cycle level.
+    Detail &new_detail = frame()->bit_details_[slot_];
+    new_detail = Detail();
+    GetDefPhases(new_detail.phase_tqs, new_detail.phase_brp);
+    has_detail_ = true;
+
+    return new_detail;
+}
+
+
+can::Bit::Detail& can::Bit::Materialize()
+{
+    Detail &detail = MakeDetail();
+    if (detail.materialized)
+        return detail;
+
+    detail.tqs.reserve(GetLenTQ());
+    detail.materialized = true;
+
+    for (BitPhase phase : def_bit_phases)
+        InsertTQs(detail.tqs.size(), detail.phase_tqs[static_cast<size_t>(phase)],
+                  detail.phase_brp[static_cast<size_t>(phase)], phase);
+
+    return detail;
+}
+
+
+void can::Bit::InsertTQs(size_t pos, size_t n_tqs, size_t brp, BitPhase phase)
+{
+    std::vector<TimeQuanta> &tqs = MakeDetail().tqs;
+
+    assert(pos <= tqs.size() && "Can't insert time quantas behind end of bit");
+
+    if (n_tqs == 0)
+        return;
+
+    size_t offset = (pos < tqs.size()) ? tqs[pos].offset_ : GetLenCycles();
+    size_t n_cycles = n_tqs * brp;
+
+    InsertCycles(offset, n_cycles);
+    tqs.insert(tqs.begin() + static_cast<std::ptrdiff_t>(pos), n_tqs,
+               TimeQuanta(this, 0, brp, phase));
+
+    for (size_t i = 0; i < n_tqs; i++)
+        tqs[pos + i].offset_ = offset + i * brp;
+    for (size_t i = pos + n_tqs; i < tqs.size(); i++)
+        tqs[i].offset_ += n_cycles;
+}
+
+
+void can::Bit::EraseTQs(size_t pos, size_t n_tqs)
+{
+    std::vector<TimeQuanta> &tqs = MakeDetail().tqs;
+
+    assert(pos + n_tqs <= tqs.size() && "Bit does not have so many time quantas");
+
+    if (n_tqs == 0)
+        return;
+
+    size_t offset = tqs[pos].offset_;
+    size_t end = tqs[pos + n_tqs - 1].offset_ + tqs[pos + n_tqs - 1].len_;
+    size_t n_cycles = end - offset;
+
+    EraseCycles(offset, n_cycles);
+    tqs.erase(tqs.begin() + static_cast<std::ptrdiff_t>(pos),
+              tqs.begin() + static_cast<std::ptrdiff_t>(pos + n_tqs));
+
+    for (size_t i = pos; i < tqs.size(); i++)
+        tqs[i].offset_ -= n_cycles;
+}
+
+
+void can::Bit::ResizeTQ(TimeQuanta *tq, size_t len)
+{
+    std::vector<TimeQuanta> &tqs = MakeDetail().tqs;
+
+    assert(tq >= tqs.data() && tq < tqs.data() + tqs.size() &&
+           "Time quanta is not part of this bit");
+
+    timing_epoch_++;
+
+    if (len > tq->len_)
+        InsertCycles(tq->offset_ + tq->len_, len - tq->len_);
+    else
+        EraseCycles(tq->offset_ + len, tq->len_ - len);
+
+    size_t old_len = tq->len_;
+    tq->len_ = len;
+    for (TimeQuanta *next = tq + 1; next < tqs.data() + tqs.size(); next++)
+        next->offset_ = next->offset_ + len - old_len;
+}
+
+
+void can::Bit::ForceCycles(size_t offset, size_t n_cycles, BitVal val)
+{
+    if (n_cycles == 0)
+        return;
+
+    ReleaseCycles(offset, n_cycles);
+
+    std::vector<ForcedRun> &forced = MakeDetail().forced;
+    auto it = std::lower_bound(forced.begin(), forced.end(), offset,
+                    [](const ForcedRun &r, size_t off) { return r.offset < off; });
+    it = forced.insert(it, {static_cast<uint32_t>(offset), static_cast<uint32_t>(n_cycles),
+                            val});
+
+    // Merge with neighbouring runs of equal value
+    auto next = it + 1;
+    if (next != forced.end() && next->offset == it->offset + it->len && next->val == val) {
+        it->len += next->len;
+        forced.erase(next);
+    }
+    if (it != forced.begin()) {
+        auto prev = it - 1;
+        if (prev->offset + prev->len == it->offset && prev->val == val) {
+            prev->len += it->len;
+            forced.erase(it);
+        }
+    }
+}
+
+
+void can::Bit::ReleaseCycles(size_t offset, size_t n_cycles)
+{
+    Detail *detail = GetDetail();
+    if (detail == nullptr)
+        return;
+
+    std::vector<ForcedRun> &forced = detail->forced;
+    size_t end = offset + n_cycles;
+
+    // First run which ends behind start of released range
+    auto it = std::lower_bound(forced.begin(), forced.end(), offset,
+                    [](const ForcedRun &r, size_t off) { return r.offset + r.len <= off; });
+    if (it == forced.end() || it->offset >= end)
+        return;
+
+    // Released range is inside of a run -> split it
+    if (it->offset < offset && it->offset + it->len > end) {
+        ForcedRun right = {static_cast<uint32_t>(end),
+                           static_cast<uint32_t>(it->offset + it->len - end), it->val};
+        it->len = static_cast<uint32_t>(offset - it->offset);
+        forced.insert(it + 1, right);
+        return;
+    }
+
+    if (it->offset < offset) {
+        it->len = static_cast<uint32_t>(offset - it->offset);
+        it++;
+    }
+    auto first = it;
+    while (it != forced.end() && it->offset + it->len <= end)
+        it++;
+    if (it != forced.end() && it->offset < end) {
+        it->len -= static_cast<uint32_t>(end - it->offset);
+        it->offset = static_cast<uint32_t>(end);
+    }
+    forced.erase(first, it);
+}
+
+
+bool can::Bit::HasForcedCycles(size_t offset, size_t n_cycles)
+{
+    Detail *detail = GetDetail();
+    if (detail == nullptr)
+        return false;
+
+    std::vector<ForcedRun> &forced = detail->forced;
+    auto it = std::lower_bound(forced.begin(), forced.end(), offset,
+                    [](const ForcedRun &r, size_t off) { return r.offset + r.len <= off; });
+    return it != forced.end() && it->offset < offset + n_cycles;
+}
+
+
+const can::Bit::ForcedRun* can::Bit::FindForcedRun(size_t offset)
+{
+    Detail *detail = GetDetail();
+    if (detail == nullptr)
+        return nullptr;
+
+    std::vector<ForcedRun> &forced = detail->forced;
+    auto it = std::upper_bound(forced.begin(), forced.end(), offset,
+                    [](size_t off, const ForcedRun &r) { return off < r.offset; });
+    if (it == forced.begin())
+        return nullptr;
+    it--;
+    if (offset < it->offset + it->len)
+        return &(*it);
+    return nullptr;
+}
+
+
+void can::Bit::InsertCycles(size_t offset, size_t n_cycles)
+{
+    Detail *detail = GetDetail();
+    if (n_cycles == 0 || detail == nullptr)
+        return;
+
+    std::vector<ForcedRun> &forced = detail->forced;
+    auto it = std::lower_bound(forced.begin(), forced.end(), offset,
+                    [](const ForcedRun &r, size_t off) { return r.offset + r.len <= off; });
+
+    // Cycles are inserted inside of a run -> split it
+    if (it != forced.end() && it->offset < offset) {
+        ForcedRun right = {static_cast<uint32_t>(offset),
+                           static_cast<uint32_t>(it->offset + it->len - offset), it->val};
+        it->len = static_cast<uint32_t>(offset - it->offset);
+        it = forced.insert(it + 1, right);
+    }
+
+    for (; it != forced.end(); it++)
+        it->offset += static_cast<uint32_t>(n_cycles);
+}
+
+
+void can::Bit::EraseCycles(size_t offset, size_t n_cycles)
+{
+    Detail *detail = GetDetail();
+    if (n_cycles == 0 || detail == nullptr)
+        return;
+
+    ReleaseCycles(offset, n_cycles);
+
+    std::vector<ForcedRun> &forced = detail->forced;
+    auto it = std::lower_bound(forced.begin(), forced.end(), offset,
+                    [](const ForcedRun &r, size_t off) { return r.offset < off; });
+    for (; it != forced.end(); it++)
+        it->offset -= static_cast<uint32_t>(n_cycles);
+}
+
+
+void can::Bit::RelinkTQs()
+{
+    Detail *detail = GetDetail();
+    if (detail == nullptr)
+        return;
+
+    for (auto &tq : detail->tqs)
+        tq.parent_ = this;
+}
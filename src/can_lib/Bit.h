@@ -31,8 +31,10 @@
 #include <iostream>
 #include <cstdint>
 #include <algorithm>
-#include <list>
+#include <vector>
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <assert.h>
 
 #include "can.h"
@@ -51,13 +53,19 @@
 class can::Bit {
 
     public:
-        Bit(BitFrame *bit_frame, BitKind kind, BitVal val, FrameFlags* frm_flags,
-            BitTiming* nbt, BitTiming* dbt);
-
-        Bit(BitFrame *bit_frame, BitKind kind, BitVal val, FrameFlags* frm_flags,
-            BitTiming* nbt, BitTiming* dbt, StuffKind stuff_kind);
+        /**
+         * Creates a bit of a frame. Bit has default timing of its frame (given by bit rate
+         * of its bit phases) until its time quantas or cycles are modified.
+         * @param parent Frame which holds the bit
+         * @param kind Type of bit
+         * @param val Value of bit
+         * @param stuff_kind Type of stuff bit
+         */
+        Bit(BitFrame *parent, BitKind kind, BitVal val,
+            StuffKind stuff_kind = StuffKind::NoStuff);
 
-        /* Type of bit: SOF, Base Identifier, CRC, ACK, etc... */
+        /* Type of bit: SOF, Base Identifier, CRC, ACK, etc... Bits are indexed by their type
+         * within a frame, so type shall not be changed once bit is inserted to a frame! */
         BitKind kind_;
 
         /* Value on CAN bus: Dominant, Recessive */
@@ -147,6 +155,22 @@ class can::Bit {
          */
         size_t GetLenCycles();
 
+        /**
+         * @param index Index of time quanta (starting with 0)
+         * @returns Length of time quanta on 'index' position in clock cycles.
+         *
+         * Does not materialize time quantas of the bit.
+         */
+        size_t GetTQLenCycles(size_t index);
+
+        /**
+         * Checks if time quantas and cycles of bit were materialized. Until time quantas or
+         * cycles of a bit are accessed, bit holds only lengths of its phases.
+         * @returns true    if bit holds its time quantas and cycles.
+         *          false   if bit holds only lengths of its phases.
+         */
+        bool IsMaterialized();
+
         /**
          * Shortens bit phase by number of Time quantas. If a phase is shortened
          * by more or equal to number of bits that it has, phase is effectively
@@ -180,7 +204,7 @@ class can::Bit {
          *
          * If there are less time quantas within a bit than 'index', aborts.
          */
-        std::list<TimeQuanta>::iterator GetTQIter(size_t index);
+        std::vector<TimeQuanta>::iterator GetTQIter(size_t index);
 
         /**
          * Gets Time Quanta within a bit phase.
@@ -193,16 +217,25 @@ class can::Bit {
         TimeQuanta* GetTQ(BitPhase phase, size_t index);
 
         /**
-         * Gets a cycle within a frame
-         * @param index Index of cycle (within a frame) to return (starting with 0)
-         * @return Pointer to cycle on 'index' position within frame.
+         * Gets a cycle within a bit
+         * @param index Index of cycle (within a bit) to return (starting with 0)
+         * @return Handle to cycle on 'index' position within bit.
          */
-        Cycle* GetCycle(size_t index);
+        Cycle GetCycle(size_t index);
 
         /**
          * @return An index of cycle within bit
          */
-        size_t GetCycleIndex(can::Cycle* cycle);
+        size_t GetCycleIndex(Cycle cycle);
+
+        /**
+         * Finds run of consecutive cycles with equal value.
+         * @param offset Index of first cycle of the run (within a bit)
+         * @param val Value of cycles within the run (output)
+         * @returns Index of first cycle after the run (cycle where value changes, or
+         *          length of bit in cycles).
+         */
+        size_t GetValRunEnd(size_t offset, BitVal *val);
 
         /**
          * Forces a time quanta within a bit to value (Inserts a glitch).
@@ -280,75 +313,220 @@ class can::Bit {
         /**
          * @return iterator to first time quanta of a bit phase.
          */
-        std::list<TimeQuanta>::iterator GetFirstTQIter(BitPhase phase);
+        std::vector<TimeQuanta>::iterator GetFirstTQIter(BitPhase phase);
 
         /**
          * @return iterator to last time quanta of a bit phase.
          */
-        std::list<TimeQuanta>::iterator GetLastTQIter(BitPhase phase);
+        std::vector<TimeQuanta>::iterator GetLastTQIter(BitPhase phase);
+
+        /**
+         * Incremented whenever length of any bit changes. Allows frames to detect that
+         * their time index (position of bits in clock cycles) is stale.
+         */
+        static std::atomic<uint64_t> timing_epoch_;
 
     protected:
 
-        const BitKindName bit_kind_names_[30] =
+        /* Names of bit types (indexed by bit type) */
+        static constexpr std::string_view bit_kind_names_[] =
+        {
+            "SOF",
+            "Base identifer",
+            "Extended identifier",
+            "RTR",
+            "IDE",
+            "SRR",
+            "EDL",
+            "R0 ",
+            "R1 ",
+            "BRS",
+            "ESI",
+            "DLC",
+            "Data field",
+            "St.Ct.",
+            "STP",
+            "CRC",
+            "CRD",
+            "ACK",
+            "ACD",
+            "End of Frame",
+            "Intermission",
+            "Idle",
+            "Suspend",
+            "Active Error flag",
+            "Passive Error flag",
+            "Error delimiter",
+            "Overload flag",
+            "Overload delimiter",
+            "-"
+        };
+
+        /* Bit has timing detail stored by its frame (see 'Detail') */
+        bool has_detail_ = false;
+
+        /* Slot of bit within storage of parent frame */
+        uint32_t slot_ = 0;
+
+        /**
+         * Parent frame which contains this bit. Frame flags and bit timing of a frame
+         * are reached via parent frame. Bit refers to a cell owned by the frame which holds
+         * address of the frame, so that bits need not be re-linked when a frame is moved.
+         */
+        BitFrame *const *parent_;
+
+        /**
+         * @returns Parent frame of the bit.
+         */
+        inline BitFrame* frame() const {
+            return *parent_;
+        };
+
+        /**
+         * Runs of cycles with forced (non-default) value. Sorted by index of first cycle
+         * and not overlapping. Cycles which are not within any run have default value.
+         */
+        struct ForcedRun
         {
-            {BitKind::Sof,                  "SOF"},
-            {BitKind::BaseIdent,            "Base identifer"},
-            {BitKind::ExtIdent,             "Extended identifier"},
-            {BitKind::Rtr,                  "RTR"},
-            {BitKind::Ide,                  "IDE"},
-            {BitKind::Srr,                  "SRR"},
-            {BitKind::Edl,                  "EDL"},
-            {BitKind::R0,                   "R0 "},
-            {BitKind::R1,                   "R1 "},
-            {BitKind::Brs,                  "BRS"},
-            {BitKind::Esi,                  "ESI"},
-            {BitKind::Dlc,                  "DLC"},
-            {BitKind::Data,                 "Data field"},
-            {BitKind::StuffCnt,             "St.Ct."},
-            {BitKind::StuffParity,          "STP"},
-            {BitKind::Crc,                  "CRC"},
-            {BitKind::CrcDelim,             "CRD"},
-            {BitKind::Ack,                  "ACK"},
-            {BitKind::AckDelim,             "ACD"},
-            {BitKind::Eof,                  "End of Frame"},
-            {BitKind::Interm,               "Intermission"},
-            {BitKind::Idle,                 "Idle"},
-            {BitKind::SuspTrans,            "Suspend"},
-            {BitKind::ActErrFlag,           "Active Error flag"},
-            {BitKind::PasErrFlag,           "Passive Error flag"},
-            {BitKind::ErrDelim,             "Error delimiter"},
-            {BitKind::OvrlFlag,             "Overload flag"},
-            {BitKind::OvrlDelim,            "Overload delimiter"},
-            {BitKind::Undefined,            "-"}
+            uint32_t offset;
+            uint32_t len;
+            BitVal val;
         };
 
         /**
-         * Parent frame which contains this bit
+         * Timing of a bit which differs from default timing (phase lengths were changed,
+         * time quantas or cycles were accessed). Bits are small, detail is held by parent
+         * frame only for bits which need it.
          */
-        BitFrame *parent_;
+        struct Detail
+        {
+            /*
+             * Length of each bit phase in time quantas, and length of time quantas of each
+             * bit phase in clock cycles. Describes timing of the bit until it is
+             * materialized.
+             */
+            uint32_t phase_tqs[4];
+            uint32_t phase_brp[4];
+
+            /* Time quantas and cycles were created from lengths of bit phases */
+            bool materialized = false;
+
+            /*
+             * Time quantas within the bit. Empty until bit is materialized. Each time quanta
+             * refers to a range of cycles of the bit, time quantas are ordered as their
+             * cycles.
+             */
+            std::vector<TimeQuanta> tqs;
+
+            /* Runs of forced cycles (see 'ForcedRun') */
+            std::vector<ForcedRun> forced;
+        };
 
-        /*
-         * These hold information about bit timing and fact whether Bit-rate has
-         * shifted so they are important for manipulation of bit cycles!
-         *
-         * Should be provided during creation of Bit and are not copied internally!
+        /**
+         * Gets default lengths of bit phases given by bit timing of a frame.
+         * @param phase_tqs Length of each bit phase in time quantas (output)
+         * @param phase_brp Length of time quantas of each bit phase in cycles (output)
          */
-        FrameFlags* frm_flags_;
-        BitTiming* nbt_;
-        BitTiming* dbt_;
+        void GetDefPhases(uint32_t *phase_tqs, uint32_t *phase_brp);
 
         /**
-         * Time quantas within the bit.
+         * Gets lengths of bit phases (from timing detail, or default ones).
          */
-        std::list<TimeQuanta> tqs_;
+        void GetPhases(uint32_t *phase_tqs, uint32_t *phase_brp);
 
         /**
-         * Constructs time quantas from timing information. Called upon bit creation.
+         * @returns Timing detail of the bit, nullptr if bit has default timing.
          */
-        void ConstructTQs();
+        Detail* GetDetail();
+
+        /**
+         * @returns Timing detail of the bit. Created (with default timing) if bit has none.
+         */
+        Detail& MakeDetail();
+
+        /**
+         * Creates time quantas and cycles from lengths of bit phases. Called when time
+         * quantas or cycles of a bit are accessed for the first time.
+         * @returns Timing detail holding the time quantas.
+         */
+        Detail& Materialize();
 
         /** Default bit-phases present in each bit */
         static const BitPhase def_bit_phases[];
+
+    private:
+        friend class TimeQuanta;
+        friend class Cycle;
+        friend class BitFrame;
+
+        /**
+         * Forces values of range of cycles.
+         * @param offset Index of first cycle to force
+         * @param n_cycles Number of cycles to force
+         * @param val Value to force cycles to
+         */
+        void ForceCycles(size_t offset, size_t n_cycles, BitVal val);
+
+        /**
+         * Releases range of cycles (returns them to default value).
+         * @param offset Index of first cycle to release
+         * @param n_cycles Number of cycles to release
+         */
+        void ReleaseCycles(size_t offset, size_t n_cycles);
+
+        /**
+         * @returns true if any of cycles within range has forced value.
+         */
+        bool HasForcedCycles(size_t offset, size_t n_cycles);
+
+        /**
+         * @returns Run of forced cycles which contains cycle at 'offset', nullptr if the
+         *          cycle has default value.
+         */
+        const ForcedRun* FindForcedRun(size_t offset);
+
+        /**
+         * Inserts cycles with default value, subsequent forced cycles are moved.
+         * @param offset Index of cycle before which cycles are inserted
+         * @param n_cycles Number of cycles to insert
+         */
+        void InsertCycles(size_t offset, size_t n_cycles);
+
+        /**
+         * Removes cycles, subsequent forced cycles are moved.
+         * @param offset Index of first cycle to remove
+         * @param n_cycles Number of cycles to remove
+         */
+        void EraseCycles(size_t offset, size_t n_cycles);
+
+        /**
+         * Inserts time quantas into a bit. Cycles of inserted time quantas have default value.
+         * @param pos Index of time quanta before which new time quantas are inserted
+         * @param n_tqs Number of time quantas to insert
+         * @param brp Length of each inserted time quanta in clock cycles
+         * @param phase Bit phase of inserted time quantas
+         */
+        void InsertTQs(size_t pos, size_t n_tqs, size_t brp, BitPhase phase);
+
+        /**
+         * Removes time quantas (and their cycles) from a bit.
+         * @param pos Index of first time quanta to remove
+         * @param n_tqs Number of time quantas to remove
+         */
+        void EraseTQs(size_t pos, size_t n_tqs);
+
+        /**
+         * Changes length of time quanta. Cycles are added or removed at the end of time quanta.
+         * Added cycles have default value.
+         * @param tq Time quanta to resize (must belong to this bit)
+         * @param len New length of time quanta in clock cycles
+         */
+        void ResizeTQ(TimeQuanta *tq, size_t len);
+
+        /**
+         * Re-links time quantas to this bit (after bit was copied or moved).
+         */
+        void RelinkTQs();
 };
 
 #endif
\ No newline at end of file
@@ -29,10 +29,17 @@
 #include <iostream>
 #include <assert.h>
 #include <iomanip>
+#include <limits>
 
 #include "can.h"
 #include "Bit.h"
 #include "BitFrame.h"
+#include "CrcEngine.h"
+#include "StuffEngine.h"
+
+/* Number of bits in a single chunk of bit storage */
+#define BIT_CHUNK_SIZE 64
+#define CRC_CHECKPOINT_DIST 32
 
 void can::BitFrame::ConstructFrame()
 {
@@ -54,6 +61,8 @@ void can::BitFrame::ConstructFrame()
         UpdateCrcBits();
         InsertFixedStuffToCrc();
     }
+
+    SaveUpdateVals();
 }
 
 
@@ -79,9 +88,85 @@ can::BitFrame::BitFrame(Frame &frame, BitTiming *nbt, BitTiming *dbt):
 }
 
 
+can::BitFrame::BitFrame(const BitFrame &other):
+                Frame(other),
+                bit_chunks_(other.bit_chunks_),
+                free_slots_(other.free_slots_),
+                bit_details_(other.bit_details_),
+                bits_(other.bits_),
+                slot_pos_(other.slot_pos_),
+                index_valid_(other.index_valid_),
+                cycle_pos_(other.cycle_pos_),
+                time_valid_(other.time_valid_),
+                time_epoch_(other.time_epoch_),
+                update_vals_(other.update_vals_),
+                modified_from_(other.modified_from_),
+                crc_states_(other.crc_states_),
+                crc_valid_(other.crc_valid_),
+                crc15_(other.crc15_),
+                crc17_(other.crc17_),
+                crc21_(other.crc21_),
+                crc_len(other.crc_len),
+                stuff_engine_(other.stuff_engine_),
+                dbt_(other.dbt_),
+                nbt_(other.nbt_)
+{
+    std::copy(std::begin(other.kind_pos_), std::end(other.kind_pos_), std::begin(kind_pos_));
+
+    // Bits are in the same slots as in other frame, index and saved state of last
+    // update remain valid. Only links to parent need to be updated.
+    RelinkBits();
+}
+
+
+can::BitFrame::BitFrame(BitFrame &&other):
+                Frame(other),
+                self_(std::move(other.self_)),
+                bit_chunks_(std::move(other.bit_chunks_)),
+                free_slots_(std::move(other.free_slots_)),
+                bit_details_(std::move(other.bit_details_)),
+                bits_(std::move(other.bits_)),
+                slot_pos_(std::move(other.slot_pos_)),
+                index_valid_(other.index_valid_),
+                cycle_pos_(std::move(other.cycle_pos_)),
+                time_valid_(other.time_valid_),
+                time_epoch_(other.time_epoch_),
+                update_vals_(std::move(other.update_vals_)),
+                modified_from_(other.modified_from_),
+                crc_states_(std::move(other.crc_states_)),
+                crc_valid_(other.crc_valid_),
+                crc15_(other.crc15_),
+                crc17_(other.crc17_),
+                crc21_(other.crc21_),
+                crc_len(other.crc_len),
+                stuff_engine_(other.stuff_engine_),
+                stuff_in_(std::move(other.stuff_in_)),
+                stuff_pos_(std::move(other.stuff_pos_)),
+                dbt_(other.dbt_),
+                nbt_(other.nbt_)
+{
+    std::move(std::begin(other.kind_pos_), std::end(other.kind_pos_), std::begin(kind_pos_));
+
+    // Chunks of bits are taken over (not re-allocated), so bits and time quantas stay
+    // where they are. Bits refer to the frame via 'self_' cell which is taken over too.
+    *self_ = this;
+}
+
+
+void can::BitFrame::RelinkBits()
+{
+    for (auto &chunk : bit_chunks_)
+        for (auto &bit : chunk)
+            bit.parent_ = self_.get();
+
+    for (auto &detail : bit_details_)
+        SlotBit(detail.first)->RelinkTQs();
+}
+
+
 void can::BitFrame::UpdateCrcBits()
 {
-    std::list<Bit>::iterator bit_it = GetBitOfIter(0, BitKind::Crc);
+    size_t pos = GetFieldPos(BitKind::Crc)[0];
     uint32_t tmp_crc = crc();
     int i;
 
@@ -92,17 +177,20 @@ void can::BitFrame::UpdateCrcBits()
     else
         i = 16;
 
-    while (bit_it->kind_ == BitKind::Crc)
+    for (; pos < bits_.size(); pos++)
     {
+        Bit *bit = GetBit(pos);
+        if (bit->kind_ != BitKind::Crc)
+            break;
+
         // CRC should be set in CAN FD frames before stuff bits in CRC are
         // inserted (as CRC affects value of these stuff bits), therefore
         // it is illegal to calculate CRC when stuff bits in it are already
         // inserted!
-        assert(bit_it->stuff_kind_ == StuffKind::NoStuff);
+        assert(bit->stuff_kind_ == StuffKind::NoStuff);
 
-        bit_it->val_ = (BitVal)((tmp_crc >> i) & 0x1);
+        bit->val_ = (BitVal)((tmp_crc >> i) & 0x1);
         i--;
-        bit_it++;
     }
 }
 
@@ -131,7 +219,7 @@ uint8_t can::BitFrame::stuff_count()
         std::cerr << "CAN 2.0 frame does not have Stuff count field defined" << std::endl;
         return 0;
     }
-    return stuff_cnt_;
+    return stuff_engine_.stuff_cnt();
 }
 
 
@@ -161,30 +249,28 @@ void can::BitFrame::AppendBit(BitKind kind, int value)
 
 void can::BitFrame::AppendBit(BitKind kind, BitVal value)
 {
-    bits_.push_back(Bit(this, kind, value, &frm_flags_, nbt_, dbt_));
+    bits_.push_back(StoreBit(Bit(this, kind, value)));
 }
 
 
 void can::BitFrame::AppendBitFrame(can::BitFrame *bit_frame)
 {
-    for (size_t i = 0; i < bit_frame->GetLen(); i++)
-        // We want to copy the bit, not to refer to original bit frame!
-        bits_.push_back(Bit(*bit_frame->GetBit(i)));
+    // We want to copy the bit, not to refer to original bit frame!
+    bits_.reserve(bits_.size() + bit_frame->bits_.size());
+    for (uint32_t slot : bit_frame->bits_)
+        bits_.push_back(StoreBit(*bit_frame->SlotBit(slot)));
 }
 
 
 bool can::BitFrame::ClearFrameBits(size_t index)
 {
-    std::list<Bit>::iterator bit_it;
-    std::list<Bit>::iterator end_it;
-
     if (index >= bits_.size())
         return false;
 
-    bit_it = bits_.begin();
-    end_it = bits_.end();
-    std::advance(bit_it, index);
-    bits_.erase(bit_it, end_it);
+    for (size_t i = index; i < bits_.size(); i++)
+        ReleaseSlot(bits_[i]);
+    bits_.resize(index);
+    InvalidateIndex(index);
 
     return true;
 }
@@ -192,6 +278,12 @@ bool can::BitFrame::ClearFrameBits(size_t index)
 void can::BitFrame::BuildFrameBits()
 {
     bits_.clear();
+    free_slots_.clear();
+    bit_chunks_.clear();
+    bit_details_.clear();
+    InvalidateIndex(0);
+    update_vals_.clear();
+    crc_states_.clear();
     AppendBit(BitKind::Sof, BitVal::Dominant);
 
     // Build base ID
@@ -309,14 +401,13 @@ void can::BitFrame::BuildFrameBits()
 }
 
 
-size_t can::BitFrame::InsertNormalStuffBits()
+size_t can::BitFrame::InsertNormalStuffBits(size_t from)
 {
-    std::list<Bit>::iterator bit_it;
-    int same_bits = 1;
-    stuff_cnt_ = 0;
-    BitVal prev_value = BitVal::Dominant; // As if SOF
+    assert(from > 0 && "SOF is never stuffed");
 
-    if (bits_.front().kind_ != BitKind::Sof) {
+    stuff_engine_.Reset();
+
+    if (GetBit(0)->kind_ != BitKind::Sof) {
         std::cerr << "First bit of a frame should be SOF!" << std::endl;
         return 0;
     }
@@ -325,157 +416,184 @@ size_t can::BitFrame::InsertNormalStuffBits()
         std::cerr << "At least 5 bits needed for bit stuffing!" << std::endl;
     }
 
-    // Start from first bit of Base identifier
-    for (bit_it = ++(bits_.begin());; ++bit_it)
-    {
-        // Break when we reach Stuff count (CAN FD) or CRC Delimiter (CAN 2.0).
-        // Account also improperly created frame so break on the end!
-        if (bit_it->kind_ == BitKind::CrcDelim ||
-            bit_it->kind_ == BitKind::StuffCnt ||
-            bit_it == bits_.end())
-            break;
-
-        if (bit_it->val_ == prev_value)
-            same_bits++;
-        else
-            same_bits = 1;
-
-        if (same_bits == 5)
+    // Resume from state given by bits preceding 'from' (these are already stuffed).
+    if (from > 1 && from <= bits_.size()) {
+        BitVal prev_val = GetBit(from - 1)->val_;
+        size_t same_bits = 1;
+        for (size_t i = from - 1; same_bits < 5; i--)
         {
-            // This is exception for stuff bit inserted just before Stuff count!
-            // There shall be no regular stuff bit inserted before stuff count
-            // even if there are 5 consecutive bits of equal value. This bit shall
-            // not be taken into number of stuffed bits!
-            auto bit_it_nxt = bit_it;
-            bit_it_nxt++;
-            if (bit_it_nxt->kind_ == BitKind::StuffCnt)
-            {
-                prev_value = bit_it->val_;
-                continue;
+            // Run of equal bits starts by regular stuff bit, or continues to SOF
+            if (GetBit(i)->stuff_kind_ == StuffKind::Normal)
+                break;
+            if (i == 1) {
+                if (prev_val == BitVal::Dominant)
+                    same_bits++;
+                break;
             }
+            if (GetBit(i - 1)->val_ != prev_val)
+                break;
+            same_bits++;
+        }
 
-            Bit bit = Bit(this, bit_it->kind_, bit_it->GetOppositeVal(),
-                          &frm_flags_, nbt_, dbt_,
-                          StuffKind::Normal);
-            bit_it++;
-            bit_it = bits_.insert(bit_it, bit);
-            same_bits = 1;
+        size_t stuff_cnt = 0;
+        for (size_t i = 1; i < from; i++)
+            if (GetBit(i)->stuff_kind_ == StuffKind::Normal)
+                stuff_cnt++;
 
-            stuff_cnt_ = static_cast<uint8_t>((stuff_cnt_ + 1) % 8);
-        }
-        prev_value = bit_it->val_;
+        stuff_engine_.SetState(prev_val, same_bits, stuff_cnt);
+    } else {
+        from = 1;
+    }
+
+    // Pack bits till Stuff count (CAN FD) or CRC Delimiter (CAN 2.0).
+    stuff_in_.clear();
+    size_t end = from;
+    for (; end < bits_.size(); end++)
+    {
+        Bit *bit = GetBit(end);
+        if (bit->kind_ == BitKind::CrcDelim || bit->kind_ == BitKind::StuffCnt)
+            break;
+        size_t i = end - from;
+        if (i % 64 == 0)
+            stuff_in_.push_back(0);
+        stuff_in_.back() |= static_cast<uint64_t>(bit->val_) << (i % 64);
     }
 
-    return stuff_cnt_;
+    // This is exception for stuff bit inserted just before Stuff count!
+    // There shall be no regular stuff bit inserted before stuff count
+    // even if there are 5 consecutive bits of equal value. This bit shall
+    // not be taken into number of stuffed bits!
+    bool stuff_last = !(end < bits_.size() && GetBit(end)->kind_ == BitKind::StuffCnt);
+
+    stuff_pos_.clear();
+    size_t n_stuff = stuff_engine_.Stuff(stuff_in_.data(), end - from, stuff_last, nullptr,
+                                         &stuff_pos_);
+    for (auto &pos : stuff_pos_)
+        pos += static_cast<uint32_t>(from);
+    InsertStuffBits(stuff_pos_, StuffKind::Normal);
+
+    return n_stuff;
 }
 
 
 void can::BitFrame::InsertStuffToStuffCnt()
 {
-    std::list<Bit>::iterator bit_it;
     BitVal stuff_bit_value;
 
     assert(!(frm_flags_.is_fdf() == FrameKind::Can20));
 
-    for (bit_it = bits_.begin(); bit_it->kind_ != BitKind::StuffCnt; bit_it++)
-        ;
-    bit_it--;
-    stuff_bit_value = bit_it->GetOppositeVal();
-    bit_it++;
+    size_t pos = GetFieldPos(BitKind::StuffCnt)[0];
+    stuff_bit_value = GetBit(pos - 1)->GetOppositeVal();
 
-    Bit bit = Bit(this, BitKind::StuffCnt, stuff_bit_value, &frm_flags_,
-                  nbt_, dbt_, StuffKind::Fixed);
-    bit_it = bits_.insert(bit_it, bit);
-    bit_it++;
+    InsertBit(Bit(this, BitKind::StuffCnt, stuff_bit_value, StuffKind::Fixed), pos);
 
     // Move one beyond stuff parity and calculate stuff bit post parity
-    for (int i = 0; i < 3; i++)
-        bit_it++;
-    stuff_bit_value = bit_it->GetOppositeVal();
-    bit_it->GetOppositeVal();
-    bit_it++;
+    pos += 4;
+    stuff_bit_value = GetBit(pos)->GetOppositeVal();
 
-    Bit bit_2 = Bit(this, BitKind::StuffParity, stuff_bit_value, &frm_flags_,
-                    nbt_, dbt_, StuffKind::Fixed);
-    bit_it = bits_.insert(bit_it, bit_2);
+    InsertBit(Bit(this, BitKind::StuffParity, stuff_bit_value, StuffKind::Fixed), pos + 1);
 }
 
 
 void can::BitFrame::InsertFixedStuffToCrc()
 {
-    std::list<Bit>::iterator bit_it;
-    int same_bits = 0;
-
     // Search first bit of CRC
-    for (bit_it = bits_.begin(); bit_it->kind_ != BitKind::Crc; bit_it++)
-        ;
+    size_t pos = GetFieldPos(BitKind::Crc)[0];
+    size_t crc_end = pos;
+    while (crc_end < bits_.size() && GetBit(crc_end)->kind_ != BitKind::CrcDelim)
+        crc_end++;
+
+    // Fixed stuff bit after each 4 bits of CRC
+    stuff_pos_.clear();
+    for (size_t i = pos + 3; i < crc_end; i += 4)
+        stuff_pos_.push_back(static_cast<uint32_t>(i));
+    InsertStuffBits(stuff_pos_, StuffKind::Fixed);
+}
 
-    for (; bit_it->kind_ != BitKind::CrcDelim; ++bit_it)
+
+void can::BitFrame::InsertStuffBits(const std::vector<uint32_t> &after, StuffKind stuff_kind)
+{
+    if (after.empty())
+        return;
+
+    // Bits are moved towards the end of frame at once, from last inserted stuff bit.
+    size_t src = bits_.size();
+    bits_.resize(bits_.size() + after.size());
+    size_t dst = bits_.size();
+
+    for (size_t i = after.size(); i-- > 0;)
     {
-        same_bits++;
-        if ((same_bits % 4) == 0)
-        {
-            Bit bit = Bit(this, BitKind::Crc, bit_it->GetOppositeVal(),
-                          &frm_flags_, nbt_, dbt_,
-                          StuffKind::Fixed);
-            bit_it = bits_.insert(++bit_it, bit);
-        }
-    }
+        size_t pos = after[i];
+        assert(pos < src && "Stuff bits shall be inserted in ascending order");
+        while (src > pos + 1)
+            bits_[--dst] = bits_[--src];
 
+        Bit *bit = GetBit(pos);
+        bits_[--dst] = StoreBit(Bit(this, bit->kind_, bit->GetOppositeVal(), stuff_kind));
+    }
+    InvalidateIndex(after.front() + 1);
 }
 
 
-uint32_t can::BitFrame::CalcCrc()
+uint32_t can::BitFrame::CalcCrc(size_t from)
 {
-    std::list<Bit>::iterator bit_it;
-    uint32_t crc_nxt_15 = 0;
-    uint32_t crc_nxt_17 = 0;
-    uint32_t crc_nxt_21 = 0;
+    CrcEngine crc15 = CrcEngine(CrcKind::Crc15);
+    CrcEngine crc17 = CrcEngine(CrcKind::Crc17);
+    CrcEngine crc21 = CrcEngine(CrcKind::Crc21);
 
-    crc15_ = 0;
-    crc17_ = (1 << 16);
-    crc21_ = (1 << 20);
+    // Resume from last saved CRC state which is still valid
+    size_t chkpt = std::min(from, crc_valid_) / CRC_CHECKPOINT_DIST;
+    if (chkpt >= crc_states_.size())
+        chkpt = crc_states_.empty() ? 0 : crc_states_.size() - 1;
+    if (chkpt < crc_states_.size()) {
+        crc15.set_crc(crc_states_[chkpt].crc15);
+        crc17.set_crc(crc_states_[chkpt].crc17);
+        crc21.set_crc(crc_states_[chkpt].crc21);
+    }
+    crc_states_.resize(chkpt);
 
-    // CRC calculation as in CAN FD spec!
-    bit_it = bits_.begin();
-    while (true)
-    {
-        if (bit_it->kind_ == BitKind::Crc)
-            break;
+    size_t pos = chkpt * CRC_CHECKPOINT_DIST;
+    bool crc_reached = false;
 
-        BitVal bit_value = bit_it->val_;
-        crc_nxt_15 = (uint32_t)(bit_value) ^ ((crc15_ >> 14) & 0x1);
-        crc_nxt_17 = (uint32_t)(bit_value) ^ ((crc17_ >> 16) & 0x1);
-        crc_nxt_21 = (uint32_t)(bit_value) ^ ((crc21_ >> 20) & 0x1);
+    while (!crc_reached && pos < bits_.size())
+    {
+        crc_states_.push_back({crc15.crc(), crc17.crc(), crc21.crc()});
 
-        // Shift left, CRC 15 always without stuff bits
-        if (bit_it->stuff_kind_ == StuffKind::NoStuff)
-            crc15_ = (crc15_ << 1);
+        // Bits are packed to words. CRC 15 is calculated without stuff bits, CRC 17 and
+        // CRC 21 without fixed stuff bits. Excluded bits are masked out when packing.
+        uint64_t word_15 = 0;
+        uint64_t word_17 = 0;
+        size_t len_15 = 0;
+        size_t len_17 = 0;
 
-        if (bit_it->stuff_kind_ != StuffKind::Fixed)
+        size_t end = std::min<size_t>(pos + CRC_CHECKPOINT_DIST, bits_.size());
+        for (; pos < end; pos++)
         {
-            crc17_ = (crc17_ << 1);
-            crc21_ = (crc21_ << 1);
-        }
+            Bit *bit = GetBit(pos);
+            if (bit->kind_ == BitKind::Crc) {
+                crc_reached = true;
+                break;
+            }
 
-        crc15_ &= 0x7FFF;
-        crc17_ &= 0x1FFFF;
-        crc21_ &= 0x1FFFFF;
+            uint64_t val = static_cast<uint64_t>(bit->val_);
+            uint64_t in_15 = static_cast<uint64_t>(bit->stuff_kind_ == StuffKind::NoStuff);
+            uint64_t in_17 = static_cast<uint64_t>(bit->stuff_kind_ != StuffKind::Fixed);
 
-        // Calculate by polynomial
-        if ((crc_nxt_15 == 1) && (bit_it->stuff_kind_ == StuffKind::NoStuff))
-            crc15_ ^= 0xC599;
-        if ((crc_nxt_17 == 1) && (bit_it->stuff_kind_ != StuffKind::Fixed))
-            crc17_ ^= 0x3685B;
-        if ((crc_nxt_21 == 1) && (bit_it->stuff_kind_ != StuffKind::Fixed))
-            crc21_ ^= 0x302899;
+            word_15 = (word_15 << in_15) | (val & in_15);
+            word_17 = (word_17 << in_17) | (val & in_17);
+            len_15 += in_15;
+            len_17 += in_17;
+        }
 
-        bit_it++;
+        crc15.Update(word_15, len_15);
+        crc17.Update(word_17, len_17);
+        crc21.Update(word_17, len_17);
     }
+    crc_valid_ = std::numeric_limits<size_t>::max();
 
-    //printf("Calculated CRC 15 : 0x%x\n", crc15_);
-    //printf("Calculated CRC 17 : 0x%x\n", crc17_);
-    //printf("Calculated CRC 21 : 0x%x\n", crc21_);
+    crc15_ = crc15.crc();
+    crc17_ = crc17.crc();
+    crc21_ = crc21.crc();
 
     if (frm_flags_.is_fdf() == FrameKind::Can20)
         return crc15_;
@@ -488,57 +606,25 @@ uint32_t can::BitFrame::CalcCrc()
 
 bool can::BitFrame::SetStuffCnt()
 {
-    std::list<Bit>::iterator bit_it;
-    stuff_cnt_encoded_ = 0;
-    bit_it = bits_.begin();
-
     // DontShift sense to try to set Stuff count on CAN 2.0 frames!
     if (frm_flags_.is_fdf() == FrameKind::Can20)
         return false;
 
-    while (bit_it->kind_ != BitKind::StuffCnt && bit_it != bits_.end())
-        bit_it++;
-
-    if (bit_it == bits_.end())
+    const std::vector<uint32_t> &stuff_cnt_pos = GetFieldPos(BitKind::StuffCnt);
+    if (stuff_cnt_pos.empty())
     {
         std::cerr << "Did not find stuff count field!" << std::endl;
         return false;
     }
 
-    assert(stuff_cnt_ < 8);
-
-    switch (stuff_cnt_){
-        case 0x0 :
-            stuff_cnt_encoded_ = 0b000;
-            break;
-        case 0x1:
-            stuff_cnt_encoded_ = 0b001;
-            break;
-        case 0x2 :
-            stuff_cnt_encoded_ = 0b011;
-            break;
-        case 0x3 :
-            stuff_cnt_encoded_ = 0b010;
-            break;
-        case 0x4 :
-            stuff_cnt_encoded_ = 0b110;
-            break;
-        case 0x5 :
-            stuff_cnt_encoded_ = 0b111;
-            break;
-        case 0x6 :
-            stuff_cnt_encoded_ = 0b101;
-            break;
-        case 0x7 :
-            stuff_cnt_encoded_ = 0b100;
-            break;
-    };
-
+    uint8_t stuff_cnt_encoded = stuff_engine_.stuff_cnt_encoded();
+    size_t pos = stuff_cnt_pos[0];
     for (int i = 2; i >= 0; i--)
     {
-        assert(bit_it->kind_ == BitKind::StuffCnt);
-        bit_it->val_ = (BitVal)((stuff_cnt_encoded_ >> i) & 0x1);
-        bit_it++;
+        Bit *bit = GetBit(pos);
+        assert(bit->kind_ == BitKind::StuffCnt);
+        bit->val_ = (BitVal)((stuff_cnt_encoded >> i) & 0x1);
+        pos++;
     }
     return true;
 }
@@ -546,17 +632,11 @@ bool can::BitFrame::SetStuffCnt()
 
 bool can::BitFrame::SetStuffParity()
 {
-    std::list<Bit>::iterator bit_it;
-    uint8_t val = 0;
-
     if (frm_flags_.is_fdf() == FrameKind::Can20)
         return false;
 
-    for (bit_it = bits_.begin(); bit_it->kind_ != BitKind::StuffParity; bit_it++)
-        ;
-    for (int i = 0; i < 3; i++)
-        val ^= static_cast<uint8_t>(((stuff_cnt_encoded_ >> i) & 0x1));
-    bit_it->val_ = (BitVal)val;
+    Bit *bit_it = GetBitOf(0, BitKind::StuffParity);
+    bit_it->val_ = (BitVal)stuff_engine_.stuff_parity();
 
     return true;
 }
@@ -570,8 +650,7 @@ size_t can::BitFrame::GetLen()
 
 size_t can::BitFrame::GetFieldLen(BitKind bit_type)
 {
-    return std::count_if(bits_.begin(), bits_.end(),
-                         [bit_type](can::Bit bit) { return bit.kind_ == bit_type; });
+    return GetFieldPos(bit_type).size();
 }
 
 
@@ -580,14 +659,9 @@ can::Bit* can::BitFrame::GetRandBitOf(BitKind bit_type)
     size_t bit_field_length = GetFieldLen(bit_type);
     assert(bit_field_length > 0 && "Frame has no bits of required type!");
 
-    std::list<Bit>::iterator bit_it =
-        std::find_if(bits_.begin(), bits_.end(),
-                     [bit_type](Bit bit) { return bit.kind_ == bit_type; });
+    size_t bit_index = Rand() % bit_field_length;
 
-    size_t bit_index = rand() % bit_field_length;
-    std::advance(bit_it, bit_index);
-
-    return &(*bit_it);
+    return GetBit(GetFieldPos(bit_type)[0] + bit_index);
 }
 
 can::Bit* can::BitFrame::GetRandBit(BitVal bit_value)
@@ -596,7 +670,7 @@ can::Bit* can::BitFrame::GetRandBit(BitVal bit_value)
     size_t lenght = this->GetLen();
     do
     {
-        bit = GetBit(rand() % lenght);
+        bit = GetBit(Rand() % lenght);
     } while (bit->val_ != bit_value);
 
     return bit;
@@ -604,198 +678,154 @@ can::Bit* can::BitFrame::GetRandBit(BitVal bit_value)
 
 can::Bit* can::BitFrame::GetBit(size_t index)
 {
-    std::list<Bit>::iterator bit_it = bits_.begin();
-
     assert(bits_.size() > index && "Insufficient number of bits in a frame!");
 
-    std::advance(bit_it, index);
-    return &(*bit_it);
+    return SlotBit(bits_[index]);
 }
 
-std::list<can::Bit>::iterator can::BitFrame::GetBitIter(size_t index)
-{
-    std::list<Bit>::iterator bit_it = bits_.begin();
-
-    assert(bits_.size() > index && "Insufficient number of bits in a frame!");
-
-    std::advance(bit_it, index);
-    return bit_it;
-}
 
 
 can::Bit* can::BitFrame::GetBitOf(size_t index, BitKind bit_type)
 {
-    std::list<Bit>::iterator bit_it = bits_.begin();
-    size_t i = 0;
+    const std::vector<uint32_t> &field_pos = GetFieldPos(bit_type);
 
-    while (bit_it != bits_.end())
-    {
-        if (bit_it->kind_ == bit_type)
-            if (i == index) {
-                break;
-            } else {
-                i++;
-                bit_it++;
-            }
-        else
-            bit_it++;
-    }
-
-    assert(bit_it != bits_.end() && "Insufficient number of bits in a bit field");
+    assert(index < field_pos.size() && "Insufficient number of bits in a bit field");
+    if (index >= field_pos.size())
+        return nullptr;
 
-    return &(*bit_it);
+    return GetBit(field_pos[index]);
 }
 
 
 can::Bit* can::BitFrame::GetBitOfNoStuffBits(size_t index, BitKind bit_type)
 {
-    std::list<Bit>::iterator bit_it = bits_.begin();
     size_t i = 0;
 
-    while (bit_it != bits_.end())
+    for (uint32_t pos : GetFieldPos(bit_type))
     {
-        if (bit_it->kind_ == bit_type &&
-            bit_it->stuff_kind_ == StuffKind::NoStuff)
-            if (i == index) {
-                break;
-            } else {
-                i++;
-                bit_it++;
-            }
-        else
-            bit_it++;
+        Bit *bit = GetBit(pos);
+        if (bit->stuff_kind_ == StuffKind::NoStuff) {
+            if (i == index)
+                return bit;
+            i++;
+        }
     }
 
-    assert(bit_it != bits_.end() && "Insufficient number of bits in a bit field");
+    assert(false && "Insufficient number of bits in a bit field");
 
-    return &(*bit_it);
+    return nullptr;
 }
 
 
-std::list<can::Bit>::iterator can::BitFrame::GetBitOfIter(size_t index, BitKind bit_type)
-{
-    std::list<Bit>::iterator bit_it = bits_.begin();
-    size_t i = 0;
-
-    while (bit_it != bits_.end())
-    {
-        if (bit_it->kind_ == bit_type)
-            if (i == index) {
-                break;
-            } else {
-                i++;
-                bit_it++;
-            }
-        else
-            bit_it++;
-    }
-
-    return bit_it;
-}
 
 
 size_t can::BitFrame::GetBitIndex(Bit *bit)
 {
-    std::list<Bit>::iterator bit_it = bits_.begin();
-    int i = 0;
+    // Bit remembers its slot, check that it really is stored in it (it is not a copy)
+    // and that the slot is part of frame (not released).
+    uint32_t slot = bit->slot_;
+    if (slot / BIT_CHUNK_SIZE >= bit_chunks_.size() ||
+        slot % BIT_CHUNK_SIZE >= bit_chunks_[slot / BIT_CHUNK_SIZE].size() ||
+        SlotBit(slot) != bit)
+        return bits_.size();
 
-    while (&(*bit_it) != bit && bit_it != bits_.end()) {
-        i++;
-        bit_it++;
-    }
-    return i;
+    UpdateIndex();
+
+    uint32_t pos = slot_pos_[slot];
+    if (pos >= bits_.size() || bits_[pos] != slot)
+        return bits_.size();
+
+    return pos;
 }
 
 
 can::Bit* can::BitFrame::GetStuffBit(size_t index)
 {
-    std::list<Bit>::iterator bit_it = bits_.begin();
+    size_t pos = 0;
     size_t i = 0;
 
-    while (i <= index && bit_it != bits_.end())
+    while (i <= index && pos < bits_.size())
     {
-        bit_it++;
-        if (bit_it->stuff_kind_ == StuffKind::Normal ||
-            bit_it->stuff_kind_ == StuffKind::Fixed)
+        pos++;
+        if (pos < bits_.size() && GetBit(pos)->IsStuffBit())
             i++;
     }
 
-    if (bit_it == bits_.end())
+    if (pos == bits_.size())
         return nullptr;
 
-    return &(*bit_it);
+    return GetBit(pos);
 }
 
 can::Bit* can::BitFrame::GetStuffBit(size_t index, BitKind bit_type)
 {
-    std::list<Bit>::iterator bit_it = bits_.begin();
+    size_t pos = 0;
     size_t i = 0;
 
-    while (i <= index && bit_it != bits_.end())
+    while (i <= index && pos < bits_.size())
     {
-        bit_it++;
-        if ((bit_it->stuff_kind_ == StuffKind::Normal ||
-             bit_it->stuff_kind_ == StuffKind::Fixed) &&
-            (bit_it->kind_ == bit_type))
+        pos++;
+        if (pos < bits_.size() && GetBit(pos)->IsStuffBit() &&
+            GetBit(pos)->kind_ == bit_type)
             i++;
     }
 
-    if (bit_it == bits_.end())
+    if (pos == bits_.size())
         return nullptr;
 
-    return &(*bit_it);
+    return GetBit(pos);
 }
 
 can::Bit* can::BitFrame::GetStuffBit(BitKind bit_type, StuffKind stuff_bit_type,
                                      BitVal bit_value)
 {
-    auto bit_it = std::find_if(bits_.begin(), bits_.end(),
-                               [bit_type, stuff_bit_type, bit_value] (Bit bit) {
-        if (bit.kind_ == bit_type &&
-            bit.val_ == bit_value &&
-            bit.stuff_kind_ == stuff_bit_type)
-            return true;
-        return false;
-        });
-    return &(*bit_it);
+    for (uint32_t slot : bits_)
+    {
+        Bit *bit = SlotBit(slot);
+        if (bit->kind_ == bit_type &&
+            bit->val_ == bit_value &&
+            bit->stuff_kind_ == stuff_bit_type)
+            return bit;
+    }
+    return nullptr;
 }
 
 can::Bit* can::BitFrame::GetFixedStuffBit(size_t index)
 {
-    std::list<Bit>::iterator bit_it = bits_.begin();
+    size_t pos = 0;
     size_t i = 0;
 
-    while (i <= index && bit_it != bits_.end())
+    while (i <= index && pos < bits_.size())
     {
-        bit_it++;
-        if (bit_it->stuff_kind_ == StuffKind::Fixed)
+        pos++;
+        if (pos < bits_.size() && GetBit(pos)->stuff_kind_ == StuffKind::Fixed)
             i++;
     }
 
-    if (bit_it == bits_.end())
+    if (pos == bits_.size())
         return nullptr;
 
-    return &(*bit_it);
+    return GetBit(pos);
 }
 
 
 can::Bit* can::BitFrame::GetFixedStuffBit(size_t index, BitVal bit_value)
 {
-    std::list<Bit>::iterator bit_it = bits_.begin();
+    size_t pos = 0;
     size_t i = 0;
 
-    while (i <= index && bit_it != bits_.end())
+    while (i <= index && pos < bits_.size())
     {
-        bit_it++;
-        if (bit_it->stuff_kind_ == StuffKind::Fixed &&
-            bit_it->val_ == bit_value)
+        pos++;
+        if (pos < bits_.size() && GetBit(pos)->stuff_kind_ == StuffKind::Fixed &&
+            GetBit(pos)->val_ == bit_value)
             i++;
     }
 
-    if (bit_it == bits_.end())
+    if (pos == bits_.size())
         return nullptr;
 
-    return &(*bit_it);
+    return GetBit(pos);
 }
 
 
@@ -804,9 +834,9 @@ bool can::BitFrame::InsertBit(Bit bit, size_t index)
     if (index > bits_.size())
         return false;
 
-    std::list<Bit>::iterator bit_it = bits_.begin();
-    std::advance(bit_it, index);
-    bits_.insert(bit_it, bit);
+    uint32_t slot = StoreBit(std::move(bit));
+    bits_.insert(bits_.begin() + static_cast<std::ptrdiff_t>(index), slot);
+    InvalidateIndex(index);
 
     return true;
 }
@@ -814,39 +844,33 @@ bool can::BitFrame::InsertBit(Bit bit, size_t index)
 
 bool can::BitFrame::InsertBit(BitKind bit_type, BitVal bit_value, size_t index)
 {
-    return InsertBit(Bit(this, bit_type, bit_value, &frm_flags_, nbt_,
-                         dbt_), index);
+    return InsertBit(Bit(this, bit_type, bit_value), index);
 }
 
 
 void can::BitFrame::AppendBit(Bit can_bit)
 {
-    bits_.push_back(can_bit);
+    bits_.push_back(StoreBit(std::move(can_bit)));
 }
 
 
 void can::BitFrame::RemoveBit(Bit *bit)
 {
-    std::list<Bit>::iterator bit_it = bits_.begin();
-    while (bit_it != bits_.end())
-    {
-        if (&(*bit_it) == bit)
-            break;
-        bit_it++;
-    };
-    bits_.erase(bit_it);
+    size_t index = GetBitIndex(bit);
+    assert(index < bits_.size() && "Can't remove bit which is not in frame");
+
+    RemoveBit(index);
 }
 
 
 bool can::BitFrame::RemoveBit(size_t index)
 {
-    std::list<Bit>::iterator bit_it = bits_.begin();
-
     if (bits_.size() <= index)
         return false;
 
-    std::advance(bit_it, index);
-    bits_.erase(bit_it);
+    ReleaseSlot(bits_[index]);
+    bits_.erase(bits_.begin() + static_cast<std::ptrdiff_t>(index));
+    InvalidateIndex(index);
 
     return true;
 }
@@ -862,17 +886,7 @@ void can::BitFrame::RemoveBit(size_t index, BitKind bit_type)
 
 bool can::BitFrame::RemoveBitsFrom(size_t index)
 {
-    if (bits_.size() <= index)
-        return false;
-
-    while (bits_.size() > index)
-    {
-        auto end_it = bits_.end();
-        end_it--;
-        bits_.erase(end_it);
-    }
-
-    return true;
+    return ClearFrameBits(index);
 }
 
 void can::BitFrame::RemoveBitsFrom(size_t index, BitKind bit_type)
@@ -1013,15 +1027,13 @@ bool can::BitFrame::InsertOvrlFrm(size_t index, BitKind bit_type)
 void can::BitFrame::AppendSuspTrans()
 {
     for (int i = 0; i < 8; i++)
-        AppendBit(Bit(this, BitKind::SuspTrans, BitVal::Recessive,
-            &frm_flags_, nbt_, dbt_));
+        AppendBit(Bit(this, BitKind::SuspTrans, BitVal::Recessive));
 }
 
 
 bool can::BitFrame::LooseArbit(size_t index)
 {
     Bit *bit = GetBit(index);
-    std::list<Bit>::iterator bit_it = bits_.begin();
 
     if (bit == nullptr)
         return false;
@@ -1041,14 +1053,9 @@ bool can::BitFrame::LooseArbit(size_t index)
         return false;
     }
 
-    // Move to position where we want to loose arbitration
-    // TODO: Rewrite with lambda!
-    for (size_t i = 0; i < index; i++)
-        bit_it++;
-
     /* Turn to recessive from this bit further */
-    for (; bit_it != bits_.end(); bit_it++)
-        bit_it->val_ = BitVal::Recessive;
+    for (size_t i = index; i < bits_.size(); i++)
+        GetBit(i)->val_ = BitVal::Recessive;
 
     GetBitOf(0, BitKind::Ack)->val_ = BitVal::Dominant;
 
@@ -1070,8 +1077,8 @@ bool can::BitFrame::LooseArbit(size_t index, BitKind bit_type)
 
 void can::BitFrame::ConvRXFrame()
 {
-    for (auto bit_it = bits_.begin(); bit_it != bits_.end(); bit_it++)
-        bit_it->val_ = BitVal::Recessive;
+    for (uint32_t slot : bits_)
+        SlotBit(slot)->val_ = BitVal::Recessive;
 
     Bit *bit = GetBitOf(0, BitKind::Ack);
     assert(bit != NULL && "No ACK bit present in frame!");
@@ -1081,30 +1088,39 @@ void can::BitFrame::ConvRXFrame()
 
 size_t can::BitFrame::GetNumStuffBits(BitKind bit_type, StuffKind stuff_bit_type)
 {
-    return std::count_if(bits_.begin(), bits_.end(), [bit_type, stuff_bit_type](Bit bit) {
-        if (bit.kind_ == bit_type && bit.stuff_kind_ == stuff_bit_type)
-            return true;
-        return false;
-    });
+    size_t n_bits = 0;
+
+    for (uint32_t pos : GetFieldPos(bit_type))
+    {
+        Bit *bit = GetBit(pos);
+        if (bit->stuff_kind_ == stuff_bit_type)
+            n_bits++;
+    }
+
+    return n_bits;
 }
 
 
 size_t can::BitFrame::GetNumStuffBits(BitKind bit_type, StuffKind stuff_bit_type,
                                    BitVal bit_value)
 {
-    return std::count_if(bits_.begin(), bits_.end(), [bit_type, stuff_bit_type, bit_value](Bit bit) {
-        if (bit.kind_ == bit_type &&
-            bit.stuff_kind_ == stuff_bit_type &&
-            bit.val_ == bit_value)
-            return true;
-        return false;
-    });
+    size_t n_bits = 0;
+
+    for (uint32_t pos : GetFieldPos(bit_type))
+    {
+        Bit *bit = GetBit(pos);
+        if (bit->stuff_kind_ == stuff_bit_type && bit->val_ == bit_value)
+            n_bits++;
+    }
+
+    return n_bits;
 }
 
 
 size_t can::BitFrame::GetNumStuffBits(StuffKind stuff_bit_type)
 {
-    return std::count_if(bits_.begin(), bits_.end(), [stuff_bit_type](Bit bit) {
+    return std::count_if(bits_.begin(), bits_.end(), [this, stuff_bit_type](uint32_t slot) {
+        const Bit &bit = *SlotBit(slot);
         if (bit.stuff_kind_ == stuff_bit_type)
             return true;
         return false;
@@ -1114,7 +1130,8 @@ size_t can::BitFrame::GetNumStuffBits(StuffKind stuff_bit_type)
 
 size_t can::BitFrame::GetNumStuffBits(StuffKind stuff_bit_type, BitVal bit_value)
 {
-    return std::count_if(bits_.begin(), bits_.end(), [stuff_bit_type, bit_value](Bit bit) {
+    return std::count_if(bits_.begin(), bits_.end(), [this, stuff_bit_type, bit_value](uint32_t slot) {
+        const Bit &bit = *SlotBit(slot);
         if (bit.stuff_kind_ == stuff_bit_type &&
             bit.val_ == bit_value)
             return true;
@@ -1131,10 +1148,11 @@ void can::BitFrame::Print(bool print_stuff_bits)
     BitKind last_kind = BitKind::Undefined;
     int field_len = 0;
 
-    for (auto bit_it = bits_.begin(); bit_it != bits_.end(); bit_it++)
+    for (size_t pos = 0; pos < bits_.size(); pos++)
     {
+        Bit *bit_it = GetBit(pos);
         curr_kind = bit_it->kind_;
-        bool is_last = (bit_it == std::prev(bits_.end()));
+        bool is_last = (pos == bits_.size() - 1);
 
         if (bit_it->IsStuffBit() && !print_stuff_bits) {
             last_kind = curr_kind;
@@ -1146,12 +1164,11 @@ void can::BitFrame::Print(bool print_stuff_bits)
             field_len++;
         }
 
-        if ((curr_kind != last_kind || is_last) &&
-            (bit_it != bits_.begin()))
+        if ((curr_kind != last_kind || is_last) && (pos != 0))
         {
             vals += " |";
 
-            std::string bit_name = std::prev(bit_it)->GetBitKindName();
+            std::string bit_name = GetBit(pos - 1)->GetBitKindName();
             int total_pad = (field_len * 2) + 1 - ((int) bit_name.length());
             int pre_pad = total_pad / 2;
             int post_pad = (total_pad % 2 == 0) ? pre_pad : pre_pad + 1;
@@ -1192,8 +1209,9 @@ void can::BitFrame::PrintDetailed(std::chrono::nanoseconds clock_period)
         << std::setw (20) << "Duration (ns)"
         << std::setw (20) << "Value" << std::endl;
 
-    for (auto & bit : bits_)
+    for (uint32_t slot : bits_)
     {
+        Bit &bit = *SlotBit(slot);
         std::chrono::nanoseconds bit_length = bit.GetLenCycles() * clock_period;
 
         std::cout
@@ -1207,101 +1225,196 @@ void can::BitFrame::PrintDetailed(std::chrono::nanoseconds clock_period)
 
 void can::BitFrame::UpdateFrame(bool recalc_crc)
 {
-    // First remove all stuff bits!
-    for (auto bit_it = bits_.begin(); bit_it != bits_.end(); bit_it++)
-        if (bit_it->stuff_kind_ == StuffKind::Fixed ||
-            bit_it->stuff_kind_ == StuffKind::Normal)
-            bit_it = bits_.erase(bit_it);
+    // Part of frame before first modified bit is unchanged, so its stuff bits and CRC
+    // are kept. Stuff count (CAN FD) and CRC field (CAN 2.0) depend on whole frame,
+    // therefore these are re-calculated always.
+    size_t from = FirstModifiedBit();
+    BitKind tail_kind = BitKind::Crc;
+    if (frame_flags().is_fdf() == FrameKind::CanFd)
+        tail_kind = BitKind::StuffCnt;
+    const std::vector<uint32_t> &tail_pos = GetFieldPos(tail_kind);
+    if (tail_pos.empty())
+        from = 0;
+    else
+        from = std::min<size_t>(from, tail_pos.front());
+
+    // Regular stuff bit is inserted by bits preceding it, so re-calculate from them
+    from = StuffResumePos(from);
+
+    // Re-calculated stuff bits have default timing and values. Kept stuff bits shall
+    // have them too, so drop their timing details (only bits with details are visited).
+    UpdateIndex();
+    for (auto it = bit_details_.begin(); it != bit_details_.end();)
+    {
+        Bit *bit = SlotBit(it->first);
+        if (bit->IsStuffBit() && slot_pos_[it->first] < from) {
+            time_valid_ = std::min<size_t>(time_valid_, slot_pos_[it->first]);
+            bit->has_detail_ = false;
+            it = bit_details_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Remove stuff bits from first re-calculated bit further!
+    size_t len = from;
+    for (size_t i = from; i < bits_.size(); i++)
+    {
+        uint32_t slot = bits_[i];
+        if (SlotBit(slot)->IsStuffBit()) {
+            ReleaseSlot(slot);
+            InvalidateIndex(len);
+        } else {
+            bits_[len++] = slot;
+        }
+    }
+    bits_.resize(len);
+
+    // CRC is not re-calculated, so saved CRC states after modified bit are stale.
+    if (!recalc_crc && from < crc_valid_)
+        crc_valid_ = from;
 
     // Recalculate CRC and add stuff bits!
     if (frame_flags().is_fdf() == FrameKind::Can20){
         if (recalc_crc) {
-            CalcCrc();
+            CalcCrc(from);
             UpdateCrcBits();
         }
 
         // We must set CRC before Stuff bits are inserted because in CAN 2.0
         // frames regular stuff bits are inserted also to CRC!
-        InsertNormalStuffBits();
+        InsertNormalStuffBits(std::max<size_t>(from, 1));
     } else {
-        InsertNormalStuffBits();
+        InsertNormalStuffBits(std::max<size_t>(from, 1));
         SetStuffCnt();
         SetStuffParity();
         InsertStuffToStuffCnt();
         if (recalc_crc) {
-            CalcCrc();
+            CalcCrc(from);
             UpdateCrcBits();
         }
         InsertFixedStuffToCrc();
     }
+
+    SaveUpdateVals();
 }
 
 
-can::Cycle* can::BitFrame::MoveCyclesBack(Cycle *from, size_t move_by)
+size_t can::BitFrame::StuffResumePos(size_t from)
 {
-    std::list<can::Bit>::iterator curr_bit;
-    std::list<can::TimeQuanta>::iterator curr_time_quanta;
-    std::list<can::Cycle>::iterator curr_cycle;
+    if (from > bits_.size())
+        return from;
 
-    /* Search for the TQ and bit which contains the cycle */
-    //std::cout << "STARTING SEARCH" << std::endl;
-    int bit_index = 0;
-    curr_bit = bits_.begin();
-    while (curr_bit != bits_.end())
+    while (from > 1)
     {
-        size_t tq_index = 0;
-        curr_time_quanta = curr_bit->GetTQIter(0);
-        while (true)
+        // Run of equal bits ending with bit before 'from'. It starts by regular stuff
+        // bit, or continues to SOF.
+        BitVal val = GetBit(from - 1)->val_;
+        size_t i = from - 1;
+        size_t same_bits = 1;
+        while (same_bits < 5 && GetBit(i)->stuff_kind_ != StuffKind::Normal &&
+               GetBit(i - 1)->val_ == val)
         {
-            size_t cycle_index = 0;
-            curr_cycle = curr_time_quanta->GetCycleBitValIter(0);
-            while (true)
-            {
-                if (&(*curr_cycle) == from)
-                    goto found;
-
-                if (cycle_index == (curr_time_quanta->getLengthCycles() - 1))
-                    break;
-                cycle_index++;
-                curr_cycle++;
-            }
-            if (tq_index == (curr_bit->GetLenTQ() - 1))
+            same_bits++;
+            if (--i == 0)
                 break;
-            tq_index++;
-            curr_time_quanta++;
         }
-        bit_index++;
-        curr_bit++;
+
+        // Stuffing can be resumed after shorter run. Run of 5 equal bits (e.g. stuff
+        // bit after it was removed, or bit was inserted before it) shall be stuffed
+        // again, so resume from its first bit (after stuff bit which starts it).
+        if (same_bits < 5)
+            return from;
+        if (i == 0)
+            return 1;
+        from = (GetBit(i)->stuff_kind_ == StuffKind::Normal) ? i + 1 : i;
     }
-    assert("Input cycle should be part of frame" && false);
-
-found:
-    /* Iterate back for required amount of cycles */
-    size_t cnt = 0;
-    while (cnt < move_by) {
-        if (curr_cycle == curr_time_quanta->GetCycleBitValIter(0)) {
-            if (curr_time_quanta == curr_bit->GetTQIter(0)) {
-                if (curr_bit == bits_.begin()) {
-                    assert("Hit start of frame! Cant move so far!" && false);
-                } else {
-                    curr_bit--;
-                    curr_time_quanta = curr_bit->GetTQIter(
-                                        curr_bit->GetLenTQ() - 1);
-                    curr_cycle = curr_time_quanta->GetCycleBitValIter(
-                                    curr_time_quanta->getLengthCycles() - 1);
-                }
-            } else {
-                curr_time_quanta--;
-                curr_cycle = curr_time_quanta->GetCycleBitValIter(
-                                curr_time_quanta->getLengthCycles() - 1);
-            }
-        } else {
-            curr_cycle--;
-        }
-        cnt++;
+
+    return from;
+}
+
+
+size_t can::BitFrame::FirstModifiedBit()
+{
+    size_t end = std::min(std::min(modified_from_, update_vals_.size()), bits_.size());
+    for (size_t i = 0; i < end; i++)
+        if (GetBit(i)->val_ != update_vals_[i])
+            return i;
+    return end;
+}
+
+
+void can::BitFrame::SaveUpdateVals()
+{
+    update_vals_.clear();
+    for (uint32_t slot : bits_)
+    {
+        Bit *bit = SlotBit(slot);
+        if (bit->kind_ == BitKind::CrcDelim)
+            break;
+        update_vals_.push_back(bit->val_);
     }
+    modified_from_ = std::numeric_limits<size_t>::max();
+}
+
+
+size_t can::BitFrame::GetLenCycles()
+{
+    UpdateTimeIndex();
+    return cycle_pos_.back();
+}
+
+
+size_t can::BitFrame::GetBitStartCycle(size_t index)
+{
+    assert(index < bits_.size() && "Frame does not have so many bits");
+
+    UpdateTimeIndex();
+    return cycle_pos_[index];
+}
+
+
+size_t can::BitFrame::GetSamplePointCycle(size_t index)
+{
+    Bit *bit = GetBit(index);
+    return GetBitStartCycle(index) + bit->GetPhaseLenCycles(BitPhase::Sync) +
+           bit->GetPhaseLenCycles(BitPhase::Prop) + bit->GetPhaseLenCycles(BitPhase::Ph1);
+}
+
+
+size_t can::BitFrame::GetBitAtCycle(size_t pos)
+{
+    UpdateTimeIndex();
+    assert(pos < cycle_pos_.back() && "Frame does not have so many cycles");
+
+    // Last bit which starts at or before 'pos'. This skips bits with zero length.
+    auto it = std::upper_bound(cycle_pos_.begin(), cycle_pos_.end(), pos);
+    return static_cast<size_t>(it - cycle_pos_.begin()) - 1;
+}
+
+
+can::Cycle can::BitFrame::GetCycleAt(size_t pos)
+{
+    size_t index = GetBitAtCycle(pos);
+    return GetBit(index)->GetCycle(pos - cycle_pos_[index]);
+}
 
-    return &(*curr_cycle);
+
+size_t can::BitFrame::GetCyclePos(Cycle cycle)
+{
+    size_t index = GetBitIndex(cycle.bit());
+    assert(index < bits_.size() && "Cycle should be part of frame");
+
+    return GetBitStartCycle(index) + cycle.offset();
+}
+
+
+can::Cycle can::BitFrame::MoveCyclesBack(Cycle from, size_t move_by)
+{
+    size_t pos = GetCyclePos(from);
+    assert(move_by <= pos && "Hit start of frame! Cant move so far!");
+
+    return GetCycleAt(pos - move_by);
 }
 
 
@@ -1314,11 +1427,11 @@ void can::BitFrame::CompensateEdgeForInputDelay(Bit *from, size_t input_delay)
     assert(prev_bit->val_ == BitVal::Recessive &&
            "Input delay compensation shall start at Recessive bit");
 
-    Cycle *cycle = from->GetTQ(0)->getCycleBitValue(0);
+    Cycle cycle = from->GetTQ(0)->getCycleBitValue(0);
     for (size_t i = 0; i < input_delay; i++)
     {
-        Cycle *compensated_cycle = MoveCyclesBack(cycle, i + 1);
-        compensated_cycle->ForceVal(BitVal::Dominant);
+        Cycle compensated_cycle = MoveCyclesBack(cycle, i + 1);
+        compensated_cycle.ForceVal(BitVal::Dominant);
     }
 }
 
@@ -1355,4 +1468,144 @@ void can::BitFrame::PutAck(size_t input_delay)
     Bit *ack = GetBitOf(0, BitKind::Ack);
     ack->val_ = BitVal::Dominant;
     CompensateEdgeForInputDelay(ack, input_delay);
-}
\ No newline at end of file
+}
+
+
+can::Bit* can::BitFrame::SlotBit(uint32_t slot)
+{
+    return &bit_chunks_[slot / BIT_CHUNK_SIZE][slot % BIT_CHUNK_SIZE];
+}
+
+
+uint32_t can::BitFrame::StoreBit(Bit bit)
+{
+    // Timing detail is held by frame of a bit, bit copied from other frame (or other
+    // slot) takes its detail along.
+    Bit::Detail detail;
+    Bit::Detail *src_detail = bit.GetDetail();
+    bool has_detail = (src_detail != nullptr);
+    if (has_detail)
+        detail = *src_detail;
+
+    // Default timing depends on frame (e.g. on bit rate shift), keep timing the bit had.
+    BitFrame *src = bit.frame();
+    if (!has_detail && src != this &&
+        (src->nbt_ != nbt_ || src->dbt_ != dbt_ || !(src->frm_flags_ == frm_flags_)))
+    {
+        uint32_t phase_tqs[4], phase_brp[4];
+        bit.GetDefPhases(detail.phase_tqs, detail.phase_brp);
+        bit.parent_ = self_.get();
+        bit.GetDefPhases(phase_tqs, phase_brp);
+        has_detail = !std::equal(phase_tqs, phase_tqs + 4, detail.phase_tqs) ||
+                     !std::equal(phase_brp, phase_brp + 4, detail.phase_brp);
+    }
+
+    bit.parent_ = self_.get();
+    bit.has_detail_ = false;
+
+    uint32_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+        *SlotBit(slot) = std::move(bit);
+    } else {
+        // Chunk is never re-allocated, once full, new chunk is started.
+        if (bit_chunks_.empty() ||
+            bit_chunks_.back().size() == bit_chunks_.back().capacity() ||
+            bit_chunks_.back().size() == BIT_CHUNK_SIZE)
+        {
+            bit_chunks_.emplace_back();
+            bit_chunks_.back().reserve(BIT_CHUNK_SIZE);
+        }
+
+        auto &chunk = bit_chunks_.back();
+        chunk.push_back(std::move(bit));
+        slot = static_cast<uint32_t>((bit_chunks_.size() - 1) * BIT_CHUNK_SIZE +
+                                     chunk.size() - 1);
+    }
+
+    Bit *stored = SlotBit(slot);
+    stored->slot_ = slot;
+    if (has_detail) {
+        bit_details_[slot] = std::move(detail);
+        stored->has_detail_ = true;
+        stored->RelinkTQs();
+    }
+
+    return slot;
+}
+
+
+void can::BitFrame::ReleaseSlot(uint32_t slot)
+{
+    Bit *bit = SlotBit(slot);
+    if (bit->has_detail_) {
+        bit_details_.erase(slot);
+        bit->has_detail_ = false;
+    }
+    free_slots_.push_back(slot);
+}
+
+
+void can::BitFrame::InvalidateIndex(size_t index)
+{
+    if (index < index_valid_)
+        index_valid_ = index;
+    if (index < modified_from_)
+        modified_from_ = index;
+    if (index < crc_valid_)
+        crc_valid_ = index;
+    if (index < time_valid_)
+        time_valid_ = index;
+}
+
+
+void can::BitFrame::UpdateTimeIndex()
+{
+    // Length of some bit changed, position of any bit might have changed
+    uint64_t epoch = Bit::timing_epoch_;
+    if (epoch != time_epoch_) {
+        time_epoch_ = epoch;
+        time_valid_ = 0;
+    }
+
+    if (time_valid_ == bits_.size() && cycle_pos_.size() == bits_.size() + 1)
+        return;
+
+    cycle_pos_.resize(bits_.size() + 1);
+    cycle_pos_[0] = 0;
+    for (size_t i = time_valid_; i < bits_.size(); i++)
+        cycle_pos_[i + 1] = cycle_pos_[i] + SlotBit(bits_[i])->GetLenCycles();
+    time_valid_ = bits_.size();
+}
+
+
+void can::BitFrame::UpdateIndex()
+{
+    if (index_valid_ == bits_.size())
+        return;
+
+    for (auto &field_pos : kind_pos_)
+        while (!field_pos.empty() && field_pos.back() >= index_valid_)
+            field_pos.pop_back();
+
+    if (slot_pos_.size() < bit_chunks_.size() * BIT_CHUNK_SIZE)
+        slot_pos_.resize(bit_chunks_.size() * BIT_CHUNK_SIZE);
+
+    for (size_t i = index_valid_; i < bits_.size(); i++)
+    {
+        slot_pos_[bits_[i]] = static_cast<uint32_t>(i);
+        kind_pos_[static_cast<size_t>(SlotBit(bits_[i])->kind_)].push_back(
+            static_cast<uint32_t>(i));
+    }
+
+    index_valid_ = bits_.size();
+}
+
+
+const std::vector<uint32_t>& can::BitFrame::GetFieldPos(BitKind kind)
+{
+    UpdateIndex();
+
+    return kind_pos_[static_cast<size_t>(kind)];
+}
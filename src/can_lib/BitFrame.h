@@ -30,10 +30,13 @@
 
 #include <cstdint>
 #include <chrono>
-#include <list>
+#include <vector>
+#include <unordered_map>
+#include <memory>
 
 #include "Frame.h"
 #include "Bit.h"
+#include "StuffEngine.h"
 
 /**
  * @class Bit
@@ -50,6 +53,12 @@ class can::BitFrame : public Frame {
 
         BitFrame(Frame &frame, BitTiming *nbt, BitTiming *dbt);
 
+        /* Copies bits as they are (same slots), only links to parent frame are updated */
+        BitFrame(const BitFrame &other);
+
+        /* Takes over bits of other frame, other frame shall not be used afterwards */
+        BitFrame(BitFrame &&other);
+
         /**
          * @returns Number of bits within CAN frame
          */
@@ -68,13 +77,6 @@ class can::BitFrame : public Frame {
          */
         Bit* GetBit(size_t index);
 
-        /**
-         * @param index Index of bit within frame to get (SOF = 0, first bit of Base ID = 1, ...)
-         * @returns Iterator of bit on 'index' position, aborts if index is higher than number
-         *          of bits in the frame.
-         */
-        std::list<Bit>::iterator GetBitIter(size_t index);
-
         /**
          * Returns bit within given bit field. Stuff bits are counted too.
          * @param index Index of bit of given type within a bit field.
@@ -109,14 +111,6 @@ class can::BitFrame : public Frame {
          */
         Bit* GetBitOfNoStuffBits(size_t index, BitKind kind);
 
-        /**
-         * Returns bit within given bit field. Stuff bits are counted too.
-         * @param index Index of bit of given type within a bit field.
-         * @param kind Type of bit (bit field)
-         * @returns Iterator to bit on 'index' position within 'bit_type' field.
-         */
-        std::list<Bit>::iterator GetBitOfIter(size_t index, BitKind kind);
-
         /**
          * Obtains bit index of bit within a frame.
          * @param bit Pointer to a bit (must be within a frame)
@@ -429,22 +423,64 @@ class can::BitFrame : public Frame {
          * was changed in it. Alternatively, it can be used to only re-stuff the frame
          * after CRC was corrupted.
          *
+         * Only part of frame from first modified bit further is re-calculated. CRC and bit
+         * stuffing are resumed from state saved during previous update.
+         * As if all stuff bits were re-inserted, stuff bits have default timing and
+         * values after update (also those before first modified bit).
+         *
          * @param recalc_crc When true, CRC will be recalculated.
          */
         void UpdateFrame(bool recalc_crc = true);
 
+        /**
+         * @returns Length of frame in clock cycles.
+         */
+        size_t GetLenCycles();
+
+        /**
+         * @param index Index of bit within frame
+         * @returns Position of first cycle of bit (in clock cycles from start of frame),
+         *          that is time of edge before the bit.
+         */
+        size_t GetBitStartCycle(size_t index);
+
+        /**
+         * @param index Index of bit within frame
+         * @returns Position of sample point of bit (in clock cycles from start of frame),
+         *          that is position of first cycle of Phase 2.
+         */
+        size_t GetSamplePointCycle(size_t index);
+
+        /**
+         * @param pos Position in clock cycles from start of frame
+         * @returns Index of bit which is on CAN bus during cycle on 'pos' position.
+         */
+        size_t GetBitAtCycle(size_t pos);
+
+        /**
+         * @param pos Position in clock cycles from start of frame
+         * @returns Cycle on 'pos' position.
+         */
+        Cycle GetCycleAt(size_t pos);
+
+        /**
+         * @param cycle Cycle of a bit of the frame
+         * @returns Position of cycle in clock cycles from start of frame.
+         */
+        size_t GetCyclePos(Cycle cycle);
+
         /**
          * Moves back in frame in units of Cycle bit values (smallest fractions from which
          * TIme Quanta is built).
          * @param from Starting cycle to move from.
          * @param move_by Number of cycles to move by.
-         * @returns Pointer to cycle which is 'move_by' before in frame, than 'from'.
+         * @returns Cycle which is 'move_by' before in frame, than 'from'.
          *
          * E.g. if 'from' is first cycle of first bit of base id, and 'move_by' is equal to
-         *      number of clock cycles per-bit time, then pointer to first cycle of SOF
-         *      will be returned.
+         *      number of clock cycles per-bit time, then first cycle of SOF will be
+         *      returned.
          */
-        Cycle *MoveCyclesBack(Cycle *from, size_t move_by);
+        Cycle MoveCyclesBack(Cycle from, size_t move_by);
 
         /**
          * Compensates recessive to dominat transition within a bit to account for input delay
@@ -487,8 +523,68 @@ class can::BitFrame : public Frame {
         void PutAck(size_t input_delay);
 
     private:
-        /* Bits within a frame */
-        std::list<Bit> bits_;
+        friend class Bit;
+
+        /*
+         * Cell holding address of this frame. Bits refer to their frame via this cell, so
+         * when frame is moved, only the cell is updated.
+         */
+        std::unique_ptr<BitFrame*> self_ = std::make_unique<BitFrame*>(this);
+
+        /*
+         * Storage of bits. Bits are stored in chunks which are never re-allocated, so pointer
+         * to a bit remains valid when other bits are inserted to or removed from a frame.
+         * Slot of a bit is its position within the storage (chunk index * chunk size + index
+         * within chunk).
+         */
+        std::vector<std::vector<Bit>> bit_chunks_;
+
+        /* Slots which are not used by any bit of a frame, and can be re-used */
+        std::vector<uint32_t> free_slots_;
+
+        /* Timing detail of bits which do not have default timing (by slot of a bit) */
+        std::unordered_map<uint32_t, Bit::Detail> bit_details_;
+
+        /* Bits within a frame (slots of bits in order in which they are on CAN bus) */
+        std::vector<uint32_t> bits_;
+
+        /*
+         * Index of bits. Holds position of bit (within 'bits_') for each slot, and positions of
+         * bits of each bit type. Index is valid for first 'index_valid_' bits of frame, the rest
+         * is re-built on demand (when a bit beyond is looked up).
+         */
+        std::vector<uint32_t> slot_pos_;
+        std::vector<uint32_t> kind_pos_[static_cast<size_t>(BitKind::Undefined) + 1];
+        size_t index_valid_ = 0;
+
+        /*
+         * Time index. Holds position (in clock cycles) of first cycle of each bit, and
+         * length of frame as last entry. Positions of first 'time_valid_' + 1 bits are valid
+         * if timing of no bit changed since 'time_epoch_' (see Bit::timing_epoch_).
+         */
+        std::vector<size_t> cycle_pos_;
+        size_t time_valid_ = 0;
+        uint64_t time_epoch_ = 0;
+
+        /*
+         * State saved during last update of frame, used to re-calculate only a part of frame
+         * after it was modified:
+         *  - Values of bits up to CRC delimiter (to find first modified bit).
+         *  - Position from which bits were inserted / removed since last update.
+         *  - State of CRC registers at each CRC_CHECKPOINT_DIST bits, valid for first
+         *    'crc_valid_' bits.
+         */
+        struct CrcState
+        {
+            uint32_t crc15;
+            uint32_t crc17;
+            uint32_t crc21;
+        };
+
+        std::vector<BitVal> update_vals_;
+        size_t modified_from_ = 0;
+        std::vector<CrcState> crc_states_;
+        size_t crc_valid_ = 0;
 
         /* CRCs */
         uint32_t crc15_;
@@ -496,9 +592,10 @@ class can::BitFrame : public Frame {
         uint32_t crc21_;
         size_t crc_len;
 
-        /* Stuff counts: unsigned and grey coded */
-        uint8_t stuff_cnt_;
-        uint8_t stuff_cnt_encoded_;
+        /* Stuff engine (holds stuff count), and scratch buffers used during stuffing */
+        StuffEngine stuff_engine_;
+        std::vector<uint64_t> stuff_in_;
+        std::vector<uint32_t> stuff_pos_;
 
         /* Bit timing - used to construct time quantas / cycles within bits of frame*/
         BitTiming* dbt_;
@@ -519,9 +616,12 @@ class can::BitFrame : public Frame {
         /**
          * Inserts stuff bits from first bit till start of Stuff count field (CAN FD frame).
          * In CAN 2.0 frame finish until the end of frame.
+         * @param from Bit from which to insert stuff bits. Bit stuffing is resumed from state
+         *             given by bits preceding this bit (these must be stuffed already, and
+         *             must not end by run of 5 equal bits, see 'StuffResumePos').
          * @returns number of stuff bits inserted.
          */
-        size_t InsertNormalStuffBits();
+        size_t InsertNormalStuffBits(size_t from = 1);
 
         /**
          * Inserts stuff bits to stuff count field (first bit and stuff bit after parity).
@@ -533,6 +633,14 @@ class can::BitFrame : public Frame {
          */
         void InsertFixedStuffToCrc();
 
+        /**
+         * Inserts stuff bits to a frame. Each stuff bit has kind of bit preceding it, and
+         * opposite value.
+         * @param after Positions of bits after which stuff bits are inserted (ascending).
+         * @param stuff_kind Kind of inserted stuff bits.
+         */
+        void InsertStuffBits(const std::vector<uint32_t> &after, StuffKind stuff_kind);
+
         /**
          * Sets bits within stuff count field based on number of regular stuff bits.
          * @returns true if succesfull, false otherwise (e.g. stuff count bits not present)
@@ -548,39 +656,17 @@ class can::BitFrame : public Frame {
         /**
          * Iterates through bits of a frame till CRC field and calculates CRC. CRC bits
          * are NOT set to value of calculated CRC.
+         * @param from Bit from which CRC shall be re-calculated. CRC calculation is resumed from
+         *             state saved by previous CRC calculation (if still valid).
          * @returns calculated CRC
          */
-        uint32_t CalcCrc();
+        uint32_t CalcCrc(size_t from = 0);
 
         /**
          * Sets CRC bits to CRC value.
          */
         void UpdateCrcBits();
 
-        /**
-         * Prints bit which belongs to single bit field (SOF, IDE, RTR, etc...)
-         * @param bit iterator of bit to be printed
-         * @param vals Pointer to line with bit values
-         * @param names Pointer to line with bit names
-         * @param print_stuff_bits if true, stuff bits are included, if false, they are skipped.
-         */
-        void PrintSingleBitField(std::list<Bit>::iterator& bit,
-                                 std::string *vals,
-                                 std::string *names,
-                                 bool print_stuff_bits);
-
-        /**
-         * Prints bit which belongs to multiple bit field (Data, CRC, etc...)
-         * @param bit iterator of bit to be printed
-         * @param vals Pointer to line with bit values
-         * @param names Pointer to line with bit names
-         * @param print_stuff_bits if true, stuff bits are included, if false, they are skipped.
-         */
-        void PrintMultiBitField(std::list<Bit>::iterator& bit,
-                                std::string *vals,
-                                std::string *names,
-                                bool print_stuff_bits);
-
         /**
          * Appends bit at the end of frame
          * @param kind type of bit to be appended
@@ -593,6 +679,74 @@ class can::BitFrame : public Frame {
          * Constructs bits of a frame from metadata.
          */
         void ConstructFrame();
+
+        /**
+         * @param slot Slot of bit within bit storage
+         * @returns Pointer to bit stored in the slot
+         */
+        Bit* SlotBit(uint32_t slot);
+
+        /**
+         * Stores bit to free slot of bit storage. Bit is not inserted to a frame.
+         * @param bit Bit to store
+         * @returns Slot in which the bit was stored
+         */
+        uint32_t StoreBit(Bit bit);
+
+        /**
+         * Releases slot of bit storage, so that it can be re-used by another bit.
+         * @param slot Slot to release
+         */
+        void ReleaseSlot(uint32_t slot);
+
+        /**
+         * Links all bits (and their time quantas) to this frame (after frame was copied).
+         */
+        void RelinkBits();
+
+        /**
+         * Invalidates index of bits (and time index) from a position further, and marks the
+         * frame as modified from this position. Must be called whenever bits are inserted
+         * to / removed from a frame.
+         * @param index Position from which index is invalid.
+         */
+        void InvalidateIndex(size_t index);
+
+        /**
+         * Finds bit from which regular stuff bits are re-calculated, so that bits before it
+         * do not end by run of 5 equal bits (which needs stuff bit after it).
+         * @param from First modified bit.
+         * @returns 'from', or first bit of run of equal bits which ends before 'from'.
+         */
+        size_t StuffResumePos(size_t from);
+
+        /**
+         * Finds bit from which frame needs to be re-calculated by UpdateFrame.
+         * @returns Position of first bit whose value changed, or first bit from which bits
+         *          were inserted / removed since last update of frame.
+         */
+        size_t FirstModifiedBit();
+
+        /**
+         * Saves values of bits to detect modified bits during next update of frame.
+         */
+        void SaveUpdateVals();
+
+        /**
+         * Re-builds invalid part of index of bits.
+         */
+        void UpdateIndex();
+
+        /**
+         * Re-builds invalid part of time index.
+         */
+        void UpdateTimeIndex();
+
+        /**
+         * @param kind Bit type
+         * @returns Positions of all bits of given type within a frame (ascending).
+         */
+        const std::vector<uint32_t>& GetFieldPos(BitKind kind);
 };
 
 #endif
\ No newline at end of file
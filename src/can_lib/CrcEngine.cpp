@@ -0,0 +1,119 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *****************************************************************************/
+
+#include <array>
+#include <assert.h>
+
+#include "can.h"
+#include "CrcEngine.h"
+
+
+/**
+ * Creates lookup table for CRC with given width and polynomial. Entry 'i' holds CRC register
+ * after processing 8 zero bits from register which has 'i' in its upper 8 bits.
+ */
+static constexpr std::array<uint32_t, 256> CreateCrcTable(size_t width, uint32_t poly)
+{
+    std::array<uint32_t, 256> table = {};
+    uint32_t mask = (1U << width) - 1;
+    uint32_t top = 1U << (width - 1);
+
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t reg = i << (width - 8);
+        for (int j = 0; j < 8; j++)
+            reg = ((reg & top) ? ((reg << 1) ^ poly) : (reg << 1)) & mask;
+        table[i] = reg;
+    }
+    return table;
+}
+
+static constexpr std::array<uint32_t, 256> crc15_table = CreateCrcTable(15, 0x4599);
+static constexpr std::array<uint32_t, 256> crc17_table = CreateCrcTable(17, 0x1685B);
+static constexpr std::array<uint32_t, 256> crc21_table = CreateCrcTable(21, 0x102899);
+
+
+can::CrcEngine::CrcEngine(CrcKind kind)
+{
+    switch (kind)
+    {
+    case CrcKind::Crc15:
+        width_ = 15;
+        poly_ = 0x4599;
+        init_ = 0;
+        table_ = crc15_table.data();
+        break;
+    case CrcKind::Crc17:
+        width_ = 17;
+        poly_ = 0x1685B;
+        init_ = 1U << 16;
+        table_ = crc17_table.data();
+        break;
+    case CrcKind::Crc21:
+        width_ = 21;
+        poly_ = 0x102899;
+        init_ = 1U << 20;
+        table_ = crc21_table.data();
+        break;
+    }
+    Reset();
+}
+
+
+void can::CrcEngine::Reset()
+{
+    crc_ = init_;
+}
+
+
+void can::CrcEngine::Update(uint64_t bits, size_t n_bits)
+{
+    assert(n_bits <= 64);
+
+    uint32_t mask = (1U << width_) - 1;
+    uint32_t crc = crc_;
+
+    // Whole bytes via lookup table
+    while (n_bits >= 8)
+    {
+        n_bits -= 8;
+        uint32_t byte = static_cast<uint32_t>(bits >> n_bits) & 0xFF;
+        uint32_t index = ((crc >> (width_ - 8)) ^ byte) & 0xFF;
+        crc = ((crc << 8) ^ table_[index]) & mask;
+    }
+
+    // Remaining bits one by one
+    while (n_bits > 0)
+    {
+        n_bits--;
+        uint32_t crc_nxt = (static_cast<uint32_t>(bits >> n_bits) ^ (crc >> (width_ - 1))) & 0x1;
+        crc = ((crc << 1) & mask) ^ (poly_ & (0U - crc_nxt));
+    }
+
+    crc_ = crc;
+}
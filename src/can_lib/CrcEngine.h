@@ -0,0 +1,96 @@
+#ifndef CRC_ENGINE_H
+#define CRC_ENGINE_H
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *****************************************************************************/
+
+#include <cstdint>
+#include <cstddef>
+
+#include "can.h"
+
+/**
+ * @class CrcEngine
+ * @namespace can
+ *
+ * Calculates CRC of CAN frame (CRC15, CRC17 or CRC21 as defined by ISO11898-1). Input bits
+ * are processed in packed words (MSB first) via lookup table, 8 bits at a time.
+ */
+class can::CrcEngine
+{
+    public:
+        /**
+         * Creates CRC engine with register set to initial value of given CRC type.
+         * @param kind Type of CRC
+         */
+        CrcEngine(CrcKind kind);
+
+        /**
+         * Sets CRC register to its initial value.
+         */
+        void Reset();
+
+        /**
+         * Processes bits of a packed word. Bits are processed from MSB to LSB.
+         * @param bits Bits to process (lowest 'n_bits' bits are processed)
+         * @param n_bits Number of bits to process (up to 64)
+         */
+        void Update(uint64_t bits, size_t n_bits);
+
+        /**
+         * @returns Value of CRC register.
+         */
+        inline uint32_t crc() const {
+            return crc_;
+        };
+
+        /**
+         * Restores CRC register (e.g. from previously saved value).
+         * @param crc Value of CRC register
+         */
+        inline void set_crc(uint32_t crc) {
+            crc_ = crc;
+        };
+
+    private:
+        /* Width of CRC in bits */
+        size_t width_;
+
+        /* Polynomial (without highest order term) */
+        uint32_t poly_;
+
+        /* Initial value of CRC register */
+        uint32_t init_;
+
+        /* CRC register */
+        uint32_t crc_;
+
+        /* Lookup table for processing 8 bits at once */
+        const uint32_t *table_;
+};
+
+#endif
@@ -27,6 +27,7 @@
  *****************************************************************************/
 
 #include <assert.h>
+#include <vector>
 
 #include "can.h"
 #include "Frame.h"
@@ -298,12 +299,19 @@ can::Frame can::CtuCanFdInterface::ReadFrame()
     EsiFlag is_esi;
 
     frame_format_word.u32 = MemBusAgentRead32(CTU_CAN_FD_RX_DATA);
-    identifier_word.u32 = MemBusAgentRead32(CTU_CAN_FD_RX_DATA);
+    rwcnt = frame_format_word.s.rwcnt;
+
+    // Issue reads of rest of the frame at once (identifier, timestamp and data words)
+    std::vector<PliFuture<uint32_t>> rx_words;
+    rx_words.reserve(rwcnt);
+    for (int i = 0; i < rwcnt; i++)
+        rx_words.push_back(MemBusAgentRead32Async(CTU_CAN_FD_RX_DATA));
+
+    identifier_word.u32 = rx_words[0].Get();
 
     // Skip Timestamp words
-    data_word = MemBusAgentRead32(CTU_CAN_FD_RX_DATA);
-    data_word = MemBusAgentRead32(CTU_CAN_FD_RX_DATA);
-    rwcnt = frame_format_word.s.rwcnt;
+    rx_words[1].Get();
+    rx_words[2].Get();
 
     // Set flags
     if (frame_format_word.s.fdf == ctu_can_fd_frame_format_w_fdf::FD_CAN)
@@ -343,7 +351,7 @@ can::Frame can::CtuCanFdInterface::ReadFrame()
     // Read data
     for (int i = 0; i < rwcnt - 3; i++)
     {
-        data_word = MemBusAgentRead32(CTU_CAN_FD_RX_DATA);
+        data_word = rx_words[i + 3].Get();
 
         for (int j = 0; j < 4; j++)
         {
@@ -30,23 +30,32 @@
 
 #include "can.h"
 #include "Cycle.h"
+#include "Bit.h"
 
-can::Cycle::Cycle(TimeQuanta *parent) : parent_(parent)
-{}
-
-can::Cycle::Cycle(TimeQuanta *parent, BitVal val):
-    parent_(parent),
-    has_def_val_(false),
-    val_(val)
+can::Cycle::Cycle(Bit *bit, size_t offset):
+    bit_(bit),
+    offset_(offset)
 {}
 
 void can::Cycle::ForceVal(BitVal val)
 {
-    has_def_val_ = false;
-    val_ = val;
+    bit_->ForceCycles(offset_, 1, val);
 }
 
 void can::Cycle::ReleaseVal()
 {
-    has_def_val_ = true;
-}
\ No newline at end of file
+    bit_->ReleaseCycles(offset_, 1);
+}
+
+bool can::Cycle::has_def_val() const
+{
+    return bit_->FindForcedRun(offset_) == nullptr;
+}
+
+can::BitVal can::Cycle::bit_val() const
+{
+    const Bit::ForcedRun *run = bit_->FindForcedRun(offset_);
+    if (run == nullptr)
+        return bit_->val_;
+    return run->val;
+}
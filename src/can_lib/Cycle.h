@@ -33,24 +33,22 @@
 #include "can.h"
 
 /**
- * @class CycleBitValue
+ * @class Cycle
  * @namespace can
  *
- * Represents value of single clock cycle within a time quanta.
+ * Handle to value of single clock cycle within a bit. Cycles are not stored, a bit
+ * holds only values of cycles which are forced (all other cycles have default value of
+ * the bit). Handle refers to a cycle by its index within the bit.
  */
 class can::Cycle
 {
     public:
 
         /**
-         * Default value for given cycle.
+         * @param bit Bit which contains the cycle
+         * @param offset Index of cycle within the bit
          */
-        Cycle(TimeQuanta *parent);
-
-        /**
-         * Forced value for given cycle.
-         */
-        Cycle(TimeQuanta *parent, BitVal val);
+        Cycle(Bit *bit, size_t offset);
 
         /**
          * Forces value within a cycle
@@ -63,24 +61,31 @@ class can::Cycle
          */
         void ReleaseVal();
 
+        /**
+         * @returns true if cycle has default value (value of its bit), false if forced.
+         */
+        bool has_def_val() const;
+
+        /**
+         * @returns Value of the cycle (forced value, or value of its bit).
+         */
+        BitVal bit_val() const;
+
         // Getters
-        inline bool has_def_val() const {
-            return has_def_val_;
+        inline Bit* bit() const {
+            return bit_;
         };
 
-        inline BitVal bit_val() const {
-            return val_;
+        inline size_t offset() const {
+            return offset_;
         };
 
-    protected:
-        /* Time quanta which contains this cycle */
-        TimeQuanta *parent_;
-
-        /* Default value from CanBit should be taken */
-        bool has_def_val_ = true;
+    private:
+        /* Bit which contains the cycle */
+        Bit *bit_;
 
-        /* If has_default_value_ = false, then cycle has this value */
-        BitVal val_ = BitVal::Recessive;
+        /* Index of cycle within the bit */
+        size_t offset_;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -99,21 +99,21 @@ void can::Frame::Randomize()
         int max_ident_pow = (frame_flags().is_ide() == IdentKind::Ext) ?
                                 CAN_EXTENDED_ID_MAX : CAN_BASE_ID_MAX;
 
-        set_identifier(rand() % max_ident_pow);
+        set_identifier(Rand() % max_ident_pow);
     }
 
     if (randomize_dlc_)
     {
         // Constrain here so that we get reasonable frames for CAN 2.0
         if (frame_flags().is_fdf() == FrameKind::CanFd)
-            set_dlc(static_cast<uint8_t>(rand() % 0x9));
+            set_dlc(static_cast<uint8_t>(Rand() % 0x9));
         else
-            set_dlc(static_cast<uint8_t>(rand() % 0xF));
+            set_dlc(static_cast<uint8_t>(Rand() % 0xF));
     }
 
     if (randomize_data_)
         for (int i = 0; i < data_len_; i++)
-            data_[i] = static_cast<uint8_t>(rand() % 256);
+            data_[i] = static_cast<uint8_t>(Rand() % 256);
 }
 
 
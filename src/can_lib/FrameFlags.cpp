@@ -203,7 +203,7 @@ void can::FrameFlags::Randomize()
 {
     if (randomize_fdf_)
     {
-        if (rand() % 2 == 1)
+        if (Rand() % 2 == 1)
             is_fdf_ = FrameKind::Can20;
         else
             is_fdf_ = FrameKind::CanFd;
@@ -211,7 +211,7 @@ void can::FrameFlags::Randomize()
 
     if (randomize_ide_)
     {
-        if (rand() % 2 == 1)
+        if (Rand() % 2 == 1)
             is_ide_ = IdentKind::Base;
         else
             is_ide_ = IdentKind::Ext;
@@ -221,7 +221,7 @@ void can::FrameFlags::Randomize()
     {
         if (is_fdf_ == FrameKind::CanFd)
             is_rtr_ = RtrFlag::Data;
-        else if (rand() % 4 == 1)
+        else if (Rand() % 4 == 1)
             is_rtr_ = RtrFlag::Rtr;
         else
             is_rtr_ = RtrFlag::Data;
@@ -231,7 +231,7 @@ void can::FrameFlags::Randomize()
     {
         if (is_fdf_ == FrameKind::Can20)
             is_brs_ = BrsFlag::NoShift;
-        else if (rand() % 2 == 1)
+        else if (Rand() % 2 == 1)
             is_brs_ = BrsFlag::DoShift;
         else
             is_brs_ = BrsFlag::NoShift;
@@ -241,7 +241,7 @@ void can::FrameFlags::Randomize()
     {
         if (is_fdf_ == FrameKind::Can20)
             is_esi_ = EsiFlag::ErrAct;
-        else if (rand() % 2 == 1)
+        else if (Rand() % 2 == 1)
             is_esi_ = EsiFlag::ErrPas;
         else
             is_esi_ = EsiFlag::ErrAct;
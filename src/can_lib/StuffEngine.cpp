@@ -0,0 +1,301 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <assert.h>
+#include <cstdlib>
+#include <iostream>
+
+#include "can.h"
+#include "StuffEngine.h"
+
+
+/**
+ * Appends bits to packed stream.
+ * @param out Packed stream
+ * @param out_len Length of packed stream in bits (updated)
+ * @param bits Bits to append (lowest 'n_bits' bits are appended, LSB first)
+ * @param n_bits Number of bits to append (up to 64)
+ */
+static void AppendBits(std::vector<uint64_t> *out, size_t *out_len, uint64_t bits,
+                       size_t n_bits)
+{
+    if (n_bits == 0)
+        return;
+    if (n_bits < 64)
+        bits &= (1ULL << n_bits) - 1;
+
+    size_t shift = *out_len % 64;
+    if (shift == 0)
+        out->push_back(bits);
+    else {
+        out->back() |= bits << shift;
+        if (shift + n_bits > 64)
+            out->push_back(bits >> (64 - shift));
+    }
+    *out_len += n_bits;
+}
+
+
+/**
+ * Appends range of bits of packed stream to another packed stream.
+ */
+static void AppendRange(std::vector<uint64_t> *out, size_t *out_len, const uint64_t *in,
+                        size_t from, size_t to)
+{
+    while (from < to)
+    {
+        size_t shift = from % 64;
+        size_t n_bits = std::min<size_t>(64 - shift, to - from);
+        AppendBits(out, out_len, in[from / 64] >> shift, n_bits);
+        from += n_bits;
+    }
+}
+
+
+can::StuffEngine::StuffEngine()
+{
+    Reset();
+}
+
+
+void can::StuffEngine::Reset()
+{
+    prev_val_ = BitVal::Dominant;
+    same_bits_ = 1;
+    stuff_cnt_ = 0;
+}
+
+
+void can::StuffEngine::SetState(BitVal prev_val, size_t same_bits, size_t stuff_cnt)
+{
+    // Stuff bit after run of 5 equal bits is inserted only after input bit, so stuffing
+    // can't be resumed right after such run. Caller shall resume from its first bit.
+    if (same_bits == 0 || same_bits >= 5) {
+        std::cerr << "Stuffing can't be resumed after " << same_bits << " equal bits!"
+                  << std::endl;
+        std::abort();
+    }
+
+    prev_val_ = prev_val;
+    same_bits_ = same_bits;
+    stuff_cnt_ = stuff_cnt;
+}
+
+
+size_t can::StuffEngine::Stuff(const uint64_t *in, size_t n_bits, bool stuff_last,
+                               std::vector<uint64_t> *out, std::vector<uint32_t> *stuff_pos)
+{
+    size_t n_words = (n_bits + 63) / 64;
+    size_t n_stuff = 0;
+    size_t out_len = 0;
+    size_t copied = 0;
+
+    assert(same_bits_ < 5 && "Stream ended without stuff bit can't be continued");
+
+    if (out != nullptr)
+        out->clear();
+    if (n_bits == 0)
+        return 0;
+
+    /*
+     * Bit 'i' of 'eq' is set when input bit 'i' equals to previous bit. Stuff bit is
+     * inserted after bit 'i' when bits 'i - 3' to 'i' of 'eq' are set, so 'eq' of previous
+     * word is needed for lowest three bits. Before first word, 'eq' holds run of equal
+     * bits from state of engine (as if these bits preceded the stream).
+     */
+    uint64_t prev_word = (prev_val_ == BitVal::Recessive) ? (1ULL << 63) : 0;
+    uint64_t prev_eq = 0;
+    for (size_t i = 1; i < same_bits_ && i < 4; i++)
+        prev_eq |= 1ULL << (64 - i);
+
+    // Stuff bit inserted after bit 63 of a word breaks run of equal bits in next word
+    uint64_t flip_next = 0;
+
+    // Run of equal bits can end earliest on this position (after inserted stuff bit)
+    size_t min_end = 0;
+
+    size_t last_stuff = SIZE_MAX;
+
+    for (size_t w = 0; w < n_words; w++)
+    {
+        uint64_t word = in[w];
+        uint64_t eq = ~(word ^ ((word << 1) | (prev_word >> 63))) ^ flip_next;
+        flip_next = 0;
+
+        uint64_t valid = (w == n_words - 1 && n_bits % 64) ? ((1ULL << (n_bits % 64)) - 1)
+                                                            : ~0ULL;
+        while (true)
+        {
+            uint64_t run = eq & ((eq << 1) | (prev_eq >> 63)) &
+                                ((eq << 2) | (prev_eq >> 62)) &
+                                ((eq << 3) | (prev_eq >> 61));
+            run &= valid;
+
+            // Mask runs which end before previously inserted stuff bit
+            if (min_end > w * 64) {
+                size_t skip = min_end - w * 64;
+                run &= (skip >= 64) ? 0 : ~((1ULL << skip) - 1);
+            }
+            if (run == 0)
+                break;
+
+            size_t bit = static_cast<size_t>(__builtin_ctzll(run));
+            size_t pos = w * 64 + bit;
+
+            // No stuff bit after last bit of stream (e.g. before Stuff count)
+            if (pos == n_bits - 1 && !stuff_last)
+                break;
+
+            if (out != nullptr) {
+                AppendRange(out, &out_len, in, copied, pos + 1);
+                uint64_t stuff_val = ((word >> bit) & 0x1) ^ 0x1;
+                AppendBits(out, &out_len, stuff_val, 1);
+                copied = pos + 1;
+            }
+            if (stuff_pos != nullptr)
+                stuff_pos->push_back(static_cast<uint32_t>(pos));
+            n_stuff++;
+            last_stuff = pos;
+
+            // Next bit is compared to stuff bit (which has opposite value)
+            if (bit == 63)
+                flip_next = 1;
+            else
+                eq ^= 1ULL << (bit + 1);
+            min_end = pos + 4;
+        }
+
+        prev_word = word;
+        prev_eq = eq;
+    }
+
+    if (out != nullptr)
+        AppendRange(out, &out_len, in, copied, n_bits);
+
+    // Calculate state at the end of stream
+    size_t last = n_bits - 1;
+    BitVal last_val = static_cast<BitVal>((in[last / 64] >> (last % 64)) & 0x1);
+    if (last_stuff == last) {
+        prev_val_ = (last_val == BitVal::Dominant) ? BitVal::Recessive : BitVal::Dominant;
+        same_bits_ = 1;
+    } else {
+        size_t same_bits = 1;
+        size_t i = last;
+        while (same_bits < 5)
+        {
+            // Run continues to state of engine before the stream
+            if (i == 0) {
+                if (prev_val_ == last_val)
+                    same_bits = std::min<size_t>(same_bits + same_bits_, 5);
+                break;
+            }
+
+            BitVal prev = static_cast<BitVal>((in[(i - 1) / 64] >> ((i - 1) % 64)) & 0x1);
+
+            // Run starts with stuff bit (stuff bit has opposite value than bit before it)
+            if (last_stuff != SIZE_MAX && i == last_stuff + 1) {
+                if (prev != last_val)
+                    same_bits++;
+                break;
+            }
+
+            if (prev != last_val)
+                break;
+            same_bits++;
+            i--;
+        }
+        prev_val_ = last_val;
+        same_bits_ = same_bits;
+    }
+    stuff_cnt_ += n_stuff;
+
+    return n_stuff;
+}
+
+
+size_t can::StuffEngine::StuffRef(const uint64_t *in, size_t n_bits, bool stuff_last,
+                                  std::vector<uint64_t> *out, std::vector<uint32_t> *stuff_pos)
+{
+    size_t n_stuff = 0;
+    size_t out_len = 0;
+
+    assert(same_bits_ < 5 && "Stream ended without stuff bit can't be continued");
+
+    if (out != nullptr)
+        out->clear();
+
+    for (size_t pos = 0; pos < n_bits; pos++)
+    {
+        BitVal val = static_cast<BitVal>((in[pos / 64] >> (pos % 64)) & 0x1);
+
+        if (out != nullptr)
+            AppendBits(out, &out_len, static_cast<uint64_t>(val), 1);
+
+        if (val == prev_val_)
+            same_bits_++;
+        else
+            same_bits_ = 1;
+        prev_val_ = val;
+
+        if (same_bits_ == 5)
+        {
+            // This is exception for stuff bit inserted just before Stuff count!
+            if (pos == n_bits - 1 && !stuff_last)
+                continue;
+
+            prev_val_ = (val == BitVal::Dominant) ? BitVal::Recessive : BitVal::Dominant;
+            same_bits_ = 1;
+            if (out != nullptr)
+                AppendBits(out, &out_len, static_cast<uint64_t>(prev_val_), 1);
+            if (stuff_pos != nullptr)
+                stuff_pos->push_back(static_cast<uint32_t>(pos));
+            n_stuff++;
+        }
+    }
+    stuff_cnt_ += n_stuff;
+
+    return n_stuff;
+}
+
+
+uint8_t can::StuffEngine::stuff_cnt_encoded() const
+{
+    // Gray code of stuff count
+    uint8_t cnt = stuff_cnt();
+    return static_cast<uint8_t>(cnt ^ (cnt >> 1));
+}
+
+
+uint8_t can::StuffEngine::stuff_parity() const
+{
+    uint8_t enc = stuff_cnt_encoded();
+    return static_cast<uint8_t>((enc ^ (enc >> 1) ^ (enc >> 2)) & 0x1);
+}
@@ -0,0 +1,132 @@
+#ifndef STUFF_ENGINE_H
+#define STUFF_ENGINE_H
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *****************************************************************************/
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "can.h"
+
+/**
+ * @class StuffEngine
+ * @namespace can
+ *
+ * Inserts regular stuff bits to a stream of bits (as defined by ISO11898-1). Input bits
+ * are processed in packed words (LSB first, bit 'i' of stream is bit 'i % 64' of word
+ * 'i / 64'). Runs of 5 equal bits are searched by bitwise operations over whole word, so
+ * processing time depends on number of inserted stuff bits, not on number of bits.
+ *
+ * Number of inserted stuff bits is counted, so that stuff count of CAN FD frame (and its
+ * parity) is available once stream is stuffed.
+ */
+class can::StuffEngine
+{
+    public:
+        /**
+         * Creates stuff engine with state as if SOF was the last processed bit.
+         */
+        StuffEngine();
+
+        /**
+         * Sets state of engine as if SOF was the last processed bit.
+         */
+        void Reset();
+
+        /**
+         * Sets state of engine (e.g. to resume stuffing of part of a frame).
+         * @param prev_val Value of last processed bit
+         * @param same_bits Number of consecutive bits of equal value ending with last
+         *                  processed bit (including stuff bit which starts the run). Shall
+         *                  be less than 5, since stuff bit is inserted only after input
+         *                  bit. Bits ending by run of 5 equal bits shall be stuffed again
+         *                  from the first bit of the run.
+         * @param stuff_cnt Number of stuff bits inserted so far
+         */
+        void SetState(BitVal prev_val, size_t same_bits, size_t stuff_cnt);
+
+        /**
+         * Inserts stuff bits to a stream of bits.
+         * @param in Input bits (packed)
+         * @param n_bits Number of input bits
+         * @param stuff_last If false, no stuff bit is inserted after last bit of stream
+         *                   (this is the case of last bit before Stuff count in CAN FD
+         *                   frames)
+         * @param out Stuffed stream (packed), not returned when nullptr
+         * @param stuff_pos Positions of input bits after which stuff bit was inserted
+         * @returns Number of inserted stuff bits
+         */
+        size_t Stuff(const uint64_t *in, size_t n_bits, bool stuff_last,
+                     std::vector<uint64_t> *out, std::vector<uint32_t> *stuff_pos);
+
+        /**
+         * Reference implementation of 'Stuff' which processes bits one by one. Has the
+         * same arguments and returns the same results as 'Stuff'.
+         */
+        size_t StuffRef(const uint64_t *in, size_t n_bits, bool stuff_last,
+                        std::vector<uint64_t> *out, std::vector<uint32_t> *stuff_pos);
+
+        // Getters
+        inline BitVal prev_val() const {
+            return prev_val_;
+        };
+
+        inline size_t same_bits() const {
+            return same_bits_;
+        };
+
+        /**
+         * @returns Number of inserted stuff bits modulo 8.
+         */
+        inline uint8_t stuff_cnt() const {
+            return static_cast<uint8_t>(stuff_cnt_ % 8);
+        };
+
+        /**
+         * @returns Stuff count encoded in Gray code (as transmitted in CAN FD frame).
+         */
+        uint8_t stuff_cnt_encoded() const;
+
+        /**
+         * @returns Parity of encoded stuff count (as transmitted in CAN FD frame).
+         */
+        uint8_t stuff_parity() const;
+
+    private:
+        /* Value of last processed bit */
+        BitVal prev_val_;
+
+        /* Number of consecutive equal bits ending with last processed bit */
+        size_t same_bits_;
+
+        /* Number of inserted stuff bits */
+        size_t stuff_cnt_;
+};
+
+#endif
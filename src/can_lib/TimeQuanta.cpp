@@ -31,96 +31,71 @@
 
 #include "TimeQuanta.h"
 #include "Cycle.h"
+#include "Bit.h"
 
 
-can::TimeQuanta::TimeQuanta(Bit *parent, size_t brp, BitPhase phase):
-    phase_(phase),
-    parent_(parent)
-{
-    for (size_t i = 0; i < brp; i++)
-        cycles_.push_back(Cycle(this));
-}
-
-
-can::TimeQuanta::TimeQuanta(Bit *parent, size_t brp, BitPhase phase, BitVal val):
-    phase_(phase),
-    parent_(parent)
-{
-    for (size_t i = 0; i < brp; i++)
-        cycles_.push_back(Cycle(this, val));
-}
+can::TimeQuanta::TimeQuanta(Bit *parent, size_t offset, size_t len, BitPhase phase):
+    parent_(parent),
+    offset_(offset),
+    len_(len),
+    phase_(phase)
+{}
 
 
 bool can::TimeQuanta::HasNonDefVals()
 {
-    for (auto & cycle : cycles_)
-        if (!cycle.has_def_val())
-            return true;
-    return false;
+    return parent_->HasForcedCycles(offset_, len_);
 }
 
 
 void can::TimeQuanta::SetAllDefVals()
 {
-    for (auto & cycle_ : cycles_)
-        cycle_.ReleaseVal();
+    parent_->ReleaseCycles(offset_, len_);
 }
 
 
 size_t can::TimeQuanta::getLengthCycles()
 {
-    return cycles_.size();
+    return len_;
 }
 
 
-std::list<can::Cycle>::iterator can::TimeQuanta::GetCycleBitValIter(size_t index)
+can::Cycle can::TimeQuanta::getCycleBitValue(size_t index)
 {
-    assert("Cycle index does not exist!" && index < cycles_.size());
-    auto iterator = cycles_.begin();
-    std::advance(iterator, index);
-    return iterator;
-}
-
-
-can::Cycle* can::TimeQuanta::getCycleBitValue(size_t index)
-{
-    return &(*GetCycleBitValIter(index));
+    assert("Cycle index does not exist!" && index < len_);
+    return Cycle(parent_, offset_ + index);
 }
 
 
 void can::TimeQuanta::Lengthen(size_t by_cycles)
 {
-    for (size_t i = 0; i < by_cycles; i++)
-        cycles_.push_back(Cycle(this));
+    parent_->ResizeTQ(this, len_ + by_cycles);
 }
 
 
 void can::TimeQuanta::Lengthen(size_t by_cycles, BitVal bit_value)
 {
-    for (size_t i = 0; i < by_cycles; i++)
-        cycles_.push_back(Cycle(this, bit_value));
+    size_t end = offset_ + len_;
+    parent_->ResizeTQ(this, len_ + by_cycles);
+    parent_->ForceCycles(end, by_cycles, bit_value);
 }
 
 
 void can::TimeQuanta::Shorten(size_t by_cycles)
 {
-    size_t by_cycles_constrained = (cycles_.size() > by_cycles) ?
-        by_cycles : cycles_.size();
+    size_t by_cycles_constrained = (len_ > by_cycles) ? by_cycles : len_;
 
-    for (size_t i = 0; i < by_cycles_constrained; i++)
-        cycles_.pop_back();
+    parent_->ResizeTQ(this, len_ - by_cycles_constrained);
 }
 
 
 void can::TimeQuanta::ForceCycleValue(size_t cycle_index, BitVal bit_value)
 {
-    auto cycle_bit_value_iterator = GetCycleBitValIter(cycle_index);
-    cycle_bit_value_iterator->ForceVal(bit_value);
+    getCycleBitValue(cycle_index).ForceVal(bit_value);
 }
 
 
 void can::TimeQuanta::ForceVal(BitVal bit_value)
 {
-    for (auto & cycle_bit_value : cycles_)
-        cycle_bit_value.ForceVal(bit_value);
-}
\ No newline at end of file
+    parent_->ForceCycles(offset_, len_, bit_value);
+}
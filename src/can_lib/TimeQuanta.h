@@ -30,7 +30,7 @@
 
 #include <iostream>
 #include <cstdint>
-#include <list>
+#include <vector>
 
 #include "can.h"
 #include "Cycle.h"
@@ -39,24 +39,20 @@
  * @class TimeQuanta
  * @namespace can
  *
- * Represents single Time Quanta. Contains individual cycles.
+ * Represents single Time Quanta. Time quanta refers to a range of cycles of parent bit.
+ * Forced values of the cycles are held by parent bit.
  */
 class can::TimeQuanta
 {
     public:
 
         /**
-         *  @param brp Baud rate prescaler (number of cycles within Time quanta)
-         *  @param bit_phase Phase of bit to which this time quanta belongs
+         * @param parent Bit which holds cycles of this time quanta
+         * @param offset Index of first cycle of time quanta within parent bit
+         * @param len Number of cycles within Time quanta (Baud rate prescaler)
+         * @param phase Phase of bit to which this time quanta belongs
          */
-        TimeQuanta(Bit *parent, size_t brp, BitPhase phase);
-
-        /**
-         * @param brp Baud rate prescaler (number of cycles within Time quanta)
-         * @param bit_phase Phase of bit to which this time quanta belongs
-         * @param bit_value Bit value of each cycle in time quanta (set as non default value)
-         */
-        TimeQuanta(Bit *parent, size_t brp, BitPhase phase, BitVal value);
+        TimeQuanta(Bit *parent, size_t offset, size_t len, BitPhase phase);
 
         /**
          * @returns true if any of cycles in this Time quanta contain non-default values.
@@ -77,16 +73,9 @@ class can::TimeQuanta
         /**
          * Gets value of cycle.
          * @param index Position of cycle within Time quanta.
-         * @returns Pointer to cycle bit value.
+         * @returns Handle to cycle bit value.
          */
-        Cycle *getCycleBitValue(size_t index);
-
-        /**
-         * Gets value of cycle
-         * @param index Position of cycle within Time Quanta.
-         * @returns Iterator pointing to cycle bit value
-         */
-        std::list<Cycle>::iterator GetCycleBitValIter(size_t index);
+        Cycle getCycleBitValue(size_t index);
 
         /**
          * Lengthens time quanta (appends cycles at the end).
@@ -129,16 +118,24 @@ class can::TimeQuanta
         };
 
     private:
-        /* Cycle bit values within time quanta */
-        std::list<Cycle> cycles_;
+        friend class Bit;
+
+        /*
+         * Parent Bit which holds cycles of this Time Quanta. Bits stay in place when their
+         * frame is moved, copy of a frame re-links time quantas to bits of the copy.
+         */
+        Bit *parent_;
+
+        /* Index of first cycle of this Time Quanta within parent Bit */
+        size_t offset_;
+
+        /* Number of cycles within Time Quanta */
+        size_t len_;
 
         /**
          * Phase of bit to which this time quanta belongs.
          */
         BitPhase phase_;
-
-        /* Parent Bit which contains this Time Quanta*/
-        Bit *parent_;
 };
 
 #endif
\ No newline at end of file
@@ -26,12 +26,30 @@
  *
  *****************************************************************************/
 
+#include <cstdlib>
 #include <iostream>
+#include <random>
 
 #include "can.h"
 
 using namespace can;
 
+
+static thread_local std::minstd_rand rand_engine;
+
+
+int can::Rand()
+{
+    return static_cast<int>(rand_engine() % (static_cast<unsigned long>(RAND_MAX) + 1));
+}
+
+
+void can::SeedRand(unsigned int seed)
+{
+    rand_engine.seed(seed);
+}
+
+
 std::ostream& can::operator<<(std::ostream& os, const FrameKind &frame_kind)
 {
     if (frame_kind == FrameKind::Can20)
@@ -29,6 +29,7 @@
  *****************************************************************************/
 
 #include <iostream>
+#include <cstdint>
 
 namespace can {
 
@@ -72,7 +73,7 @@ namespace can {
 
     std::ostream &operator<<(std::ostream &os, const EsiFlag &esi_flag);
 
-    enum class BitKind
+    enum class BitKind : uint8_t
     {
         Sof,
         BaseIdent,
@@ -105,12 +106,6 @@ namespace can {
         Undefined
     };
 
-    struct BitKindName
-    {
-        BitKind kind;
-        std::string name;
-    };
-
     enum class BitField
     {
         Sof,
@@ -122,18 +117,25 @@ namespace can {
         Eof
     };
 
-    enum class BitVal {
+    enum class BitVal : uint8_t {
         Dominant = 0,
         Recessive = 1
     };
 
-    enum class StuffKind
+    enum class StuffKind : uint8_t
     {
         NoStuff,
         Normal,
         Fixed
     };
 
+    enum class CrcKind
+    {
+        Crc15,
+        Crc17,
+        Crc21
+    };
+
     enum class BitRate
     {
         Nominal,
@@ -171,12 +173,15 @@ namespace can {
 
     /* Classes modeling CAN frame:
      *   Frame          - contains metadata (DLC, ID, Data, flags) of CAN frame
-     *   Bit            - Represents single bit on CAN bus. Contains time quantas.
-     *   TimeQuanta     - Represents single Time Quanta. Contains list of Cycle bit values.
-     *   CycleBitValue  - Value of bit during single cycle.
+     *   Bit            - Represents single bit on CAN bus. Contains time quantas and
+     *                    forced values of its cycles.
+     *   TimeQuanta     - Represents single Time Quanta. Refers to range of cycles of its bit.
+     *   Cycle          - Handle to value of bit during single cycle.
      *   FrameFlags     - Frame flags (RTR, IDE, BRS, etc...)
      *   BitTiming      - Timing parameters of CAN bus.
      *   BitFrame       - CAN frame with representation of each bit and its value.
+     *   CrcEngine      - Calculates CRC of CAN frame.
+     *   StuffEngine    - Inserts stuff bits to stream of bits.
      */
 
     class Bit;
@@ -190,10 +195,28 @@ namespace can {
 
     class BitTiming;
 
+    class CrcEngine;
+    class StuffEngine;
+
     // Test related classes
     class DutInterface;
     class CtuCanFdInterface;
 
+    /**
+     * Random number generator of the library (used like "rand" / "srand").
+     * Each thread has its own state, so that elementary test prepared on
+     * worker thread is reproducible by its seed, and does not interfere with
+     * thread which executes other elementary test.
+     *
+     * @returns Pseudo-random number in range 0 .. RAND_MAX.
+     */
+    int Rand();
+
+    /**
+     * Seeds random number generator of calling thread.
+     */
+    void SeedRand(unsigned int seed);
+
 #define CAN_BASE_ID_MAX 2048
 #define CAN_EXTENDED_ID_MAX 536870912
 #define CAN_BASE_ID_ALL_ONES 0b11111111111
@@ -26,6 +26,8 @@
  *
  *****************************************************************************/
 
+#include <cstdlib>
+#include <future>
 #include <iostream>
 #include <unistd.h>
 
@@ -71,9 +73,25 @@ void test::TestBase::ConfigureTest()
     TestMessage("TestBase: Configuration Entered");
 
     TestMessage("Querying test configuration from TB:");
-    this->dut_clk_period = TestControllerAgentGetCfgDutClockPeriod();
+
+    // Issue all queries at once, and only then wait for their results, so that
+    // simulator processes them back to back.
+    auto clk_period = TestControllerAgentGetCfgDutClockPeriodAsync();
+    auto nbt_brp = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_BRP");
+    auto nbt_prop = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_PROP");
+    auto nbt_ph1 = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_PH1");
+    auto nbt_ph2 = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_PH2");
+    auto nbt_sjw = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_SJW");
+    auto dbt_brp = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_BRP_FD");
+    auto dbt_prop = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_PROP_FD");
+    auto dbt_ph1 = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_PH1_FD");
+    auto dbt_ph2 = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_PH2_FD");
+    auto dbt_sjw = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_SJW_FD");
+    auto tb_seed = TestControllerAgentGetSeedAsync();
+
+    this->dut_clk_period = clk_period.Get();
     TestMessage("DUT clock period:");
-    TestMessage("%d ns", this->dut_clk_period.count());
+    TestMessage("%lld fs", static_cast<long long>(this->dut_clk_period.count()));
 
     // TODO: Query input delay from TB, and eventually from VIP configuration !!!
     this->dut_input_delay = 2;
@@ -86,22 +104,21 @@ void test::TestBase::ConfigureTest()
     // TODO: Query this from TB instead of putting CTU CAN FD specific value!
     this->dut_max_secondary_sample = 255;
 
-    this->nbt.brp_ = TestControllerAgentGetBitTimingElement("CFG_DUT_BRP");
-    this->nbt.prop_ = TestControllerAgentGetBitTimingElement("CFG_DUT_PROP");
-    this->nbt.ph1_ = TestControllerAgentGetBitTimingElement("CFG_DUT_PH1");
-    this->nbt.ph2_ = TestControllerAgentGetBitTimingElement("CFG_DUT_PH2");
-    this->nbt.sjw_ = TestControllerAgentGetBitTimingElement("CFG_DUT_SJW");
+    this->nbt.brp_ = nbt_brp.Get();
+    this->nbt.prop_ = nbt_prop.Get();
+    this->nbt.ph1_ = nbt_ph1.Get();
+    this->nbt.ph2_ = nbt_ph2.Get();
+    this->nbt.sjw_ = nbt_sjw.Get();
 
-    this->dbt.brp_ = TestControllerAgentGetBitTimingElement("CFG_DUT_BRP_FD");
-    this->dbt.prop_ = TestControllerAgentGetBitTimingElement("CFG_DUT_PROP_FD");
-    this->dbt.ph1_ = TestControllerAgentGetBitTimingElement("CFG_DUT_PH1_FD");
-    this->dbt.ph2_ = TestControllerAgentGetBitTimingElement("CFG_DUT_PH2_FD");
-    this->dbt.sjw_ = TestControllerAgentGetBitTimingElement("CFG_DUT_SJW_FD");
+    this->dbt.brp_ = dbt_brp.Get();
+    this->dbt.prop_ = dbt_prop.Get();
+    this->dbt.ph1_ = dbt_ph1.Get();
+    this->dbt.ph2_ = dbt_ph2.Get();
+    this->dbt.sjw_ = dbt_sjw.Get();
 
-    this->seed = TestControllerAgentGetSeed();
+    this->seed = tb_seed.Get();
     TestMessage("Seed: %d", this->seed);
-    printf("Seed: %d\n", seed);
-    srand(seed);
+    SeedRand(seed);
 
     TestMessage("Nominal Bit Timing configuration from TB:");
     this->nbt.Print();
@@ -118,7 +135,7 @@ void test::TestBase::ConfigureTest()
     ResetAgentDeassert();
 
     TestMessage("Configuring Clock generator agent");
-    ClockAgentSetPeriod(std::chrono::nanoseconds(this->dut_clk_period));
+    ClockAgentSetPeriod(this->dut_clk_period);
     ClockAgentSetJitter(std::chrono::nanoseconds(0));
     ClockAgentSetDuty(50);
     ClockAgentStart();
@@ -193,12 +210,29 @@ int test::TestBase::Run()
     }
 
     PrintTestInfo();
-    TestBigMessage("Starting test execution: ", test_name);
-
-    int variant_index = 0;
-
-    for (auto const &test_variant : test_variants)
+    TestBigMessage("Starting test execution: %s", test_name.c_str());
+
+    /* Position of each elementary test in order of execution */
+    std::vector<std::pair<size_t, const ElemTest*>> schedule;
+    for (size_t i = 0; i < test_variants.size(); i++)
+        for (auto const &elem_test : elem_tests[i])
+            schedule.emplace_back(i, &elem_test);
+
+    /*
+     * If test splits elementary tests to prepare and execute stage, next elementary
+     * test is prepared on worker thread while current one executes. Otherwise each
+     * elementary test is ran as whole.
+     */
+    std::unique_ptr<PreparedElemTest> prepared;
+    std::future<std::unique_ptr<PreparedElemTest>> next_prepared;
+    if (schedule.size() > 0)
+        prepared = PrepareSeededElemTest(schedule[0].first, *schedule[0].second);
+    bool pipelined = (prepared != nullptr);
+    size_t pos = 0;
+
+    for (size_t variant_index = 0; variant_index < test_variants.size(); variant_index++)
     {
+        const TestVariant &test_variant = test_variants[variant_index];
         PrintVariantInfo(test_variant);
 
         /* Used only in few tests with more stuff bits in single variant! */
@@ -207,18 +241,41 @@ int test::TestBase::Run()
         for (auto const & elem_test : elem_tests[variant_index])
         {
             PrintElemTestInfo(elem_test);
+            TestMessage("Elementary test seed: %u", GetElemTestSeed(variant_index, elem_test));
+
+            int elem_test_result;
+            if (pipelined && pos > 0)
+                prepared = next_prepared.get();
+
+            if (pipelined && pos + 1 < schedule.size())
+                next_prepared = std::async(std::launch::async,
+                                           &TestBase::PrepareSeededElemTest, this,
+                                           schedule[pos + 1].first,
+                                           std::cref(*schedule[pos + 1].second));
 
-            if (RunElemTest(elem_test, test_variant) != 0)
+            /* Elementary test which was not prepared (e.g. test prepares only
+             * some of its elementary tests) is ran as whole. */
+            if (prepared != nullptr)
             {
-                TestBigMessage("Elementary test %d failed.", elem_test.index_);
+                elem_test_result = ExecuteElemTest(elem_test, test_variant, *prepared);
+                prepared.reset();
+            } else {
+                SeedRand(GetElemTestSeed(variant_index, elem_test));
+                elem_test_result = RunElemTest(elem_test, test_variant);
+            }
+            pos++;
+
+            /* Preparation in flight (if any) is waited for when 'next_prepared' is
+             * destroyed. */
+            if (elem_test_result != 0)
+            {
+                TestBigMessage("Elementary test %zu failed.", elem_test.index_);
                 return (int)FinishTest();
             }
         }
 
         if (stuff_bits_in_variant > 0)
             TestMessage("FINAL number of stuff bits in variant: %d", stuff_bits_in_variant);
-
-        variant_index++;
     }
 
     if (failed_assertions > 0) {
@@ -242,7 +299,7 @@ test::TestResult test::TestBase::FinishTest()
 {
     TestBigMessage("Cleaning up test environemnt...");
     TestControllerAgentEndTest((int)test_result);
-    TestBigMessage("Finishing test execution: ", test_name);
+    TestBigMessage("Finishing test execution: %s", test_name.c_str());
     return (TestResult) test_result;
 }
 
@@ -252,7 +309,7 @@ test::TestResult test::TestBase::FinishTest(TestResult test_result)
     this->test_result = (int) test_result;
     TestBigMessage("Cleaning up test environemnt...");
     TestControllerAgentEndTest((int)test_result);
-    TestBigMessage("Finishing test execution: ", test_name);
+    TestBigMessage("Finishing test execution: %s", test_name.c_str());
     return (TestResult) test_result;
 }
 
@@ -419,6 +476,12 @@ std::unique_ptr<BitFrame> test::TestBase::ConvBitFrame(Frame &golden_frame)
 }
 
 
+std::unique_ptr<BitFrame> test::TestBase::CloneBitFrame(const BitFrame &bit_frame)
+{
+    return std::make_unique<BitFrame>(bit_frame);
+}
+
+
 /**
  * Note that operator overloading was not used on purpose because if operator is
  * overloaded it is non-member function of class. When this is linked with GHDL
@@ -462,14 +525,14 @@ BitKind test::TestBase::GetRandomBitType(FrameKind frame_type, IdentKind ident_t
     case BitField::Arbit:
         if (ident_type == IdentKind::Base)
         {
-            if (rand() % 2)
+            if (Rand() % 2)
                 return BitKind::BaseIdent;
             if (frame_type == FrameKind::Can20)
                 return BitKind::Rtr;
             return BitKind::R1;
 
         } else {
-            switch (rand() % 5)
+            switch (Rand() % 5)
             {
             case 0:
                 return BitKind::BaseIdent;
@@ -490,7 +553,7 @@ BitKind test::TestBase::GetRandomBitType(FrameKind frame_type, IdentKind ident_t
     case BitField::Control:
         if (frame_type == FrameKind::Can20)
         {
-            switch (rand() % 3)
+            switch (Rand() % 3)
             {
             case 0:
                 if (ident_type == IdentKind::Base)
@@ -503,7 +566,7 @@ BitKind test::TestBase::GetRandomBitType(FrameKind frame_type, IdentKind ident_t
             }
 
         } else {
-            switch (rand() % 5)
+            switch (Rand() % 5)
             {
             case 0:
                 return BitKind::Edl;
@@ -524,7 +587,7 @@ BitKind test::TestBase::GetRandomBitType(FrameKind frame_type, IdentKind ident_t
     case BitField::Crc:
         if (frame_type == FrameKind::CanFd)
         {
-            switch (rand() % 3)
+            switch (Rand() % 3)
             {
             case 0:
                 return BitKind::StuffCnt;
@@ -538,7 +601,7 @@ BitKind test::TestBase::GetRandomBitType(FrameKind frame_type, IdentKind ident_t
         }
 
     case BitField::Ack:
-        if (rand() % 2)
+        if (Rand() % 2)
             return BitKind::CrcDelim;
         return BitKind::AckDelim;
 
@@ -620,9 +683,23 @@ void test::TestBase::ReconfDutBitTiming()
 void test::TestBase::PushFramesToLT(can::BitFrame &driver_bit_frame,
                                                  can::BitFrame &monitor_bit_frame)
 {
-    TestSequence *test_sequence;
+    TestSequence test_sequence(this->dut_clk_period, driver_bit_frame, monitor_bit_frame);
+    PushSequenceToLT(test_sequence);
+}
+
+
+void test::TestBase::PushSequenceToLT(TestSequence &test_sequence)
+{
+    n_pushed_sequences++;
 
-    test_sequence = new TestSequence(this->dut_clk_period, driver_bit_frame, monitor_bit_frame);
+    const char *sequence_dir = std::getenv("COMPLIANCE_SEQUENCE_DIR");
+    if (sequence_dir != nullptr)
+    {
+        std::string path = std::string(sequence_dir) + "/" + test_name + "_" +
+                           std::to_string(n_pushed_sequences) + ".seq";
+        if (!SequenceFile::Write(path, test_sequence))
+            TestMessage("Failed to archive sequence to: %s", path.c_str());
+    }
 
 #ifndef NDEBUG
     TestMessage(std::string(80, '*').c_str());
@@ -630,18 +707,18 @@ void test::TestBase::PushFramesToLT(can::BitFrame &driver_bit_frame,
     TestMessage(std::string(80, '*').c_str());
 
     TestMessage("Driven sequence:");
-    test_sequence->Print(true);
+    test_sequence.Print(true);
 
     TestMessage("Monitored sequence:");
-    test_sequence->Print(false);
+    test_sequence.Print(false);
+
+    test_sequence.PrintStats();
 
     TestMessage(std::string(80, '*').c_str());
 #endif
 
-    test_sequence->PushDriverValuesToSimulator();
-    test_sequence->PushMonitorValuesToSimulator();
-
-    delete test_sequence;
+    test_sequence.PushDriverValuesToSimulator();
+    test_sequence.PushMonitorValuesToSimulator();
 }
 
 
@@ -652,6 +729,22 @@ int test::TestBase::RunElemTest([[maybe_unused]] const ElemTest &elem_test,
 }
 
 
+bool test::TestBase::PrepareElemTest([[maybe_unused]] const ElemTest &elem_test,
+                                     [[maybe_unused]] const TestVariant &test_variant,
+                                     [[maybe_unused]] PreparedElemTest &prepared)
+{
+    return false;
+}
+
+
+int test::TestBase::ExecuteElemTest([[maybe_unused]] const ElemTest &elem_test,
+                                    [[maybe_unused]] const TestVariant &test_variant,
+                                    [[maybe_unused]] PreparedElemTest &prepared)
+{
+    return 0;
+}
+
+
 void test::TestBase::RunLT(bool start_driver, bool start_monitor)
 {
 
@@ -708,17 +801,17 @@ void test::TestBase::PrintTestInfo()
 {
     TestMessage(std::string(80, '*').c_str());
     TestMessage("Test Name: %s", test_name.c_str());
-    TestMessage("Number of variants: %d", test_variants.size());
+    TestMessage("Number of variants: %zu", test_variants.size());
     size_t num_elem_tests = 0;
     for (const auto &variant_tests : elem_tests)
         num_elem_tests += variant_tests.size();
-    TestMessage("Total number of elementary tests: %d", num_elem_tests);
+    TestMessage("Total number of elementary tests: %zu", num_elem_tests);
 }
 
 void test::TestBase::PrintElemTestInfo(ElemTest elem_test)
 {
     TestMessage(std::string(80, '*').c_str());
-    TestMessage("Elementary Test index: %d", elem_test.index_);
+    TestMessage("Elementary Test index: %zu", elem_test.index_);
     //TestMessage("Elementary Test message: %s", elem_test.msg.c_str());
     TestMessage(std::string(80, '*').c_str());
 }
@@ -763,6 +856,29 @@ void test::TestBase::FreeTestObjects()
 }
 
 
+unsigned int test::TestBase::GetElemTestSeed(size_t variant_index,
+                                             const ElemTest &elem_test) const
+{
+    uint32_t elem_seed = static_cast<uint32_t>(seed);
+    elem_seed = elem_seed * 65599u + static_cast<uint32_t>(variant_index);
+    elem_seed = elem_seed * 65599u + static_cast<uint32_t>(elem_test.index_);
+    return elem_seed;
+}
+
+
+std::unique_ptr<test::PreparedElemTest> test::TestBase::PrepareSeededElemTest(
+    size_t variant_index, const ElemTest &elem_test)
+{
+    auto prepared = std::make_unique<PreparedElemTest>();
+
+    SeedRand(GetElemTestSeed(variant_index, elem_test));
+    if (!PrepareElemTest(elem_test, test_variants[variant_index], *prepared))
+        return nullptr;
+
+    return prepared;
+}
+
+
 size_t test::TestBase::CalcNumSPs(bool nominal)
 {
     size_t tmp;
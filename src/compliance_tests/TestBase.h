@@ -30,6 +30,7 @@
 
 #include <chrono>
 #include <list>
+#include <memory>
 #include <vector>
 
 #include <can_lib.h>
@@ -37,6 +38,23 @@
 
 #define TEST_ASSERT(cond, msg) TestAssertFnc(cond, msg, __FILE__, __LINE__);
 
+/**
+ * @namespace test
+ * @struct PreparedElemTest
+ * @brief Objects of elementary test built ahead of its execution.
+ *
+ * Filled by TestBase::PrepareElemTest, consumed by TestBase::ExecuteElemTest.
+ */
+struct test::PreparedElemTest
+{
+    std::unique_ptr<can::Frame> gold_frm;
+    std::unique_ptr<can::BitFrame> drv_bit_frm;
+    std::unique_ptr<can::BitFrame> mon_bit_frm;
+
+    /* Sequence compiled from driven and monitored frames */
+    std::unique_ptr<TestSequence> test_sequence;
+};
+
 /**
  * @namespace test
  * @class TestBase
@@ -76,7 +94,7 @@ class test::TestBase
         /**
          * Clock period to be set in TB.
          */
-        std::chrono::nanoseconds dut_clk_period;
+        PliFemtoseconds dut_clk_period;
 
         /**
          * Input delay of DUT. Corresponds to time it takes to signal from can_rx
@@ -158,6 +176,13 @@ class test::TestBase
          */
         int stuff_bits_in_variant = 0;
 
+        /**
+         * Number of sequences pushed to lower tester. When "COMPLIANCE_SEQUENCE_DIR"
+         * environment variable is set, each pushed sequence is archived to
+         * "<dir>/<test_name>_<n>.seq" file (see SequenceFile).
+         */
+        size_t n_pushed_sequences = 0;
+
         /**
          * Error data byte. Used in tests where error frame shall be invoked. Contains
          * 0x80 and test shall corrupt its 7 data bit (should be recessive stuff bit).
@@ -237,6 +262,31 @@ class test::TestBase
          */
         virtual int RunElemTest(const ElemTest &elem_test, const TestVariant &test_variant);
 
+        /**
+         * Prepare stage of elementary test. Builds frames and compiles test sequence
+         * into 'prepared'. Tests which implement it shall implement 'ExecuteElemTest'
+         * instead of 'RunElemTest'.
+         *
+         * Preparation of next elementary test runs on worker thread while current
+         * elementary test executes. Therefore it must not access simulator (nor DUT,
+         * nor print), and must not modify members of the test. Random numbers shall
+         * be consumed only here (via can::Rand, generator of worker thread is seeded
+         * by seed of elementary test), not in 'ExecuteElemTest'.
+         *
+         * @returns true if elementary test was prepared, false if test does not split
+         *          elementary tests (default). Then 'RunElemTest' is called (also for
+         *          single elementary test which was not prepared).
+         */
+        virtual bool PrepareElemTest(const ElemTest &elem_test, const TestVariant &test_variant,
+                                     PreparedElemTest &prepared);
+
+        /**
+         * Execute stage of elementary test. Pushes prepared sequence to lower tester,
+         * runs it and checks results.
+         */
+        virtual int ExecuteElemTest(const ElemTest &elem_test, const TestVariant &test_variant,
+                                    PreparedElemTest &prepared);
+
         /**
          *
          */
@@ -291,6 +341,12 @@ class test::TestBase
          */
         std::unique_ptr<BitFrame> ConvBitFrame(Frame &golden_frame);
 
+        /**
+         * Creates copy of bit sequence of CAN frame. Cheaper than converting the same
+         * frame again (e.g. to get monitored frame from driven frame).
+         */
+        std::unique_ptr<BitFrame> CloneBitFrame(const BitFrame &bit_frame);
+
         /**
          * Compares two frames.
          * @returns true if frames are equal, false otherwise
@@ -351,6 +407,11 @@ class test::TestBase
          */
         void PushFramesToLT(can::BitFrame &drv_frame, can::BitFrame &mon_frame);
 
+        /**
+         * Pushes already compiled test sequence to lower tester.
+         */
+        void PushSequenceToLT(TestSequence &test_sequence);
+
         /**
          * Starts driver and/or monitor and waits till they are finished.
          * @param start_driver driver shall be started and waited on
@@ -410,6 +471,20 @@ class test::TestBase
         void FreeTestObjects();
 
     private:
+        /**
+         * @returns Seed of elementary test. Derived from seed from TB, so that each
+         *          elementary test gets the same random numbers regardless of other
+         *          elementary tests.
+         */
+        unsigned int GetElemTestSeed(size_t variant_index, const ElemTest &elem_test) const;
+
+        /**
+         * Seeds random generator for elementary test and calls 'PrepareElemTest'.
+         * @returns Prepared elementary test, nullptr if test does not prepare it.
+         */
+        std::unique_ptr<PreparedElemTest> PrepareSeededElemTest(size_t variant_index,
+                                                                const ElemTest &elem_test);
+
         /**
          * Calculates number of possible sample points per bit-rate.
          * @note CTU CAN FDs limit of min(TSEG1) = 3 clock cycles is taken into account.
@@ -113,8 +113,9 @@ class TestIso_7_1_2 : public test::TestBase
             CanAgentConfigureTxToRxFeedback(true);
         }
 
-        int RunElemTest([[maybe_unused]] const ElemTest &elem_test,
-                        [[maybe_unused]] const TestVariant &test_variant)
+        bool PrepareElemTest([[maybe_unused]] const ElemTest &elem_test,
+                             [[maybe_unused]] const TestVariant &test_variant,
+                             PreparedElemTest &prepared)
         {
             int can_id;
             switch (elem_test.index_)
@@ -132,7 +133,7 @@ class TestIso_7_1_2 : public test::TestBase
                     can_id = 0x1FFFFFFF;
                     break;
                 case 5:
-                    can_id = rand() % CAN_EXTENDED_ID_MAX;
+                    can_id = Rand() % CAN_EXTENDED_ID_MAX;
                     break;
                 default:
                     can_id = 0x0;
@@ -141,32 +142,42 @@ class TestIso_7_1_2 : public test::TestBase
 
             uint8_t dlc = static_cast<uint8_t>((elem_test.index_ - 1) / 5);
 
-            frm_flags = std::make_unique<FrameFlags>(elem_test.frame_kind_,
-                            IdentKind::Ext, RtrFlag::Data);
-            gold_frm = std::make_unique<Frame>(*frm_flags, dlc, can_id);
-            RandomizeAndPrint(gold_frm.get());
+            FrameFlags frm_flags(elem_test.frame_kind_, IdentKind::Ext, RtrFlag::Data);
+            prepared.gold_frm = std::make_unique<Frame>(frm_flags, dlc, can_id);
+            prepared.gold_frm->Randomize();
 
-            drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            prepared.drv_bit_frm = ConvBitFrame(*prepared.gold_frm);
+            prepared.mon_bit_frm = CloneBitFrame(*prepared.drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
              *   1. Turn monitored frame as if received.
              *************************************************************************************/
-            mon_bit_frm->ConvRXFrame();
+            prepared.mon_bit_frm->ConvRXFrame();
 
-            drv_bit_frm->Print(true);
-            mon_bit_frm->Print(true);
+            prepared.test_sequence = std::make_unique<TestSequence>(dut_clk_period,
+                                        *prepared.drv_bit_frm, *prepared.mon_bit_frm);
+            return true;
+        }
+
+        int ExecuteElemTest([[maybe_unused]] const ElemTest &elem_test,
+                            [[maybe_unused]] const TestVariant &test_variant,
+                            PreparedElemTest &prepared)
+        {
+            TestMessage("Test frame:");
+            prepared.gold_frm->Print();
+
+            prepared.drv_bit_frm->Print(true);
+            prepared.mon_bit_frm->Print(true);
 
             /**************************************************************************************
              * Execute test
              *************************************************************************************/
-            PushFramesToLT(*drv_bit_frm, *mon_bit_frm);
+            PushSequenceToLT(*prepared.test_sequence);
             RunLT(true, true);
             CheckLTResult();
-            CheckRxFrame(*gold_frm);
+            CheckRxFrame(*prepared.gold_frm);
 
-            FreeTestObjects();
             return FinishElemTest();
         }
 
@@ -144,20 +144,20 @@ class TestIso_7_1_3 : public test::TestBase
                     lt_id_type = IdentKind::Base;
                     iut_id_type = IdentKind::Base;
                     iut_rtr_flag = RtrFlag::Rtr;
-                    lt_id = rand() % CAN_BASE_ID_MAX;
+                    lt_id = Rand() % CAN_BASE_ID_MAX;
                     iut_id = lt_id;
                     break;
                 case 2:
                     lt_id_type = IdentKind::Base;
                     iut_id_type = IdentKind::Ext;
-                    lt_id = rand() % CAN_BASE_ID_MAX;
+                    lt_id = Rand() % CAN_BASE_ID_MAX;
                     iut_id = (lt_id << 18);
                     break;
                 case 3:
                     lt_id_type = IdentKind::Base;
                     iut_id_type = IdentKind::Ext;
                     lt_rtr_flag = RtrFlag::Rtr;
-                    lt_id = rand() % CAN_BASE_ID_MAX;
+                    lt_id = Rand() % CAN_BASE_ID_MAX;
                     iut_id = (lt_id << 18);
                     break;
                 case 4:
@@ -176,7 +176,7 @@ class TestIso_7_1_3 : public test::TestBase
                     lt_id_type = IdentKind::Ext;
                     iut_id_type = IdentKind::Ext;
                     iut_rtr_flag = RtrFlag::Rtr;
-                    lt_id = rand() % CAN_EXTENDED_ID_MAX;
+                    lt_id = Rand() % CAN_EXTENDED_ID_MAX;
                     iut_id = lt_id;
                     break;
                 default:
@@ -200,7 +200,7 @@ class TestIso_7_1_3 : public test::TestBase
                     iut_frame_type = FrameKind::Can20;
                     lt_id_type = IdentKind::Base;
                     iut_id_type = IdentKind::Base;
-                    lt_id = rand() % CAN_BASE_ID_MAX;
+                    lt_id = Rand() % CAN_BASE_ID_MAX;
                     iut_id = lt_id;
                     iut_rtr_flag = RtrFlag::Rtr;
                     break;
@@ -218,7 +218,7 @@ class TestIso_7_1_3 : public test::TestBase
                     lt_id_type = IdentKind::Ext;
                     iut_id_type = IdentKind::Ext;
                     iut_rtr_flag = RtrFlag::Rtr;
-                    lt_id = rand() % CAN_EXTENDED_ID_MAX;
+                    lt_id = Rand() % CAN_EXTENDED_ID_MAX;
                     iut_id = lt_id;
                     break;
                 default:
@@ -242,7 +242,7 @@ class TestIso_7_1_3 : public test::TestBase
 
             /* Driven/monitored is derived from LTs frame since this one wins over IUTs frame! */
             drv_bit_frm = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -328,7 +328,7 @@ class TestIso_7_1_3 : public test::TestBase
             bit_to_loose_arb->GetLastTQIter(BitPhase::Ph2)->Lengthen(dut_input_delay);
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
             drv_bit_frm_2->ConvRXFrame();
 
             drv_bit_frm->AppendBitFrame(drv_bit_frm_2.get());
@@ -97,7 +97,7 @@ class TestIso_7_1_4 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -101,7 +101,7 @@ class TestIso_7_1_7 : public test::TestBase
             RandomizeAndPrint(gold_frm_2.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -162,7 +162,7 @@ class TestIso_7_1_7 : public test::TestBase
             }
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
             mon_bit_frm_2->ConvRXFrame();
             if (elem_test.index_ == 3)
                 mon_bit_frm_2->GetBitOf(0, BitKind::Ack)->val_ = BitVal::Recessive;
@@ -172,7 +172,7 @@ class TestIso_7_1_7 : public test::TestBase
             if (elem_test.index_ == 3)
             {
                 drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-                mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+                mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
                 mon_bit_frm_2->ConvRXFrame();
                 drv_bit_frm->AppendBitFrame(drv_bit_frm_2.get());
                 mon_bit_frm->AppendBitFrame(mon_bit_frm_2.get());
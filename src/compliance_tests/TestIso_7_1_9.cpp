@@ -95,9 +95,9 @@ class TestIso_7_1_9 : public test::TestBase
             RandomizeAndPrint(gold_frm_2.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
             drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -157,7 +157,7 @@ class TestIso_7_2_5 : public test::TestBase
         int RunElemTest([[maybe_unused]] const ElemTest &elem_test,
                         [[maybe_unused]] const TestVariant &test_variant)
         {
-            int id = rand() % CAN_BASE_ID_MAX;
+            int id = Rand() % CAN_BASE_ID_MAX;
             uint8_t dlc = 0x0;
 
             if (test_variant == TestVariant::Common) {
@@ -166,11 +166,11 @@ class TestIso_7_2_5 : public test::TestBase
                 }
             } else if (test_variant == TestVariant::CanFdEna) {
                 if (elem_test.index_ == 1 || elem_test.index_ == 3) {
-                    dlc = static_cast<uint8_t>((rand() % 11)); // To cause CRC 17
+                    dlc = static_cast<uint8_t>((Rand() % 11)); // To cause CRC 17
                 } else if (elem_test.index_ == 2 || elem_test.index_ == 4) {
-                    dlc = static_cast<uint8_t>(rand() % 5 + 11); // To cause CRC 21
+                    dlc = static_cast<uint8_t>(Rand() % 5 + 11); // To cause CRC 21
                 } else {
-                    dlc = static_cast<uint8_t>(rand() % 15);
+                    dlc = static_cast<uint8_t>(Rand() % 15);
                 }
             }
 
@@ -179,7 +179,7 @@ class TestIso_7_2_5 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -91,17 +91,17 @@ class TestIso_7_2_6: public test::TestBase
             uint8_t dlc;
             if (test_variant == TestVariant::Common)
             {
-                dlc = static_cast<uint8_t>(rand() % 9);
+                dlc = static_cast<uint8_t>(Rand() % 9);
             }
             else if (elem_test.index_ == 1)
             {
-                if (rand() % 2)
+                if (Rand() % 2)
                     dlc = 0x9;
                 else
                     dlc = 0xA;
             } else
             {
-                dlc = static_cast<uint8_t>((rand() % 5) + 11);
+                dlc = static_cast<uint8_t>((Rand() % 5) + 11);
             }
 
             frm_flags = std::make_unique<FrameFlags>(elem_test.frame_kind_);
@@ -109,7 +109,7 @@ class TestIso_7_2_6: public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -90,9 +90,9 @@ class TestIso_7_2_8 : public test::TestBase
 
             /* Tests 1,3 -> DLC < 10. Tests 2,4 -> DLC > 10 */
             if (elem_test.index_ % 2 == 0)
-                dlc = static_cast<uint8_t>((rand() % 5) + 0xA);
+                dlc = static_cast<uint8_t>((Rand() % 5) + 0xA);
             else
-                dlc = static_cast<uint8_t>(rand() % 10);
+                dlc = static_cast<uint8_t>(Rand() % 10);
 
             if (elem_test.index_ < 3)
                 bit_value = BitVal::Recessive;
@@ -104,7 +104,7 @@ class TestIso_7_2_8 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -90,7 +90,7 @@ class TestIso_7_3_1 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             size_t prolonged_by = (3 * (elem_test.index_ - 1)) + 1;
             TestMessage("Prolonging Active Error flag by: %zu", prolonged_by);
@@ -87,7 +87,7 @@ class TestIso_7_3_2 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -116,7 +116,7 @@ class TestIso_7_3_2 : public test::TestBase
             RandomizeAndPrint(gold_frm_2.get());
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             mon_bit_frm_2->ConvRXFrame();
             drv_bit_frm_2->GetBitOf(0, BitKind::Ack)->val_ = BitVal::Dominant;
@@ -91,7 +91,7 @@ class TestIso_7_3_3 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -110,7 +110,7 @@ class TestIso_7_3_3 : public test::TestBase
             else
                 bit_to_corrupt = 6;
 
-            TestMessage("Forcing Error flag bit %d to recessive", bit_to_corrupt);
+            TestMessage("Forcing Error flag bit %zu to recessive", bit_to_corrupt);
 
             mon_bit_frm->ConvRXFrame();
 
@@ -90,9 +90,9 @@ class TestIso_7_4_1 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
-            TestMessage("Forcing bit %d of Intermission to dominant", elem_test.index_);
+            TestMessage("Forcing bit %zu of Intermission to dominant", elem_test.index_);
 
             /**************************************************************************************
              * Modify test frames:
@@ -84,7 +84,7 @@ class TestIso_7_4_2 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             TestMessage("Forcing last bit of EOF to dominant!");
 
@@ -100,10 +100,10 @@ class TestIso_7_5_1 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -85,7 +85,7 @@ class TestIso_7_5_3 : public test::TestBase
                 AddElemTest(TestVariant::CanFdEna, ElemTest(i + 1, FrameKind::CanFd));
             }
 
-            dut_ifc->SetTec((rand() % 110) + 128);
+            dut_ifc->SetTec((Rand() % 110) + 128);
         }
 
         int RunElemTest([[maybe_unused]] const ElemTest &elem_test,
@@ -97,10 +97,10 @@ class TestIso_7_5_3 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
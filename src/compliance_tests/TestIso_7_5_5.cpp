@@ -87,7 +87,7 @@ class TestIso_7_5_5 : public test::TestBase
                 AddElemTest(TestVariant::CanFdEna, ElemTest(i + 1, FrameKind::CanFd));
             }
 
-            dut_ifc->SetTec((rand() % 110) + 128);
+            dut_ifc->SetTec((Rand() % 110) + 128);
         }
 
         int RunElemTest([[maybe_unused]] const ElemTest &elem_test,
@@ -99,7 +99,7 @@ class TestIso_7_5_5 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
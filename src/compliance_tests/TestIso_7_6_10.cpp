@@ -108,15 +108,15 @@ class TestIso_7_6_10 : public test::TestBase
             } else {
                 uint8_t dlc;
                 if (elem_test.index_ == 1)
-                    dlc = static_cast<uint8_t>(rand() % 0xB);
+                    dlc = static_cast<uint8_t>(Rand() % 0xB);
                 else
-                    dlc = static_cast<uint8_t>((rand() % 0x4) + 0xB);
+                    dlc = static_cast<uint8_t>((Rand() % 0x4) + 0xB);
                 gold_frm = std::make_unique<Frame>(*frm_flags, dlc);
             }
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -133,7 +133,7 @@ class TestIso_7_6_10 : public test::TestBase
             Bit *crc_bit;
 
             do {
-                crc_bit_index = static_cast<size_t>(rand()) % drv_bit_frm->GetFieldLen(BitKind::Crc);
+                crc_bit_index = static_cast<size_t>(Rand()) % drv_bit_frm->GetFieldLen(BitKind::Crc);
                 crc_bit = drv_bit_frm->GetBitOf(crc_bit_index, BitKind::Crc);
                 crc_overall_index = drv_bit_frm->GetBitIndex(crc_bit);
             } while (crc_bit->stuff_kind_ != StuffKind::NoStuff);
@@ -170,7 +170,7 @@ class TestIso_7_6_23 : public test::TestBase
             RandomizeAndPrint(gold_frm_2.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**********************************************************************************
              * Modify test frames:
@@ -199,7 +199,7 @@ class TestIso_7_6_23 : public test::TestBase
             mon_bit_frm->GetBitOf(0, BitKind::Ack)->val_ = BitVal::Recessive;
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
             mon_bit_frm_2->ConvRXFrame();
 
             drv_bit_frm->AppendBitFrame(drv_bit_frm_2.get());
@@ -103,7 +103,7 @@ class TestIso_7_6_9 : public test::TestBase
 
         BitKind get_rand_arbitration_field()
         {
-            switch (rand() % 5)
+            switch (Rand() % 5)
             {
             case 0:
                 return BitKind::BaseIdent;
@@ -123,7 +123,7 @@ class TestIso_7_6_9 : public test::TestBase
 
         BitKind get_rand_control_field()
         {
-            switch (rand() % 5)
+            switch (Rand() % 5)
             {
             case 0:
                 return BitKind::R0;
@@ -234,8 +234,8 @@ class TestIso_7_6_9 : public test::TestBase
              * If not succefull, then generate the frame again.
              */
             size_t num_stuff_bits = 0;
-            TestMessage("Searching for: %d\n", field);
-            TestMessage("Value: %d\n", value);
+            TestMessage("Searching for: %d\n", static_cast<int>(field));
+            TestMessage("Value: %d\n", static_cast<int>(value));
 
             while (num_stuff_bits == 0){
                 TestMessage("Generating frame...\n");
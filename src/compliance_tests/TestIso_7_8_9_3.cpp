@@ -99,7 +99,7 @@ class TestIso_7_8_9_3 : public test::TestBase
             gold_frm->Print();
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
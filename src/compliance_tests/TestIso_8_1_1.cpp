@@ -134,7 +134,7 @@ class TestIso_8_1_1 : public test::TestBase
                     id = 0x7FF;
                     break;
                 case 4:
-                    id = rand() % CAN_BASE_ID_MAX;
+                    id = Rand() % CAN_BASE_ID_MAX;
                     break;
                 default:
                     break;
@@ -146,7 +146,7 @@ class TestIso_8_1_1 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -291,7 +291,7 @@ class TestIso_8_1_6 : public test::TestBase
                 };
 
                 uint8_t dlcs[10] = {
-                    0xE, 0x8, 0xE, 0xF, 0xF, 0x3, 0x3, 0x1, 0x0, (uint8_t)(rand() % 0xF)
+                    0xE, 0x8, 0xE, 0xF, 0xF, 0x3, 0x3, 0x1, 0x0, (uint8_t)(Rand() % 0xF)
                 };
                 gold_frm = std::make_unique<Frame>(*frm_flags, dlcs[elem_test.index_ - 1],
                                     ids[elem_test.index_ - 1], data[elem_test.index_ - 1]);
@@ -301,7 +301,7 @@ class TestIso_8_1_6 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -114,7 +114,7 @@ class TestIso_8_1_8 : public test::TestBase
             mon_bit_frm = ConvBitFrame(*gold_frm);
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -193,7 +193,7 @@ class TestIso_8_2_1 : public test::TestBase
             /* Choose dlc based on elementary test */
             uint8_t dlc;
             if (elem_test.index_ < 14) {
-                dlc = static_cast<uint8_t>((rand() % 7) + 1); /* To make sure at least 1! */
+                dlc = static_cast<uint8_t>((Rand() % 7) + 1); /* To make sure at least 1! */
             } else {
                 /* Distribute DLC so that following elementary tests get CRC17 */
                 if (elem_test.index_ == 14 || elem_test.index_ == 15 ||
@@ -209,11 +209,11 @@ class TestIso_8_2_1 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /* Second frame the same due to retransmission. */
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -231,7 +231,7 @@ class TestIso_8_2_1 : public test::TestBase
 
             /* Search for bit of matching value! */
             size_t length = drv_bit_frm->GetFieldLen(bit_type);
-            size_t index_in_bitfield = static_cast<size_t>(rand()) % length;
+            size_t index_in_bitfield = static_cast<size_t>(Rand()) % length;
             Bit *bit_to_corrupt = drv_bit_frm->GetBitOf(index_in_bitfield, bit_type);
 
             /* In following elementary tests we aim for fixed stuff bit of this value!
@@ -248,7 +248,7 @@ class TestIso_8_2_1 : public test::TestBase
                     bit_type = GetRandomBitType(elem_test.frame_kind_, IdentKind::Base,
                                                 bit_field_to_corrupt);
                     length = drv_bit_frm->GetFieldLen(bit_type);
-                    index_in_bitfield = rand() % length;
+                    index_in_bitfield = Rand() % length;
                     bit_to_corrupt = drv_bit_frm->GetBitOf(index_in_bitfield, bit_type);
                     attempt_cnt++;
 
@@ -269,7 +269,7 @@ class TestIso_8_2_1 : public test::TestBase
                     bit_type = GetRandomBitType(elem_test.frame_kind_, IdentKind::Base,
                                                 bit_field_to_corrupt);
                     length = drv_bit_frm->GetFieldLen(bit_type);
-                    index_in_bitfield = rand() % length;
+                    index_in_bitfield = Rand() % length;
                     bit_to_corrupt = drv_bit_frm->GetBitOf(index_in_bitfield, bit_type);
                 }
             }
@@ -116,7 +116,7 @@ class TestIso_8_2_5 : public test::TestBase
             case 3:
             case 4:
             case 5:
-                dlc = static_cast<uint8_t>(rand() % 9);
+                dlc = static_cast<uint8_t>(Rand() % 9);
                 break;
             case 6:
             case 7:
@@ -143,11 +143,11 @@ class TestIso_8_2_5 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /* Second frame the same due to retransmission. */
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -108,13 +108,13 @@ class TestIso_8_5_1 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             gold_frm_2 = std::make_unique<Frame>(*frm_flags, 1, &data_byte);
             RandomizeAndPrint(gold_frm_2.get());
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -167,7 +167,7 @@ class TestIso_8_5_1 : public test::TestBase
                 ->GetLastTQIter(BitPhase::Sync)->Lengthen(dut_input_delay);
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
             drv_bit_frm_2->ConvRXFrame();
 
             drv_bit_frm->AppendBitFrame(drv_bit_frm_2.get());
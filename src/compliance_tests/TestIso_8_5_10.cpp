@@ -115,7 +115,7 @@ class TestIso_8_5_10 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /* Second frame */
             frm_flags_2 = std::make_unique<FrameFlags>(elem_test.frame_kind_,
@@ -125,7 +125,7 @@ class TestIso_8_5_10 : public test::TestBase
 
             /* At first, frm_2 holds the same retransmitted frame! */
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -264,7 +264,7 @@ class TestIso_8_5_10 : public test::TestBase
 
             /* Append as if third frame which DUT shall not ACK (its bux off) */
             drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             mon_bit_frm_2->ConvRXFrame();
             mon_bit_frm_2->GetBitOf(0, BitKind::Ack)->val_ = BitVal::Recessive;
@@ -105,7 +105,7 @@ class TestIso_8_5_11 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             // In FD enabled variant, the retransmitted frame will be in error active
             // state, so ESI must be different! Other frame flags MUST be the same,
@@ -118,7 +118,7 @@ class TestIso_8_5_11 : public test::TestBase
                 gold_frm->frm_flags_ = *frm_flags_2;
             }
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
 
             /**************************************************************************************
@@ -106,13 +106,13 @@ class TestIso_8_5_3 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             gold_frm_2 = std::make_unique<Frame>(*frm_flags);
             RandomizeAndPrint(gold_frm_2.get());
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -175,7 +175,7 @@ class TestIso_8_5_3 : public test::TestBase
 
             /* Append the original frame, retransmitted by DUT after 2nd frame! */
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
             drv_bit_frm_2->ConvRXFrame();
             drv_bit_frm->AppendBitFrame(drv_bit_frm_2.get());
             mon_bit_frm->AppendBitFrame(mon_bit_frm_2.get());
@@ -95,7 +95,7 @@ class TestIso_8_5_7 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /* ESI needed for CAN FD variant */
             frm_flags_2 = std::make_unique<FrameFlags>(elem_test.frame_kind_, EsiFlag::ErrPas);
@@ -103,7 +103,7 @@ class TestIso_8_5_7 : public test::TestBase
             RandomizeAndPrint(gold_frm_2.get());
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -107,7 +107,7 @@ class TestIso_8_5_8 : public test::TestBase
 
             /* This is retransmitted frame by IUT */
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
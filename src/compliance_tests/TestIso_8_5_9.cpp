@@ -105,7 +105,7 @@ class TestIso_8_5_9 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /* Second frame */
             frm_flags_2 = std::make_unique<FrameFlags>(elem_test.frame_kind_);
@@ -113,7 +113,7 @@ class TestIso_8_5_9 : public test::TestBase
             RandomizeAndPrint(gold_frm_2.get());
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -173,7 +173,7 @@ class TestIso_8_5_9 : public test::TestBase
 
             /* Append third one */
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
             drv_bit_frm_2->ConvRXFrame();
             drv_bit_frm->AppendBitFrame(drv_bit_frm_2.get());
             mon_bit_frm->AppendBitFrame(mon_bit_frm_2.get());
@@ -79,7 +79,7 @@ class TestIso_8_6_11 : public test::TestBase
             SetupMonitorTxTests();
             CanAgentConfigureTxToRxFeedback(true);
 
-            dut_ifc->SetTec((rand() % 126) + 2);
+            dut_ifc->SetTec((Rand() % 126) + 2);
         }
 
         int RunElemTest([[maybe_unused]] const ElemTest &elem_test,
@@ -90,7 +90,7 @@ class TestIso_8_6_11 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
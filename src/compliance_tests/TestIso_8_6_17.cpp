@@ -81,7 +81,7 @@ class TestIso_8_6_17 : public test::TestBase
             SetupMonitorTxTests();
             CanAgentConfigureTxToRxFeedback(true);
 
-            dut_ifc->SetTec((rand() % 125) + 130);
+            dut_ifc->SetTec((Rand() % 125) + 130);
         }
 
         int RunElemTest([[maybe_unused]] const ElemTest &elem_test,
@@ -92,10 +92,10 @@ class TestIso_8_6_17 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
@@ -121,13 +121,13 @@ class TestIso_8_6_6 : public test::TestBase
                 {
                     /* To achieve CRC17 or CRC21 in elem tests 7-10 of Can FD Enabled variant */
                     if (elem_test.index_ == 7 || elem_test.index_ == 8)
-                        dlc = static_cast<uint8_t>((rand() % 0xA) + 1);
+                        dlc = static_cast<uint8_t>((Rand() % 0xA) + 1);
                     else if (elem_test.index_ == 9 || elem_test.index_ == 10)
-                        dlc = static_cast<uint8_t>((rand() % 5) + 0xB);
+                        dlc = static_cast<uint8_t>((Rand() % 5) + 0xB);
                     else
-                        dlc = static_cast<uint8_t>(rand() % 0xF);
+                        dlc = static_cast<uint8_t>(Rand() % 0xF);
                     } else {
-                        dlc = static_cast<uint8_t>(rand() % 8 + 1);
+                        dlc = static_cast<uint8_t>(Rand() % 8 + 1);
                     }
                     gold_frm = std::make_unique<Frame>(*frm_flags, dlc);
                     RandomizeAndPrint(gold_frm.get());
@@ -142,10 +142,10 @@ class TestIso_8_6_6 : public test::TestBase
                      gold_frm->data(0) == 0xFF);
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
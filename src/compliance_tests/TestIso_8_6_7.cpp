@@ -109,9 +109,9 @@ class TestIso_8_6_7 : public test::TestBase
         {
             uint8_t dlc;
             if (elem_test.index_ < 7)
-                dlc = static_cast<uint8_t>(rand() % 0x9);
+                dlc = static_cast<uint8_t>(Rand() % 0x9);
             else
-                dlc = static_cast<uint8_t>((rand() % 0x4) + 11);
+                dlc = static_cast<uint8_t>((Rand() % 0x4) + 11);
 
             frm_flags = std::make_unique<FrameFlags>(elem_test.frame_kind_,
                             //IdentifierType::Base, RtrFlag::DataFrame, BrsFlag::DontShift,
@@ -119,10 +119,10 @@ class TestIso_8_6_7 : public test::TestBase
             gold_frm = std::make_unique<Frame>(*frm_flags, dlc);
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
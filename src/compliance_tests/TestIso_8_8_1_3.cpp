@@ -146,11 +146,11 @@ class TestIso_8_8_1_3 : public test::TestBase
             frm_flags = std::make_unique<FrameFlags>(FrameKind::CanFd, BrsFlag::DoShift,
                                                        EsiFlag::ErrAct);
             /* To make sure there is at least 1 data byte! */
-            gold_frm = std::make_unique<Frame>(*frm_flags, rand() % 0xF + 1);
+            gold_frm = std::make_unique<Frame>(*frm_flags, Rand() % 0xF + 1);
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
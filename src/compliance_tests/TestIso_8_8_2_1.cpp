@@ -120,7 +120,7 @@ class TestIso_8_8_2_1 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -141,14 +141,8 @@ class TestIso_8_8_2_1 : public test::TestBase
             drv_bit_frm->GetBit(0)->GetTQ(0)->Lengthen(d);
 
             /* For each cycle of driven PH2 of R0, we search cycle which is "d" cycles back within
-             * whole frame. First "MoveCyclesBack", finds TQ and bit, in which 'orig' cycle is
-             * (redundantly multiple times), then it iterates back through bit until it moved
-             * for d cycles.
-             *
-             * I am aware of performance penalty of the solution, but I decided to live with it as
-             * the penalty is just not so big!
-             * Alternative would be to have also bottom->up reference in Bit/TQ/Cycle hierarchy.
-             * This would allow moving cycle-by-cycle with iterator accross multiple TQs/bits.
+             * whole frame. "MoveCyclesBack" looks up position of 'orig' cycle in time index of
+             * the frame, and returns cycle which is d cycles before.
              */
             Bit *r0 = drv_bit_frm->GetBitOf(0, BitKind::R0);
             for (size_t i = 0; i < r0->GetPhaseLenTQ(BitPhase::Ph2); i++)
@@ -156,9 +150,9 @@ class TestIso_8_8_2_1 : public test::TestBase
                 TimeQuanta *tq = r0->GetTQ(BitPhase::Ph2, i);
                 for (size_t j = 0; j < tq->getLengthCycles(); j++)
                 {
-                    Cycle *orig = tq->getCycleBitValue(j);
-                    Cycle *to = drv_bit_frm->MoveCyclesBack(orig, d);
-                    to->ForceVal(BitVal::Recessive);
+                    Cycle orig = tq->getCycleBitValue(j);
+                    Cycle to = drv_bit_frm->MoveCyclesBack(orig, d);
+                    to.ForceVal(BitVal::Recessive);
                 }
             }
 
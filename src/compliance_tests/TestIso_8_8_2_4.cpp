@@ -136,7 +136,7 @@ class TestIso_8_8_2_4 : public test::TestBase
             RandomizeAndPrint(gold_frm.get());
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             /**************************************************************************************
              * Modify test frames:
@@ -153,8 +153,8 @@ class TestIso_8_8_2_4 : public test::TestBase
                 d *= 2;
             drv_bit_frm->GetBit(0)->GetTQ(0)->Lengthen(d);
 
-            auto bit_it = drv_bit_frm->GetBitOfIter(0, BitKind::CrcDelim);
-            bit_it--;
+            Bit *bit_it = drv_bit_frm->GetBit(
+                drv_bit_frm->GetBitIndex(drv_bit_frm->GetBitOf(0, BitKind::CrcDelim)) - 1);
             BitVal correct_bit_value = bit_it->val_;
             bit_it->FlipVal();
 
@@ -99,18 +99,18 @@ class TestIso_9_6_1 : public test::TestBase
             gold_frm->Print();
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             drv_bit_frm_2 = ConvBitFrame(*gold_frm);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             // Separate frame is needed for CAN FD enabled variant. This frame is already with
             // IUT being Error passive, so we need frame/frame_flags with ESI error passive!
             drv_bit_frm_3 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_3 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_3 = CloneBitFrame(*drv_bit_frm_3);
 
             drv_bit_frm_4 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_4 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_4 = CloneBitFrame(*drv_bit_frm_4);
 
             /**************************************************************************************
              * Modify test frames:
@@ -97,12 +97,12 @@ class TestIso_9_6_2 : public test::TestBase
             gold_frm->Print();
 
             drv_bit_frm = ConvBitFrame(*gold_frm);
-            mon_bit_frm = ConvBitFrame(*gold_frm);
+            mon_bit_frm = CloneBitFrame(*drv_bit_frm);
 
             // Separate frame is needed for CAN FD enabled variant. This frame is already with
             // IUT being Error passive, so we need frame/frame_flags with ESI error passive!
             drv_bit_frm_2 = ConvBitFrame(*gold_frm_2);
-            mon_bit_frm_2 = ConvBitFrame(*gold_frm_2);
+            mon_bit_frm_2 = CloneBitFrame(*drv_bit_frm_2);
 
             /**************************************************************************************
              * Modify test frames:
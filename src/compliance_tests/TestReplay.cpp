@@ -0,0 +1,87 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Replay of archived test sequence.
+ *
+ * Drives and monitors test sequence from sequence file given by
+ * "COMPLIANCE_SEQUENCE_FILE" environment variable (see SequenceFile, files are
+ * archived by tests when "COMPLIANCE_SEQUENCE_DIR" is set). DUT is configured
+ * as in any other test, but actions of the original test on DUT (e.g. frames
+ * which DUT shall transmit, or checks of received frames) are not replayed,
+ * only the CAN agent sequences are.
+ *
+ *****************************************************************************/
+
+#include <cstdlib>
+#include <iostream>
+#include <chrono>
+
+#include "TestBase.h"
+
+using namespace can;
+using namespace test;
+
+class TestReplay : public test::TestBase
+{
+    public:
+
+        void ConfigureTest()
+        {
+            FillTestVariants(VariantMatchType::Common);
+            AddElemTest(TestVariant::Common, ElemTest(1));
+        }
+
+        int RunElemTest([[maybe_unused]] const ElemTest &elem_test,
+                        [[maybe_unused]] const TestVariant &test_variant)
+        {
+            const char *path = std::getenv("COMPLIANCE_SEQUENCE_FILE");
+            SequenceFile sequence_file;
+
+            if (path == nullptr || !sequence_file.Open(path))
+            {
+                TestMessage("Sequence file not given by COMPLIANCE_SEQUENCE_FILE!");
+                test_result = false;
+                return 1;
+            }
+
+            if (sequence_file.GetClockPeriod() != dut_clk_period)
+                TestMessage("Sequence was archived with clock period %lld fs, DUT runs with "
+                            "%lld fs!", static_cast<long long>(sequence_file.GetClockPeriod().count()),
+                            static_cast<long long>(dut_clk_period.count()));
+
+            TestSequence test_sequence(sequence_file.GetClockPeriod());
+            sequence_file.Read(test_sequence);
+            TestMessage("Replaying %s: %zu driver items, %zu monitor items", path,
+                        test_sequence.GetNumDriverItems(), test_sequence.GetNumMonitorItems());
+
+            test_sequence.PushDriverValuesToSimulator();
+            test_sequence.PushMonitorValuesToSimulator();
+            RunLT(true, true);
+            CheckLTResult();
+
+            return FinishElemTest();
+        }
+};
@@ -0,0 +1,365 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *****************************************************************************/
+
+#include <atomic>
+#include <condition_variable>
+#include <csignal>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+
+#include "Log.hpp"
+
+
+/**
+ * Names of categories in "COMPLIANCE_LOG_LEVEL" environment variable.
+ */
+static const char *log_category_names[LOG_CATEGORY_COUNT] = {"pli", "test"};
+
+
+/**
+ * Runtime levels of categories. Default level is taken from environment once.
+ */
+class LogLevels
+{
+    public:
+        LogLevels()
+        {
+            for (auto &level : levels_)
+                level.store(static_cast<int>(LogSeverity::Info));
+
+            const char *env = std::getenv("COMPLIANCE_LOG_LEVEL");
+            if (env != nullptr)
+                Parse(env);
+        }
+
+        std::atomic<int>& operator[](LogCategory category)
+        {
+            return levels_[static_cast<size_t>(category)];
+        }
+
+    private:
+        std::atomic<int> levels_[LOG_CATEGORY_COUNT];
+
+        /* Parses comma separated list of "category=level" */
+        void Parse(const std::string &env)
+        {
+            size_t pos = 0;
+            while (pos < env.size())
+            {
+                size_t end = env.find(',', pos);
+                if (end == std::string::npos)
+                    end = env.size();
+
+                std::string item = env.substr(pos, end - pos);
+                size_t eq = item.find('=');
+                pos = end + 1;
+                if (eq == std::string::npos)
+                    continue;
+
+                std::string name = item.substr(0, eq);
+                std::string level = item.substr(eq + 1);
+                int severity;
+                if (level == "debug")
+                    severity = static_cast<int>(LogSeverity::Debug);
+                else if (level == "info")
+                    severity = static_cast<int>(LogSeverity::Info);
+                else if (level == "error")
+                    severity = static_cast<int>(LogSeverity::Error);
+                else
+                    continue;
+
+                for (size_t i = 0; i < LOG_CATEGORY_COUNT; i++)
+                    if (name == log_category_names[i] || name == "all")
+                        levels_[i].store(severity);
+            }
+        }
+};
+
+
+/**
+ * Writer thread. Lines are appended to buffer, writer thread takes whole buffer
+ * at once and writes it to output.
+ *
+ * Writer is never destroyed, so that it can be used till the process ends (e.g.
+ * by test thread while simulator exits). Queued lines are written at exit
+ * (atexit hook) and on abort (e.g. failed assert, SIGABRT hook).
+ */
+class LogWriter
+{
+    public:
+        LogWriter():
+            thread_(&LogWriter::Run, this)
+        {
+            thread_.detach();
+        }
+
+        void Append(const std::string &line)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                buffer_.append(line);
+                buffer_.push_back('\n');
+                queued_++;
+            }
+            cv_.notify_one();
+        }
+
+        /* Appends text without new line (part of line written to std::cout) */
+        void AppendRaw(const char *text, size_t len)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                buffer_.append(text, len);
+                queued_++;
+            }
+            cv_.notify_one();
+        }
+
+        void Flush()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            uint64_t target = queued_;
+            done_cv_.wait(lock, [this, target]() { return written_ >= target; });
+        }
+
+        void SetOutput(FILE *output)
+        {
+            Flush();
+            std::lock_guard<std::mutex> lock(mutex_);
+            output_ = output;
+        }
+
+        /*
+         * Writes queued lines from calling thread. Used when process aborts,
+         * so it does not wait for writer thread (lines which writer thread
+         * already took are written by it, unless process ends before).
+         */
+        void WriteNow()
+        {
+            std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+            if (!lock.owns_lock())
+                return;
+            fwrite(buffer_.data(), 1, buffer_.size(), output_);
+            fflush(output_);
+            buffer_.clear();
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::condition_variable done_cv_;
+        std::string buffer_;
+        FILE *output_ = stdout;
+
+        /* Number of lines queued, and number of lines written to output */
+        uint64_t queued_ = 0;
+        uint64_t written_ = 0;
+
+        std::thread thread_;
+
+        void Run()
+        {
+            std::string lines;
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            while (true)
+            {
+                cv_.wait(lock, [this]() { return !buffer_.empty(); });
+
+                lines.swap(buffer_);
+                uint64_t queued = queued_;
+                FILE *output = output_;
+
+                lock.unlock();
+                fwrite(lines.data(), 1, lines.size(), output);
+                fflush(output);
+                lines.clear();
+                lock.lock();
+
+                written_ = queued;
+                done_cv_.notify_all();
+            }
+        }
+};
+
+
+static LogLevels& Levels()
+{
+    static LogLevels levels;
+    return levels;
+}
+
+
+/**
+ * Stream buffer which passes std::cout to writer thread, so that output of
+ * Print methods (frames, bit frames, test sequences) keeps its order with
+ * logged messages. Complete lines are passed to writer, rest on flush.
+ */
+class LogStreamBuf : public std::streambuf
+{
+    public:
+        explicit LogStreamBuf(LogWriter &writer):
+            writer_(writer) {}
+
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if (traits_type::eq_int_type(c, traits_type::eof()))
+                return traits_type::not_eof(c);
+            char ch = traits_type::to_char_type(c);
+            xsputn(&ch, 1);
+            return c;
+        }
+
+        std::streamsize xsputn(const char *s, std::streamsize n) override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.append(s, static_cast<size_t>(n));
+            size_t end = pending_.rfind('\n');
+            if (end != std::string::npos)
+            {
+                writer_.AppendRaw(pending_.data(), end + 1);
+                pending_.erase(0, end + 1);
+            }
+            return n;
+        }
+
+        int sync() override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!pending_.empty())
+            {
+                writer_.AppendRaw(pending_.data(), pending_.size());
+                pending_.clear();
+            }
+            return 0;
+        }
+
+    private:
+        LogWriter &writer_;
+        std::mutex mutex_;
+        std::string pending_;
+};
+
+
+static LogWriter& Writer();
+
+
+static void LogAtExit()
+{
+    std::cout.flush();
+    LogFlush();
+}
+
+
+static void LogAtAbort(int sig)
+{
+    std::signal(sig, SIG_DFL);
+    Writer().WriteNow();
+    std::raise(sig);
+}
+
+
+static LogWriter& Writer()
+{
+    static LogWriter *writer = []() {
+        LogWriter *w = new LogWriter();
+        std::cout.rdbuf(new LogStreamBuf(*w));
+        std::atexit(&LogAtExit);
+        std::signal(SIGABRT, &LogAtAbort);
+        return w;
+    }();
+    return *writer;
+}
+
+
+bool LogIsEnabled(LogCategory category, LogSeverity severity)
+{
+    return static_cast<int>(severity) >= Levels()[category].load(std::memory_order_relaxed);
+}
+
+
+void LogSetLevel(LogCategory category, LogSeverity level)
+{
+    Levels()[category].store(static_cast<int>(level));
+}
+
+
+void LogSetOutput(FILE *output)
+{
+    Writer().SetOutput(output);
+}
+
+
+void LogWrite(LogCategory, LogSeverity severity, const std::string &line)
+{
+    Writer().Append(line);
+    if (severity == LogSeverity::Error)
+        Writer().Flush();
+}
+
+
+void LogPrintf(LogCategory category, LogSeverity severity, const char *fmt, ...)
+{
+    va_list args;
+    va_list args_copy;
+    va_start(args, fmt);
+    va_copy(args_copy, args);
+
+    int len = vsnprintf(nullptr, 0, fmt, args);
+    std::string line(static_cast<size_t>(len > 0 ? len : 0), '\0');
+    vsnprintf(&line[0], line.size() + 1, fmt, args_copy);
+
+    va_end(args_copy);
+    va_end(args);
+
+    LogWrite(category, severity, line);
+}
+
+
+void LogFlush()
+{
+    Writer().Flush();
+}
+
+
+int LogPliIsEnabled(int severity)
+{
+    return LogIsEnabled(LogCategory::Pli, static_cast<LogSeverity>(severity));
+}
+
+
+void LogPliWrite(int severity, const char *line)
+{
+    LogWrite(LogCategory::Pli, static_cast<LogSeverity>(severity), line);
+}
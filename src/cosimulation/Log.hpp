@@ -0,0 +1,133 @@
+#ifndef LOG_H
+#define LOG_H
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Logging of PLI library and of tests.
+ *
+ * Messages have category and severity. Messages below LOG_MIN_SEVERITY are
+ * compiled out (LOG_ENABLED is constant false for them). Messages below runtime
+ * level of their category are dropped before they are formatted. Runtime levels
+ * are taken from "COMPLIANCE_LOG_LEVEL" environment variable (e.g.
+ * "pli=error,test=debug"), or set by LogSetLevel.
+ *
+ * Messages are written to output by writer thread, so that test and simulator
+ * do not wait for output. Error messages are written before LogWrite returns.
+ * Once writer is started, std::cout is passed to it too, so that output of
+ * Print methods keeps its order with messages. Queued messages are written at
+ * exit and on abort.
+ *****************************************************************************/
+
+#include <cstdio>
+#include <string>
+
+/**
+ * Minimal severity of messages which are compiled in (0 - debug, 1 - info,
+ * 2 - error). Debug messages are compiled in only in debug build.
+ */
+#ifndef LOG_MIN_SEVERITY
+    #ifdef DEBUG_BUILD
+        #define LOG_MIN_SEVERITY 0
+    #else
+        #define LOG_MIN_SEVERITY 1
+    #endif
+#endif
+
+/**
+ * @enum Severity of message (same order as severity of PLI messages).
+ */
+enum class LogSeverity
+{
+    Debug,
+    Info,
+    Error
+};
+
+/**
+ * @enum Category of message.
+ *
+ * Pli:
+ *  Messages of PLI library (simulator interface).
+ *
+ * Test:
+ *  Messages of tests (TestMessage, TestBigMessage).
+ */
+enum class LogCategory
+{
+    Pli,
+    Test
+};
+
+#define LOG_CATEGORY_COUNT 2
+
+/**
+ * Checks whether message is enabled. Constant false for messages below
+ * LOG_MIN_SEVERITY, so that code which creates them is compiled out.
+ */
+#define LOG_ENABLED(category, severity) \
+    (static_cast<int>(severity) >= LOG_MIN_SEVERITY && LogIsEnabled(category, severity))
+
+/**
+ * @returns true if message of given category and severity passes runtime level
+ *          of the category.
+ */
+bool LogIsEnabled(LogCategory category, LogSeverity severity);
+
+/**
+ * Sets runtime level of category. Messages of lower severity are dropped.
+ */
+void LogSetLevel(LogCategory category, LogSeverity level);
+
+/**
+ * Sets output to which writer thread writes messages (stdout by default).
+ */
+void LogSetOutput(FILE *output);
+
+/**
+ * Queues line to output (new line is appended). Line is written without
+ * checking the level of the category, use LOG_ENABLED before creating it.
+ */
+void LogWrite(LogCategory category, LogSeverity severity, const std::string &line);
+
+/**
+ * Formats line by printf format and queues it to output.
+ */
+void LogPrintf(LogCategory category, LogSeverity severity, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/**
+ * Waits till all queued lines are written to output. Call before writing to
+ * output by other means than std::cout (e.g. simulator print).
+ */
+extern "C" void LogFlush();
+
+/**
+ * Interface for PLI library (in C). Severity is "t_pli_msg_severity".
+ */
+extern "C" int LogPliIsEnabled(int severity);
+extern "C" void LogPliWrite(int severity, const char *line);
+
+#endif
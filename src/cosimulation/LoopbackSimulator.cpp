@@ -0,0 +1,427 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "LoopbackSimulator.hpp"
+#include "LoopbackTestbench.hpp"
+#include "Log.hpp"
+
+/**
+ * Start-up routines of PLI library (simulator_interface.c)
+ */
+extern "C" void (*lb_startup_routines[])();
+
+/* Simulator which runs simulation, used by interface in loopback_user.h */
+static LoopbackSimulator *loopback_simulator = nullptr;
+
+
+LoopbackConfig::LoopbackConfig():
+    generics{
+        {"CFG_DUT_CLOCK_PERIOD", 10000000},
+        {"CFG_DUT_BRP", 2},
+        {"CFG_DUT_PROP", 15},
+        {"CFG_DUT_PH1", 8},
+        {"CFG_DUT_PH2", 8},
+        {"CFG_DUT_SJW", 4},
+        {"CFG_DUT_BRP_FD", 1},
+        {"CFG_DUT_PROP_FD", 6},
+        {"CFG_DUT_PH1_FD", 4},
+        {"CFG_DUT_PH2_FD", 4},
+        {"CFG_DUT_SJW_FD", 2}
+    }
+{}
+
+
+LoopbackSimulator::LoopbackSimulator() {}
+
+
+LoopbackSimulator::~LoopbackSimulator()
+{
+    if (loopback_simulator == this)
+        loopback_simulator = nullptr;
+}
+
+
+LoopbackSignal* LoopbackSimulator::AddSignal(const std::string &name, size_t size)
+{
+    auto signal = std::make_unique<LoopbackSignal>();
+
+    signal->is_callback = false;
+    signal->name = name;
+    signal->full_name = std::string(CTU_VIP_HIERARCHICAL_PATH) + "/" + name;
+    signal->size = size;
+    signal->aval.resize((size + 31) / 32, 0);
+    signal->bval.resize((size + 31) / 32, 0);
+
+    signals_.push_back(std::move(signal));
+    return signals_.back().get();
+}
+
+
+LoopbackSignal* LoopbackSimulator::FindSignal(const std::string &full_name)
+{
+    for (auto &signal : signals_)
+        if (signal->full_name == full_name)
+            return signal.get();
+    return nullptr;
+}
+
+
+void LoopbackSimulator::Get(const LoopbackSignal *signal, uint32_t *aval, uint32_t *bval) const
+{
+    std::copy(signal->aval.begin(), signal->aval.end(), aval);
+    std::copy(signal->bval.begin(), signal->bval.end(), bval);
+}
+
+
+void LoopbackSimulator::Put(LoopbackSignal *signal, const uint32_t *aval, const uint32_t *bval)
+{
+    size_t n_words = signal->aval.size();
+    size_t top_bits = signal->size % 32;
+    bool changed = false;
+
+    for (size_t i = 0; i < n_words; i++)
+    {
+        uint32_t mask = (i == n_words - 1 && top_bits) ? ((1U << top_bits) - 1) : 0xFFFFFFFF;
+        uint32_t a = aval[i] & mask;
+        uint32_t b = bval[i] & mask;
+
+        changed = changed || (a != signal->aval[i]) || (b != signal->bval[i]);
+        signal->aval[i] = a;
+        signal->bval[i] = b;
+    }
+
+    if (changed && !signal->changed)
+    {
+        signal->changed = true;
+        changed_.push_back(signal);
+    }
+}
+
+
+uint64_t LoopbackSimulator::GetWord(const LoopbackSignal *signal) const
+{
+    uint64_t value = signal->aval[0];
+    if (signal->aval.size() > 1)
+        value |= static_cast<uint64_t>(signal->aval[1]) << 32;
+    return value;
+}
+
+
+void LoopbackSimulator::PutWord(LoopbackSignal *signal, uint64_t aval, uint64_t bval)
+{
+    uint32_t aval_words[2] = {static_cast<uint32_t>(aval), static_cast<uint32_t>(aval >> 32)};
+    uint32_t bval_words[2] = {static_cast<uint32_t>(bval), static_cast<uint32_t>(bval >> 32)};
+
+    Put(signal, aval_words, bval_words);
+}
+
+
+LoopbackCallback* LoopbackSimulator::RegisterCb(lbCbReasonT reason, LoopbackSignal *signal,
+                                                uint64_t delay, lbCbRtnT cb_rtn)
+{
+    if (reason == lbCbValueChange && signal == nullptr)
+        return nullptr;
+
+    auto callback = std::make_unique<LoopbackCallback>();
+    callback->is_callback = true;
+    callback->reason = reason;
+    callback->signal = signal;
+    callback->cb_rtn = cb_rtn;
+
+    if (reason == lbCbValueChange)
+        signal->callbacks.push_back(callback.get());
+    else if (reason == lbCbAfterDelay)
+        callback->delay_it = delayed_.emplace(now_ + delay, callback.get());
+
+    callbacks_.push_back(std::move(callback));
+    return callbacks_.back().get();
+}
+
+
+int LoopbackSimulator::RemoveCb(LoopbackCallback *callback)
+{
+    if (callback->removed)
+        return -1;
+
+    if (callback->reason == lbCbAfterDelay)
+        delayed_.erase(callback->delay_it);
+
+    // Callback is freed once it can't be called anymore (after time step)
+    callback->removed = true;
+    n_removed_++;
+    return 0;
+}
+
+
+void LoopbackSimulator::FreeRemovedCallbacks()
+{
+    if (n_removed_ == 0)
+        return;
+
+    auto is_removed = [](const LoopbackCallback *callback) { return callback->removed; };
+
+    for (auto &signal : signals_)
+        signal->callbacks.erase(std::remove_if(signal->callbacks.begin(),
+                                               signal->callbacks.end(), is_removed),
+                                signal->callbacks.end());
+
+    callbacks_.erase(std::remove_if(callbacks_.begin(), callbacks_.end(),
+                                    [&](const std::unique_ptr<LoopbackCallback> &callback) {
+                                        return is_removed(callback.get());
+                                    }),
+                     callbacks_.end());
+    n_removed_ = 0;
+}
+
+
+void LoopbackSimulator::CallCallbacks(lbCbReasonT reason)
+{
+    // Callbacks may register further callbacks
+    size_t n_callbacks = callbacks_.size();
+
+    for (size_t i = 0; i < n_callbacks; i++)
+    {
+        LoopbackCallback *callback = callbacks_[i].get();
+        if (callback->reason == reason && !callback->removed)
+        {
+            result_.n_callbacks++;
+            callback->cb_rtn();
+        }
+    }
+}
+
+
+void LoopbackSimulator::RunDeltaCycles()
+{
+    size_t n_deltas = 0;
+
+    while (!changed_.empty())
+    {
+        if (++n_deltas > LOOPBACK_MAX_DELTA_CYCLES)
+        {
+            LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                      "Loopback: delta cycles do not converge in time %llu fs",
+                      static_cast<unsigned long long>(now_));
+            changed_.clear();
+            break;
+        }
+        result_.n_delta_cycles++;
+
+        delta_.swap(changed_);
+        changed_.clear();
+
+        for (LoopbackSignal *signal : delta_)
+        {
+            signal->changed = false;
+            if (signal == testbench_->clk && (signal->aval[0] & 0x1))
+                testbench_->Clock();
+        }
+
+        for (LoopbackSignal *signal : delta_)
+        {
+            // Callbacks registered in this delta cycle see next change only
+            size_t n_callbacks = signal->callbacks.size();
+            for (size_t i = 0; i < n_callbacks; i++)
+            {
+                LoopbackCallback *callback = signal->callbacks[i];
+                if (!callback->removed)
+                {
+                    result_.n_callbacks++;
+                    callback->cb_rtn();
+                }
+            }
+        }
+    }
+}
+
+
+LoopbackResult LoopbackSimulator::Run(const std::string &test_name, const LoopbackConfig &config)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    LoopbackTestbench testbench(*this, config);
+    testbench_ = &testbench;
+    loopback_simulator = this;
+    result_ = LoopbackResult();
+
+    for (size_t i = 0; lb_startup_routines[i] != nullptr; i++)
+        lb_startup_routines[i]();
+    CallCallbacks(lbCbStartOfSimulation);
+
+    testbench.Start(test_name);
+    RunDeltaCycles();
+
+    while (!testbench.TestEnded())
+    {
+        uint64_t next = next_clk_edge_;
+        if (!delayed_.empty() && delayed_.begin()->first < next)
+            next = delayed_.begin()->first;
+
+        if (config.max_time != 0 && next > config.max_time)
+        {
+            LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                      "Loopback: test did not end till %llu fs",
+                      static_cast<unsigned long long>(config.max_time));
+            break;
+        }
+        now_ = next;
+
+        if (now_ == next_clk_edge_)
+        {
+            uint64_t clk_value = testbench.clk->aval[0] ^ 0x1;
+            PutWord(testbench.clk, clk_value);
+            next_clk_edge_ += LOOPBACK_PLI_CLK_PERIOD / 2;
+            result_.n_clock_cycles += clk_value;
+        }
+
+        while (!delayed_.empty() && delayed_.begin()->first == now_)
+        {
+            LoopbackCallback *callback = delayed_.begin()->second;
+            delayed_.erase(delayed_.begin());
+            callback->removed = true;
+            n_removed_++;
+            result_.n_callbacks++;
+            callback->cb_rtn();
+        }
+
+        RunDeltaCycles();
+        FreeRemovedCallbacks();
+    }
+
+    CallCallbacks(lbCbEndOfSimulation);
+
+    result_.test_ended = testbench.TestEnded();
+    result_.passed = testbench.TestEnded() && testbench.TestPassed();
+    result_.sim_time = now_;
+    result_.n_commands = testbench.NumCommands();
+    result_.wall_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start);
+
+    testbench_ = nullptr;
+    return result_;
+}
+
+
+LoopbackResult LoopbackSimulatorRun(const std::string &test_name, const LoopbackConfig &config)
+{
+    LoopbackSimulator simulator;
+    LoopbackResult result = simulator.Run(test_name, config);
+
+    LogPrintf(LogCategory::Pli, LogSeverity::Info,
+              "Loopback: test %s %s, simulation time: %llu fs, clock cycles: %llu, "
+              "delta cycles: %llu, callbacks: %llu, commands: %llu, wall time: %lld us",
+              test_name.c_str(),
+              result.passed ? "passed" : (result.test_ended ? "failed" : "did not end"),
+              static_cast<unsigned long long>(result.sim_time),
+              static_cast<unsigned long long>(result.n_clock_cycles),
+              static_cast<unsigned long long>(result.n_delta_cycles),
+              static_cast<unsigned long long>(result.n_callbacks),
+              static_cast<unsigned long long>(result.n_commands),
+              static_cast<long long>(result.wall_time.count() / 1000));
+    LogFlush();
+
+    return result;
+}
+
+
+/******************************************************************************
+ * Interface of simulator for PLI library (loopback_user.h)
+ *****************************************************************************/
+
+static LoopbackSignal* LoopbackSignalOf(lbHandleT handle)
+{
+    if (handle == nullptr || handle->is_callback)
+        return nullptr;
+    return static_cast<LoopbackSignal*>(handle);
+}
+
+
+lbHandleT lb_handle_by_name(const char *name)
+{
+    if (loopback_simulator == nullptr)
+        return nullptr;
+    return loopback_simulator->FindSignal(name);
+}
+
+
+int32_t lb_get(lbIntPropertyT property, lbHandleT handle)
+{
+    LoopbackSignal *signal = LoopbackSignalOf(handle);
+
+    if (signal == nullptr || property != lbSizeP)
+        return 0;
+    return static_cast<int32_t>(signal->size);
+}
+
+
+const char* lb_get_str(lbStrPropertyT property, lbHandleT handle)
+{
+    LoopbackSignal *signal = LoopbackSignalOf(handle);
+
+    if (signal == nullptr)
+        return nullptr;
+    return (property == lbNameP) ? signal->name.c_str() : signal->full_name.c_str();
+}
+
+
+void lb_get_value(lbHandleT handle, uint32_t *aval, uint32_t *bval)
+{
+    LoopbackSignal *signal = LoopbackSignalOf(handle);
+
+    if (signal != nullptr)
+        loopback_simulator->Get(signal, aval, bval);
+}
+
+
+void lb_put_value(lbHandleT handle, const uint32_t *aval, const uint32_t *bval)
+{
+    LoopbackSignal *signal = LoopbackSignalOf(handle);
+
+    if (signal != nullptr)
+        loopback_simulator->Put(signal, aval, bval);
+}
+
+
+lbHandleT lb_register_cb(lbCbReasonT reason, lbHandleT handle, uint64_t delay,
+                         lbCbRtnT cb_rtn)
+{
+    if (loopback_simulator == nullptr)
+        return nullptr;
+    return loopback_simulator->RegisterCb(reason, LoopbackSignalOf(handle), delay, cb_rtn);
+}
+
+
+int lb_remove_cb(lbHandleT cb_handle)
+{
+    if (loopback_simulator == nullptr || cb_handle == nullptr || !cb_handle->is_callback)
+        return -1;
+    return loopback_simulator->RemoveCb(static_cast<LoopbackCallback*>(cb_handle));
+}
@@ -0,0 +1,220 @@
+#ifndef LOOPBACK_SIMULATOR_H
+#define LOOPBACK_SIMULATOR_H
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Loopback simulator. In-process replacement of HDL simulator, so that
+ *        compliance test library can run without GHDL, VCS or NVC.
+ *
+ * Simulator is a small event kernel: it holds signals of CTU CAN FD VIP test
+ * controller agent (see pli_utils.h), generates "pli_clk", and calls PLI
+ * callbacks (value change, after delay, start and end of simulation) via
+ * interface in loopback_user.h. PLI library (simulator_interface.c) runs on
+ * top of it as it does on top of VPI/VHPI. Agents of VIP are modelled by
+ * LoopbackTestbench.
+ *
+ * Simulation time unit is femtosecond. Each time step is processed as:
+ *  1. "pli_clk" is toggled (if clock edge falls on this time).
+ *  2. Callbacks after delay which expire in this time are called.
+ *  3. Delta cycles are run till signals stop changing. In each delta cycle,
+ *     testbench process runs on rising edge of "pli_clk", then callbacks on
+ *     value change of signals which changed in previous delta cycle are called.
+ *
+ * Only single simulation can run in a process (PLI library keeps its state in
+ * global variables).
+ *****************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "loopback_user.h"
+
+/**
+ * Period of "pli_clk" (in femtoseconds).
+ */
+#define LOOPBACK_PLI_CLK_PERIOD 10000000ULL
+
+/**
+ * Maximal number of delta cycles in single time step.
+ */
+#define LOOPBACK_MAX_DELTA_CYCLES 1000
+
+
+/**
+ * @struct Object of loopback simulator (signal or callback).
+ */
+struct lbObjectS
+{
+    bool is_callback;
+};
+
+struct LoopbackCallback;
+
+/**
+ * @struct Signal. Value is held in 4-state encoding (see loopback_user.h).
+ */
+struct LoopbackSignal : lbObjectS
+{
+    std::string name;
+    std::string full_name;
+    size_t size;
+    std::vector<uint32_t> aval;
+    std::vector<uint32_t> bval;
+
+    /* Signal changed in current delta cycle */
+    bool changed = false;
+
+    /* Callbacks on value change of the signal */
+    std::vector<LoopbackCallback*> callbacks;
+};
+
+/**
+ * @struct Callback registered by PLI library.
+ */
+struct LoopbackCallback : lbObjectS
+{
+    lbCbReasonT reason;
+    LoopbackSignal *signal;
+    lbCbRtnT cb_rtn;
+    bool removed = false;
+
+    /* Position in queue of callbacks after delay */
+    std::multimap<uint64_t, LoopbackCallback*>::iterator delay_it;
+};
+
+/**
+ * @struct Configuration of simulation (generics of testbench).
+ */
+struct LoopbackConfig
+{
+    LoopbackConfig();
+
+    /* Values of configuration read by test (TestControllerAgentGetCfg...) */
+    std::map<std::string, uint64_t> generics;
+
+    /* Seed returned by TestControllerAgentGetSeed */
+    int seed = 0;
+
+    /* Simulation ends (as failed) when it reaches this time, 0 - no limit */
+    uint64_t max_time = 1000000000000000ULL;
+};
+
+/**
+ * @struct Result and statistics of simulation.
+ */
+struct LoopbackResult
+{
+    /* Test ended (by TestControllerAgentEndTest), and its result */
+    bool test_ended = false;
+    bool passed = false;
+
+    /* Simulation time (femtoseconds) */
+    uint64_t sim_time = 0;
+
+    uint64_t n_clock_cycles = 0;
+    uint64_t n_delta_cycles = 0;
+    uint64_t n_callbacks = 0;
+    uint64_t n_commands = 0;
+
+    std::chrono::nanoseconds wall_time{0};
+};
+
+class LoopbackTestbench;
+
+
+class LoopbackSimulator
+{
+    public:
+        LoopbackSimulator();
+        ~LoopbackSimulator();
+
+        /**
+         * Runs simulation of test: runs start-up routines of PLI library,
+         * passes control to test, and simulates till test ends.
+         */
+        LoopbackResult Run(const std::string &test_name, const LoopbackConfig &config);
+
+        /**
+         * Creates signal (value is '0').
+         */
+        LoopbackSignal* AddSignal(const std::string &name, size_t size);
+
+        /**
+         * @returns Signal with given full name, nullptr if there is none.
+         */
+        LoopbackSignal* FindSignal(const std::string &full_name);
+
+        void Get(const LoopbackSignal *signal, uint32_t *aval, uint32_t *bval) const;
+        void Put(LoopbackSignal *signal, const uint32_t *aval, const uint32_t *bval);
+
+        /**
+         * Access to signals of at most 64 bits (for testbench).
+         */
+        uint64_t GetWord(const LoopbackSignal *signal) const;
+        void PutWord(LoopbackSignal *signal, uint64_t aval, uint64_t bval = 0);
+
+        LoopbackCallback* RegisterCb(lbCbReasonT reason, LoopbackSignal *signal,
+                                     uint64_t delay, lbCbRtnT cb_rtn);
+        int RemoveCb(LoopbackCallback *callback);
+
+        /**
+         * @returns Current simulation time (femtoseconds).
+         */
+        uint64_t Now() const { return now_; }
+
+    private:
+        uint64_t now_ = 0;
+        uint64_t next_clk_edge_ = 0;
+
+        std::vector<std::unique_ptr<LoopbackSignal>> signals_;
+        std::vector<std::unique_ptr<LoopbackCallback>> callbacks_;
+        std::multimap<uint64_t, LoopbackCallback*> delayed_;
+        size_t n_removed_ = 0;
+
+        /* Signals changed in current delta cycle, and in previous delta cycle */
+        std::vector<LoopbackSignal*> changed_;
+        std::vector<LoopbackSignal*> delta_;
+
+        LoopbackTestbench *testbench_ = nullptr;
+        LoopbackResult result_;
+
+        void CallCallbacks(lbCbReasonT reason);
+        void RunDeltaCycles();
+        void FreeRemovedCallbacks();
+};
+
+
+/**
+ * Runs test in loopback simulator, and prints statistics of simulation.
+ */
+LoopbackResult LoopbackSimulatorRun(const std::string &test_name,
+                                    const LoopbackConfig &config = LoopbackConfig());
+
+#endif
@@ -0,0 +1,759 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include "LoopbackTestbench.hpp"
+#include "Log.hpp"
+
+
+/* Time of driver/monitor item (in femtoseconds) occupies bits 61:0 */
+#define LOOPBACK_ITEM_TIME_MASK ((1ULL << (PLI_DATA_IN_SIZE - 2)) - 1)
+
+
+/******************************************************************************
+ * CAN agent
+ *****************************************************************************/
+
+char LoopbackCanAgent::BusValue(uint64_t time) const
+{
+    for (const LoopbackCanSegment &segment : segments_)
+        if (segment.start <= time && time < segment.end)
+            return segment.value;
+    return '1';
+}
+
+
+char LoopbackCanAgent::MonitoredValue(uint64_t time) const
+{
+    if (time < input_delay)
+        return '1';
+    return BusValue(time - input_delay);
+}
+
+
+void LoopbackCanAgent::StartDriving(uint64_t time)
+{
+    driver_running_ = true;
+    driver_starts_++;
+    driver_start_time_ = time;
+
+    if (driver_fifo_.empty())
+    {
+        driver_running_ = false;
+        driver_stops_++;
+        driver_stop_time_ = time;
+        return;
+    }
+
+    const LoopbackCanItem &item = driver_fifo_.front();
+    segments_.push_back(LoopbackCanSegment{time, time + item.duration, item.value});
+    driver_item_end_ = time + item.duration;
+}
+
+
+void LoopbackCanAgent::AdvanceDriver(uint64_t now)
+{
+    while (driver_running_ && driver_item_end_ <= now)
+    {
+        driver_fifo_.pop_front();
+        if (driver_fifo_.empty())
+        {
+            driver_running_ = false;
+            driver_stops_++;
+            driver_stop_time_ = driver_item_end_;
+            break;
+        }
+
+        const LoopbackCanItem &item = driver_fifo_.front();
+        segments_.push_back(LoopbackCanSegment{driver_item_end_,
+                                               driver_item_end_ + item.duration,
+                                               item.value});
+        driver_item_end_ += item.duration;
+    }
+}
+
+
+void LoopbackCanAgent::DriverStart(uint64_t now)
+{
+    if (DriverInProgress())
+        return;
+
+    // Driver waits till monitor triggers, unless monitor waits for the driver
+    if (wait_for_monitor && monitor_state_ != CanAgentMonitorState::Running &&
+        !(monitor_state_ == CanAgentMonitorState::WaitingForTrigger &&
+          trigger == CanAgentMonitorTrigger::DriverStart))
+    {
+        driver_pending_ = true;
+        return;
+    }
+
+    StartDriving(now);
+}
+
+
+void LoopbackCanAgent::DriverStop(uint64_t now)
+{
+    driver_pending_ = false;
+    if (!driver_running_)
+        return;
+
+    driver_running_ = false;
+    driver_stops_++;
+    driver_stop_time_ = now;
+    if (!segments_.empty() && segments_.back().end > now)
+        segments_.back().end = now;
+}
+
+
+void LoopbackCanAgent::DriverFlush()
+{
+    // Item which is being driven stays till it is driven
+    size_t keep = driver_running_ ? 1 : 0;
+    driver_fifo_.erase(driver_fifo_.begin() + static_cast<long>(std::min(keep, driver_fifo_.size())),
+                       driver_fifo_.end());
+}
+
+
+void LoopbackCanAgent::DriverPush(const LoopbackCanItem &item)
+{
+    driver_fifo_.push_back(item);
+}
+
+
+void LoopbackCanAgent::MonitorStart(uint64_t now)
+{
+    if (monitor_state_ == CanAgentMonitorState::WaitingForTrigger ||
+        monitor_state_ == CanAgentMonitorState::Running)
+        return;
+
+    monitor_state_ = CanAgentMonitorState::WaitingForTrigger;
+    monitor_start_time_ = now;
+    monitor_scan_ = now;
+    monitor_driver_starts_ = driver_starts_;
+    monitor_driver_stops_ = driver_stops_;
+    monitor_mismatches_ = 0;
+}
+
+
+void LoopbackCanAgent::MonitorStop()
+{
+    monitor_state_ = CanAgentMonitorState::Disabled;
+}
+
+
+void LoopbackCanAgent::MonitorFlush()
+{
+    monitor_fifo_.clear();
+}
+
+
+void LoopbackCanAgent::MonitorPush(const LoopbackCanItem &item)
+{
+    monitor_fifo_.push_back(item);
+}
+
+
+/**
+ * Searches for trigger of monitor which occured till "now".
+ * @param time Time of trigger (if it occured).
+ * @returns true if trigger occured, false otherwise.
+ */
+bool LoopbackCanAgent::FindTrigger(uint64_t now, uint64_t *time)
+{
+    switch (trigger)
+    {
+    case CanAgentMonitorTrigger::Immediately:
+    case CanAgentMonitorTrigger::TimeElapsed:
+        *time = monitor_start_time_;
+        return true;
+
+    case CanAgentMonitorTrigger::DriverStart:
+        if (driver_pending_)
+        {
+            driver_pending_ = false;
+            StartDriving(now);
+        }
+        if (driver_starts_ == monitor_driver_starts_)
+            return false;
+        *time = std::max(driver_start_time_, monitor_start_time_);
+        return true;
+
+    case CanAgentMonitorTrigger::DriverStop:
+        if (driver_stops_ == monitor_driver_stops_)
+            return false;
+        *time = std::max(driver_stop_time_, monitor_start_time_);
+        return true;
+
+    default:
+        break;
+    }
+
+    // Edge of bus
+    bool rising = (trigger == CanAgentMonitorTrigger::RxRising ||
+                   trigger == CanAgentMonitorTrigger::TxRising);
+
+    for (const LoopbackCanSegment &segment : segments_)
+    {
+        for (uint64_t edge : {segment.start, segment.end})
+        {
+            if (edge <= monitor_scan_ || edge > now)
+                continue;
+
+            char prev = BusValue(edge - 1);
+            char curr = BusValue(edge);
+            if (rising ? (prev == '0' && curr == '1') : (prev == '1' && curr == '0'))
+            {
+                *time = edge;
+                return true;
+            }
+        }
+    }
+    monitor_scan_ = std::max(monitor_scan_, now);
+
+    return false;
+}
+
+
+void LoopbackCanAgent::StartMonitorItem(uint64_t time)
+{
+    monitor_item_start_ = time;
+    monitor_item_failed_ = false;
+    if (monitor_fifo_.empty())
+        return;
+
+    // Item is sampled each "sample_rate" from its start, or once in its middle
+    const LoopbackCanItem &item = monitor_fifo_.front();
+    if (item.sample_rate == 0 || item.sample_rate >= item.duration)
+    {
+        monitor_rate_ = std::max<uint64_t>(item.duration, 1);
+        monitor_sample_ = time + item.duration / 2;
+    }
+    else
+    {
+        monitor_rate_ = item.sample_rate;
+        monitor_sample_ = time + item.sample_rate;
+    }
+}
+
+
+void LoopbackCanAgent::AdvanceMonitor(uint64_t now)
+{
+    if (monitor_state_ == CanAgentMonitorState::WaitingForTrigger)
+    {
+        uint64_t time;
+        if (!FindTrigger(now, &time))
+            return;
+
+        monitor_state_ = CanAgentMonitorState::Running;
+        if (driver_pending_)
+        {
+            driver_pending_ = false;
+            StartDriving(time);
+            AdvanceDriver(now);
+        }
+        StartMonitorItem(time + input_delay);
+    }
+
+    if (monitor_state_ != CanAgentMonitorState::Running)
+        return;
+
+    while (!monitor_fifo_.empty())
+    {
+        const LoopbackCanItem &item = monitor_fifo_.front();
+        uint64_t end = monitor_item_start_ + item.duration;
+
+        for (; monitor_sample_ < end && monitor_sample_ <= now; monitor_sample_ += monitor_rate_)
+        {
+            char value = MonitoredValue(monitor_sample_);
+            if ((item.value != '0' && item.value != '1') || value == item.value)
+                continue;
+
+            monitor_mismatches_++;
+            if (!monitor_item_failed_ && LOG_ENABLED(LogCategory::Pli, LogSeverity::Info))
+                LogPrintf(LogCategory::Pli, LogSeverity::Info,
+                          "Loopback: CAN agent monitor mismatch at %llu fs, expected: %c, "
+                          "monitored: %c %s", static_cast<unsigned long long>(monitor_sample_),
+                          item.value, value, item.msg.c_str());
+            monitor_item_failed_ = true;
+        }
+
+        if (end > now)
+            return;
+
+        monitor_fifo_.pop_front();
+        StartMonitorItem(end);
+    }
+
+    monitor_state_ = monitor_mismatches_ ? CanAgentMonitorState::Failed :
+                                           CanAgentMonitorState::Passed;
+}
+
+
+void LoopbackCanAgent::Advance(uint64_t now)
+{
+    AdvanceDriver(now);
+    AdvanceMonitor(now);
+
+    // Drop values of bus which neither monitor nor its trigger can need anymore
+    uint64_t keep = (now > input_delay) ? now - input_delay : 0;
+    if (monitor_state_ == CanAgentMonitorState::WaitingForTrigger)
+        keep = std::min(keep, monitor_scan_);
+    else if (monitor_state_ == CanAgentMonitorState::Running)
+        keep = std::min(keep, (monitor_sample_ > input_delay) ? monitor_sample_ - input_delay : 0);
+
+    while (!segments_.empty() && segments_.front().end < keep)
+        segments_.pop_front();
+}
+
+
+/******************************************************************************
+ * Testbench
+ *****************************************************************************/
+
+LoopbackTestbench::LoopbackTestbench(LoopbackSimulator &simulator, const LoopbackConfig &config):
+    sim_(simulator),
+    config_(config),
+    memory_(0x10000 + 4, 0)
+{
+    clk = sim_.AddSignal(PLI_SIGNAL_CLOCK, 1);
+    control_req_ = sim_.AddSignal(PLI_SIGNAL_CONTROL_REQ, 1);
+    control_gnt_ = sim_.AddSignal(PLI_SIGNAL_CONTROL_GNT, 1);
+    test_name_array_ = sim_.AddSignal(PLI_SIGNAL_TEST_NAME_ARRAY, LOOPBACK_TEST_NAME_SIZE);
+    req_ = sim_.AddSignal(PLI_SIGNAL_REQ, PLI_REQ_SIZE);
+    ack_ = sim_.AddSignal(PLI_SIGNAL_ACK, PLI_ACK_SIZE);
+    cmd_ = sim_.AddSignal(PLI_SIGNAL_CMD, PLI_CMD_SIZE);
+    dest_ = sim_.AddSignal(PLI_SIGNAL_DEST, PLI_DEST_SIZE);
+    data_in_ = sim_.AddSignal(PLI_SIGNAL_DATA_IN, PLI_DATA_IN_SIZE);
+    data_in_2_ = sim_.AddSignal(PLI_SIGNAL_DATA_IN_2, PLI_DATA_IN_2_SIZE);
+    data_out_ = sim_.AddSignal(PLI_SIGNAL_DATA_OUT, PLI_DATA_OUT_SIZE);
+    str_buf_in_ = sim_.AddSignal(PLI_SIGNAL_STR_BUF_IN, PLI_STR_BUF_IN_SIZE);
+}
+
+
+void LoopbackTestbench::Start(const std::string &test_name)
+{
+    // Each character is ASCII bit vector, first character is most significant
+    std::vector<uint32_t> aval(LOOPBACK_TEST_NAME_SIZE / 32 + 1, 0);
+    std::vector<uint32_t> bval(LOOPBACK_TEST_NAME_SIZE / 32 + 1, 0);
+
+    for (size_t i = 0; i < test_name.size() && i < LOOPBACK_TEST_NAME_SIZE / 8; i++)
+    {
+        for (size_t j = 0; j < 8; j++)
+        {
+            size_t bit = LOOPBACK_TEST_NAME_SIZE - 1 - (8 * i + j);
+            if ((static_cast<uint8_t>(test_name[i]) >> (7 - j)) & 0x1)
+                aval[bit / 32] |= 1U << (bit % 32);
+        }
+    }
+
+    sim_.Put(test_name_array_, aval.data(), bval.data());
+    sim_.PutWord(control_req_, 1);
+}
+
+
+std::string LoopbackTestbench::ReadMessage() const
+{
+    // ASCII encoding padded by spaces, first character is in most significant byte
+    std::string msg;
+
+    for (size_t i = 0; i < PLI_STR_BUF_MAX_MSG_LEN; i++)
+    {
+        size_t bit = PLI_STR_BUF_IN_SIZE - 8 * (i + 1);
+        msg.push_back(static_cast<char>((str_buf_in_->aval[bit / 32] >> (bit % 32)) & 0xFF));
+    }
+
+    return msg.substr(0, msg.find_last_not_of(' ') + 1);
+}
+
+
+LoopbackCanItem LoopbackTestbench::ReadItem(bool monitor) const
+{
+    uint64_t data_in = sim_.GetWord(data_in_);
+    bool aval = (data_in >> 63) & 0x1;
+    bool bval = (data_in_->bval[1] >> 31) & 0x1;
+    LoopbackCanItem item;
+
+    if (bval)
+        item.value = aval ? 'X' : 'Z';
+    else
+        item.value = aval ? '1' : '0';
+    item.duration = data_in & LOOPBACK_ITEM_TIME_MASK;
+    item.sample_rate = monitor ? (sim_.GetWord(data_in_2_) & LOOPBACK_ITEM_TIME_MASK) : 0;
+    if ((data_in >> 62) & 0x1)
+        item.msg = ReadMessage();
+
+    return item;
+}
+
+
+void LoopbackTestbench::ResetAgentCommand(uint64_t cmd, uint64_t data_in)
+{
+    switch (cmd)
+    {
+    case PLI_RST_AGNT_CMD_ASSERT:
+        reset_asserted_ = true;
+        break;
+    case PLI_RST_AGNT_CMD_DEASSERT:
+        reset_asserted_ = false;
+        break;
+    case PLI_RST_AGNT_CMD_POLARITY_SET:
+        reset_polarity_ = data_in;
+        break;
+    case PLI_RST_AGNT_CMD_POLARITY_GET:
+        data_out_aval_ = reset_polarity_;
+        break;
+    default:
+        LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                  "Loopback: unknown reset agent command: %llu",
+                  static_cast<unsigned long long>(cmd));
+        break;
+    }
+}
+
+
+void LoopbackTestbench::ClockAgentCommand(uint64_t cmd, uint64_t data_in)
+{
+    switch (cmd)
+    {
+    case PLI_CLK_AGNT_CMD_START:
+        clock_running_ = true;
+        break;
+    case PLI_CLK_AGNT_CMD_STOP:
+        clock_running_ = false;
+        break;
+    case PLI_CLK_AGNT_CMD_PERIOD_SET:
+        clock_period_ = data_in;
+        break;
+    case PLI_CLK_AGNT_CMD_PERIOD_GET:
+        data_out_aval_ = clock_period_;
+        break;
+    case PLI_CLK_AGNT_CMD_JITTER_SET:
+        clock_jitter_ = data_in;
+        break;
+    case PLI_CLK_AGNT_CMD_JITTER_GET:
+        data_out_aval_ = clock_jitter_;
+        break;
+    case PLI_CLK_AGNT_CMD_DUTY_SET:
+        clock_duty_ = data_in;
+        break;
+    case PLI_CLK_AGNT_CMD_DUTY_GET:
+        data_out_aval_ = clock_duty_;
+        break;
+    default:
+        LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                  "Loopback: unknown clock agent command: %llu",
+                  static_cast<unsigned long long>(cmd));
+        break;
+    }
+}
+
+
+void LoopbackTestbench::MemBusAgentCommand(uint64_t cmd, uint64_t data_in)
+{
+    // Write flag in bit 50, size in bits 49:48, address in bits 47:32, data in 31:0
+    size_t n_bytes = 1ULL << ((data_in >> 48) & 0x3);
+    size_t address = (data_in >> 32) & 0xFFFF;
+
+    switch (cmd)
+    {
+    case PLI_MEM_BUS_AGNT_START:
+        mem_bus_running_ = true;
+        break;
+    case PLI_MEM_BUS_AGNT_STOP:
+        mem_bus_running_ = false;
+        break;
+    case PLI_MEM_BUS_AGNT_WRITE:
+        for (size_t i = 0; i < n_bytes && i < 4; i++)
+            memory_[address + i] = static_cast<uint8_t>(data_in >> (8 * i));
+        break;
+    case PLI_MEM_BUS_AGNT_READ:
+        for (size_t i = 0; i < n_bytes && i < 4; i++)
+            data_out_aval_ |= static_cast<uint64_t>(memory_[address + i]) << (8 * i);
+        break;
+    case PLI_MEM_BUS_AGNT_X_MODE_START:
+    case PLI_MEM_BUS_AGNT_X_MODE_STOP:
+    case PLI_MEM_BUS_AGNT_SET_X_MODE_SETUP:
+    case PLI_MEM_BUS_AGNT_SET_X_MODE_HOLD:
+    case PLI_MEM_BUS_AGNT_SET_PERIOD:
+    case PLI_MEM_BUS_AGNT_SET_OUTPUT_DELAY:
+    case PLI_MEM_BUS_AGNT_WAIT_DONE:
+        // Accesses take no time
+        break;
+    default:
+        LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                  "Loopback: unknown memory bus agent command: %llu",
+                  static_cast<unsigned long long>(cmd));
+        break;
+    }
+}
+
+
+void LoopbackTestbench::CanAgentCommand(uint64_t cmd, uint64_t data_in, uint64_t now)
+{
+    const uint64_t msb = 1ULL << (PLI_DATA_OUT_SIZE - 1);
+    char value;
+
+    switch (cmd)
+    {
+    case PLI_CAN_AGNT_DRIVER_START:
+        can_agent_.DriverStart(now);
+        break;
+    case PLI_CAN_AGNT_DRIVER_STOP:
+        can_agent_.DriverStop(now);
+        break;
+    case PLI_CAN_AGNT_DRIVER_FLUSH:
+        can_agent_.DriverFlush();
+        break;
+    case PLI_CAN_AGNT_DRIVER_GET_PROGRESS:
+        data_out_aval_ = can_agent_.DriverInProgress() ? msb : 0;
+        break;
+    case PLI_CAN_AGNT_DRIVER_GET_DRIVEN_VAL:
+    case PLI_CAN_AGNT_MONITOR_GET_MONITORED_VAL:
+        value = (cmd == PLI_CAN_AGNT_DRIVER_GET_DRIVEN_VAL) ? can_agent_.BusValue(now) :
+                                                              can_agent_.MonitoredValue(now);
+        data_out_aval_ = (value == '1' || value == 'X') ? msb : 0;
+        data_out_bval_ = (value == 'Z' || value == 'X') ? msb : 0;
+        break;
+    case PLI_CAN_AGNT_DRIVER_PUSH_ITEM:
+        can_agent_.DriverPush(ReadItem(false));
+        break;
+    case PLI_CAN_AGNT_DRIVER_SET_WAIT_TIMEOUT:
+        can_agent_.driver_timeout = data_in;
+        break;
+    case PLI_CAN_AGNT_DRIVER_WAIT_FINISH:
+        wait_ = Wait::Driver;
+        break;
+    case PLI_CAN_AGNT_DRIVER_DRIVE_SINGLE_ITEM:
+        can_agent_.DriverPush(ReadItem(false));
+        can_agent_.DriverStart(now);
+        wait_ = Wait::Driver;
+        break;
+    case PLI_CAN_AGNT_DRIVER_DRIVE_ALL_ITEM:
+        can_agent_.DriverStart(now);
+        wait_ = Wait::Driver;
+        break;
+
+    case PLI_CAN_AGNT_MONITOR_START:
+        can_agent_.MonitorStart(now);
+        break;
+    case PLI_CAN_AGNT_MONITOR_STOP:
+        can_agent_.MonitorStop();
+        break;
+    case PLI_CAN_AGNT_MONITOR_FLUSH:
+        can_agent_.MonitorFlush();
+        break;
+    case PLI_CAN_AGNT_MONITOR_GET_STATE:
+        data_out_aval_ = static_cast<uint64_t>(can_agent_.MonitorState());
+        break;
+    case PLI_CAN_AGNT_MONITOR_PUSH_ITEM:
+        can_agent_.MonitorPush(ReadItem(true));
+        break;
+    case PLI_CAN_AGNT_MONITOR_SET_WAIT_TIMEOUT:
+        can_agent_.monitor_timeout = data_in;
+        break;
+    case PLI_CAN_AGNT_MONITOR_WAIT_FINISH:
+        wait_ = Wait::Monitor;
+        break;
+    case PLI_CAN_AGNT_MONITOR_MONITOR_SINGLE_ITEM:
+        can_agent_.MonitorPush(ReadItem(true));
+        can_agent_.MonitorStart(now);
+        wait_ = Wait::Monitor;
+        break;
+    case PLI_CAN_AGNT_MONITOR_MONITOR_ALL_ITEMS:
+        can_agent_.MonitorStart(now);
+        wait_ = Wait::Monitor;
+        break;
+    case PLI_CAN_AGNT_MONITOR_SET_TRIGGER:
+        can_agent_.trigger = static_cast<CanAgentMonitorTrigger>(data_in & 0x7);
+        break;
+    case PLI_CAN_AGNT_MONITOR_GET_TRIGGER:
+        data_out_aval_ = static_cast<uint64_t>(can_agent_.trigger);
+        break;
+    case PLI_CAN_AGNT_MONITOR_CHECK_RESULT:
+        if (can_agent_.MonitorState() == CanAgentMonitorState::Failed)
+        {
+            LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                      "Loopback: CAN agent monitor failed");
+            check_failed_ = true;
+        }
+        break;
+    case PLI_CAN_AGNT_MONITOR_SET_INPUT_DELAY:
+        can_agent_.input_delay = data_in;
+        break;
+    case PLI_CAN_AGNT_TX_RX_FEEDBACK_ENABLE:
+        can_agent_.tx_rx_feedback = true;
+        break;
+    case PLI_CAN_AGNT_TX_RX_FEEDBACK_DISABLE:
+        can_agent_.tx_rx_feedback = false;
+        break;
+    case PLI_CAN_AGNT_CMD_SET_WAIT_FOR_MONITOR:
+        can_agent_.wait_for_monitor = data_in & 0x1;
+        break;
+    default:
+        LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                  "Loopback: unknown CAN agent command: %llu",
+                  static_cast<unsigned long long>(cmd));
+        break;
+    }
+}
+
+
+void LoopbackTestbench::TestControllerAgentCommand(uint64_t cmd, uint64_t data_in)
+{
+    std::string name;
+
+    switch (cmd)
+    {
+    case PLI_TEST_AGNT_TEST_END:
+        test_end_requested_ = true;
+        test_passed_ = (data_in & 0x1) && !check_failed_;
+        break;
+    case PLI_TEST_AGNT_GET_CFG:
+    {
+        name = ReadMessage();
+        auto generic = config_.generics.find(name);
+        if (generic != config_.generics.end())
+            data_out_aval_ = generic->second;
+        else
+            LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                      "Loopback: unknown configuration: %s", name.c_str());
+        break;
+    }
+    case PLI_TEST_AGNT_GET_SEED:
+        data_out_aval_ = static_cast<uint32_t>(config_.seed);
+        break;
+    default:
+        LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                  "Loopback: unknown test controller agent command: %llu",
+                  static_cast<unsigned long long>(cmd));
+        break;
+    }
+}
+
+
+void LoopbackTestbench::StartCommand(uint64_t now)
+{
+    uint64_t dest = sim_.GetWord(dest_);
+    uint64_t cmd = sim_.GetWord(cmd_);
+    uint64_t data_in = sim_.GetWord(data_in_);
+
+    wait_ = Wait::None;
+    wait_start_ = now;
+    data_out_aval_ = 0;
+    data_out_bval_ = 0;
+
+    switch (dest)
+    {
+    case PLI_DEST_TEST_CONTROLLER_AGENT:
+        TestControllerAgentCommand(cmd, data_in);
+        break;
+    case PLI_DEST_CLK_GEN_AGENT:
+        ClockAgentCommand(cmd, data_in);
+        break;
+    case PLI_DEST_RES_GEN_AGENT:
+        ResetAgentCommand(cmd, data_in);
+        break;
+    case PLI_DEST_MEM_BUS_AGENT:
+        MemBusAgentCommand(cmd, data_in);
+        break;
+    case PLI_DEST_CAN_AGENT:
+        CanAgentCommand(cmd, data_in, now);
+        break;
+    default:
+        LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                  "Loopback: unknown destination: %llu", static_cast<unsigned long long>(dest));
+        break;
+    }
+}
+
+
+bool LoopbackTestbench::CommandDone(uint64_t now)
+{
+    CanAgentMonitorState state = can_agent_.MonitorState();
+    uint64_t timeout;
+    bool done;
+
+    switch (wait_)
+    {
+    case Wait::Driver:
+        done = !can_agent_.DriverInProgress();
+        timeout = can_agent_.driver_timeout;
+        break;
+    case Wait::Monitor:
+        done = (state != CanAgentMonitorState::WaitingForTrigger &&
+                state != CanAgentMonitorState::Running);
+        timeout = can_agent_.monitor_timeout;
+        break;
+    default:
+        return true;
+    }
+
+    if (!done && timeout != 0 && now - wait_start_ >= timeout)
+    {
+        LogPrintf(LogCategory::Pli, LogSeverity::Error,
+                  "Loopback: CAN agent %s did not finish in %llu fs",
+                  (wait_ == Wait::Driver) ? "driver" : "monitor",
+                  static_cast<unsigned long long>(timeout));
+        done = true;
+    }
+
+    return done;
+}
+
+
+void LoopbackTestbench::Clock()
+{
+    uint64_t now = sim_.Now();
+    uint64_t req = sim_.GetWord(req_);
+    uint64_t ack = sim_.GetWord(ack_);
+
+    can_agent_.Advance(now);
+
+    if (req == 1 && ack == 0)
+    {
+        if (!busy_)
+        {
+            StartCommand(now);
+            can_agent_.Advance(now);
+            busy_ = true;
+        }
+        if (CommandDone(now))
+        {
+            sim_.PutWord(data_out_, data_out_aval_, data_out_bval_);
+            sim_.PutWord(ack_, 1);
+            busy_ = false;
+            n_commands_++;
+        }
+    }
+    else if (req == 0 && ack == 1)
+    {
+        sim_.PutWord(ack_, 0);
+        test_ended_ = test_end_requested_;
+    }
+}
@@ -0,0 +1,240 @@
+#ifndef LOOPBACK_TESTBENCH_H
+#define LOOPBACK_TESTBENCH_H
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Testbench of loopback simulator. Software model of CTU CAN FD VIP:
+ *        test controller agent, reset agent, clock generator agent, memory bus
+ *        agent and CAN agent.
+ *
+ * Test controller agent answers requests of PLI library on rising edge of
+ * "pli_clk". Requests which wait for CAN agent are answered once CAN agent
+ * finishes (or once wait timeout elapses).
+ *
+ * There is no DUT. Memory bus agent accesses plain memory, and CAN bus is a
+ * loopback: CAN agent monitor observes value driven by CAN agent driver
+ * (recessive when driver does not drive), delayed by monitor input delay (as if
+ * DUT transmitted what it received). Monitor can be triggered by edges of the
+ * bus, by start or stop of driver, or immediately.
+ *****************************************************************************/
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "LoopbackSimulator.hpp"
+#include "PliComplianceLib.hpp"
+
+/**
+ * Size of "pli_test_name_array" (127 characters, 8 bits each).
+ */
+#define LOOPBACK_TEST_NAME_SIZE 1016
+
+/**
+ * @struct Item of CAN agent driver or monitor (times in femtoseconds).
+ */
+struct LoopbackCanItem
+{
+    char value;
+    uint64_t duration;
+    uint64_t sample_rate;
+    std::string msg;
+};
+
+/**
+ * @struct Value driven on CAN bus in interval <start, end).
+ */
+struct LoopbackCanSegment
+{
+    uint64_t start;
+    uint64_t end;
+    char value;
+};
+
+
+/**
+ * CAN agent (driver and monitor) on loopback CAN bus. State is advanced in
+ * time by "Advance", all times are in femtoseconds.
+ */
+class LoopbackCanAgent
+{
+    public:
+        void Advance(uint64_t now);
+
+        void DriverStart(uint64_t now);
+        void DriverStop(uint64_t now);
+        void DriverFlush();
+        void DriverPush(const LoopbackCanItem &item);
+        bool DriverInProgress() const { return driver_running_ || driver_pending_; }
+
+        void MonitorStart(uint64_t now);
+        void MonitorStop();
+        void MonitorFlush();
+        void MonitorPush(const LoopbackCanItem &item);
+        CanAgentMonitorState MonitorState() const { return monitor_state_; }
+
+        /**
+         * @returns Value of CAN bus in given time ('1' when driver does not drive).
+         */
+        char BusValue(uint64_t time) const;
+
+        /**
+         * @returns Value observed by monitor in given time.
+         */
+        char MonitoredValue(uint64_t time) const;
+
+        CanAgentMonitorTrigger trigger = CanAgentMonitorTrigger::Immediately;
+        uint64_t input_delay = 0;
+        bool wait_for_monitor = false;
+        bool tx_rx_feedback = false;
+        uint64_t driver_timeout = 0;
+        uint64_t monitor_timeout = 0;
+
+    private:
+        /* Driver FIFO, front item is being driven while driver runs */
+        std::deque<LoopbackCanItem> driver_fifo_;
+        bool driver_running_ = false;
+
+        /* Driver was started, but waits till monitor triggers */
+        bool driver_pending_ = false;
+        uint64_t driver_item_end_ = 0;
+
+        /* Number and time of last start and stop of driver */
+        uint64_t driver_starts_ = 0;
+        uint64_t driver_start_time_ = 0;
+        uint64_t driver_stops_ = 0;
+        uint64_t driver_stop_time_ = 0;
+
+        /* Values driven on CAN bus which monitor may still need */
+        std::deque<LoopbackCanSegment> segments_;
+
+        std::deque<LoopbackCanItem> monitor_fifo_;
+        CanAgentMonitorState monitor_state_ = CanAgentMonitorState::Disabled;
+        uint64_t monitor_start_time_ = 0;
+        uint64_t monitor_scan_ = 0;
+        uint64_t monitor_driver_starts_ = 0;
+        uint64_t monitor_driver_stops_ = 0;
+        uint64_t monitor_item_start_ = 0;
+        uint64_t monitor_sample_ = 0;
+        uint64_t monitor_rate_ = 0;
+        uint64_t monitor_mismatches_ = 0;
+        bool monitor_item_failed_ = false;
+
+        void StartDriving(uint64_t time);
+        void AdvanceDriver(uint64_t now);
+        bool FindTrigger(uint64_t now, uint64_t *time);
+        void AdvanceMonitor(uint64_t now);
+        void StartMonitorItem(uint64_t time);
+};
+
+
+class LoopbackTestbench
+{
+    public:
+        LoopbackTestbench(LoopbackSimulator &simulator, const LoopbackConfig &config);
+
+        /**
+         * Passes control to test: drives name of test and requests control.
+         */
+        void Start(const std::string &test_name);
+
+        /**
+         * Process on rising edge of "pli_clk".
+         */
+        void Clock();
+
+        bool TestEnded() const { return test_ended_; }
+        bool TestPassed() const { return test_passed_; }
+        uint64_t NumCommands() const { return n_commands_; }
+
+        LoopbackSignal *clk;
+
+    private:
+        LoopbackSimulator &sim_;
+        const LoopbackConfig &config_;
+
+        LoopbackSignal *control_req_;
+        LoopbackSignal *control_gnt_;
+        LoopbackSignal *test_name_array_;
+        LoopbackSignal *req_;
+        LoopbackSignal *ack_;
+        LoopbackSignal *cmd_;
+        LoopbackSignal *dest_;
+        LoopbackSignal *data_in_;
+        LoopbackSignal *data_in_2_;
+        LoopbackSignal *data_out_;
+        LoopbackSignal *str_buf_in_;
+
+        /* Command which is being processed */
+        enum class Wait
+        {
+            None,
+            Driver,
+            Monitor
+        };
+        bool busy_ = false;
+        Wait wait_ = Wait::None;
+        uint64_t wait_start_ = 0;
+        uint64_t data_out_aval_ = 0;
+        uint64_t data_out_bval_ = 0;
+        uint64_t n_commands_ = 0;
+
+        /* Reset agent */
+        bool reset_asserted_ = false;
+        uint64_t reset_polarity_ = 0;
+
+        /* Clock generator agent */
+        bool clock_running_ = false;
+        uint64_t clock_period_ = 0;
+        uint64_t clock_jitter_ = 0;
+        uint64_t clock_duty_ = 50;
+
+        /* Memory bus agent (byte addressed, little endian) */
+        bool mem_bus_running_ = false;
+        std::vector<uint8_t> memory_;
+
+        LoopbackCanAgent can_agent_;
+
+        /* Test controller agent */
+        bool test_end_requested_ = false;
+        bool test_ended_ = false;
+        bool test_passed_ = false;
+        bool check_failed_ = false;
+
+        std::string ReadMessage() const;
+        LoopbackCanItem ReadItem(bool monitor) const;
+        void StartCommand(uint64_t now);
+        bool CommandDone(uint64_t now);
+
+        void ResetAgentCommand(uint64_t cmd, uint64_t data_in);
+        void ClockAgentCommand(uint64_t cmd, uint64_t data_in);
+        void MemBusAgentCommand(uint64_t cmd, uint64_t data_in);
+        void CanAgentCommand(uint64_t cmd, uint64_t data_in, uint64_t now);
+        void TestControllerAgentCommand(uint64_t cmd, uint64_t data_in);
+};
+
+#endif
@@ -28,7 +28,6 @@
 
 #include <unistd.h>
 #include <stdlib.h>
-#include <bitset>
 #include <string>
 #include <atomic>
 
@@ -36,6 +35,125 @@
 #include "SimulatorChannel.hpp"
 
 
+/* Time of driver/monitor item (in femtoseconds) occupies bits 61:0 */
+#define PLI_ITEM_TIME_MASK ((1ULL << (PLI_DATA_IN_SIZE - 2)) - 1)
+
+
+/**
+ * Encodes driver/monitor item: driven/monitored value in bit 63, flag that item has
+ * message in bit 62, and duration of item in bits 61:0. Value is 4-state, values of
+ * std_logic other than '0', '1', 'L', 'H' and 'Z' are encoded as 'X'.
+ */
+static PliWord PliItemData(char value, bool has_msg, PliFemtoseconds duration)
+{
+    const uint64_t msb = 1ULL << (PLI_DATA_IN_SIZE - 1);
+    unsigned long long timeVal = static_cast<unsigned long long>(duration.count());
+    PliWord word;
+
+    word.aval = (has_msg ? (msb >> 1) : 0) | (timeVal & PLI_ITEM_TIME_MASK);
+    switch (value)
+    {
+    case '0':
+    case 'L':
+        break;
+    case '1':
+    case 'H':
+        word.aval |= msb;
+        break;
+    case 'Z':
+        word.bval |= msb;
+        break;
+    default:
+        word.aval |= msb;
+        word.bval |= msb;
+        break;
+    }
+
+    return word;
+}
+
+
+/**
+ * Encodes access of memory bus agent: write flag in bit 50, size of access in
+ * bits 49:48 (00 - 8 bit, 01 - 16 bit, 10 - 32 bit), address in bits 47:32 and
+ * write data in bits 31:0.
+ */
+static uint64_t MemBusAgentAccess(bool write, uint64_t size, int address, uint32_t data)
+{
+    return (write ? (1ULL << 50) : 0) | (size << 48) |
+           ((static_cast<uint64_t>(address) & 0xFFFF) << 32) | data;
+}
+
+
+/**
+ * @returns Most significant bit of "pli_data_out" as std_logic value ('0', '1', 'X'
+ *          or 'Z').
+ */
+static char PliDataOutMsb(const PliWord &data)
+{
+    const uint64_t msb = 1ULL << (PLI_DATA_OUT_SIZE - 1);
+    bool aval = data.aval & msb;
+    bool bval = data.bval & msb;
+
+    if (bval)
+        return aval ? 'X' : 'Z';
+    return aval ? '1' : '0';
+}
+
+
+/*
+ * Conversions of "pli_data_out" to results of read requests.
+ */
+static int PliDataOutInt(const PliWord &data)
+{
+    return static_cast<int>(data.aval);
+}
+
+static uint32_t PliDataOut32(const PliWord &data)
+{
+    return static_cast<uint32_t>(data.aval);
+}
+
+static uint16_t PliDataOut16(const PliWord &data)
+{
+    return static_cast<uint16_t>(data.aval);
+}
+
+static uint8_t PliDataOut8(const PliWord &data)
+{
+    return static_cast<uint8_t>(data.aval);
+}
+
+static bool PliDataOutMsbSet(const PliWord &data)
+{
+    return PliDataOutMsb(data) == '1';
+}
+
+/* Time is returned in femtoseconds */
+static PliFemtoseconds PliDataOutFemtoseconds(const PliWord &data)
+{
+    return PliFemtoseconds(static_cast<PliFemtoseconds::rep>(data.aval));
+}
+
+static std::chrono::nanoseconds PliDataOutTime(const PliWord &data)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(PliDataOutFemtoseconds(data));
+}
+
+static CanAgentMonitorState PliDataOutMonitorState(const PliWord &data)
+{
+    if (data.aval == 0b000)
+        return CanAgentMonitorState::Disabled;
+    if (data.aval == 0b001)
+        return CanAgentMonitorState::WaitingForTrigger;
+    if (data.aval == 0b010)
+        return CanAgentMonitorState::Running;
+    if (data.aval == 0b011)
+        return CanAgentMonitorState::Passed;
+    return CanAgentMonitorState::Failed;
+}
+
+
 
 /*****************************************************************************
  * Reset agent functions
@@ -43,51 +161,34 @@
 
 void ResetAgentAssert()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_RES_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_RST_AGNT_CMD_ASSERT);
+    SimulatorCommand command(PLI_DEST_RES_GEN_AGENT, PLI_RST_AGNT_CMD_ASSERT);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void ResetAgentDeassert()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_RES_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_RST_AGNT_CMD_DEASSERT);
+    SimulatorCommand command(PLI_DEST_RES_GEN_AGENT, PLI_RST_AGNT_CMD_DEASSERT);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void ResetAgentPolaritySet(int polarity)
 {
-    char pol[2];
-    sprintf(pol, "%d", polarity);
-
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_RES_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_RST_AGNT_CMD_POLARITY_SET);
-    simulator_channel.pli_data_in = std::string(pol);
+    SimulatorCommand command(PLI_DEST_RES_GEN_AGENT, PLI_RST_AGNT_CMD_POLARITY_SET);
+    command.SetDataIn(static_cast<uint64_t>(polarity));
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 int ResetAgentPolarityGet()
 {
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_RES_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_RST_AGNT_CMD_POLARITY_GET);
+    SimulatorCommand command(PLI_DEST_RES_GEN_AGENT, PLI_RST_AGNT_CMD_POLARITY_GET, true);
 
-    SimulatorChannelProcessRequest();
-
-    return atoi(&simulator_channel.pli_data_out.at(0));
+    return PliDataOutInt(SimulatorChannelProcessRead(command));
 }
 
 
@@ -97,52 +198,42 @@ int ResetAgentPolarityGet()
 
 void ClockAgentStart()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CLK_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CLK_AGNT_CMD_START);
+    SimulatorCommand command(PLI_DEST_CLK_GEN_AGENT, PLI_CLK_AGNT_CMD_START);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void ClockAgentStop()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CLK_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CLK_AGNT_CMD_STOP);
+    SimulatorCommand command(PLI_DEST_CLK_GEN_AGENT, PLI_CLK_AGNT_CMD_STOP);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void ClockAgentSetPeriod(std::chrono::nanoseconds clockPeriod)
 {
-    unsigned long long timeVal = clockPeriod.count() * 1000000;
+    ClockAgentSetPeriod(PliFemtoseconds(clockPeriod));
+}
+
+
+void ClockAgentSetPeriod(PliFemtoseconds clockPeriod)
+{
+    unsigned long long timeVal = static_cast<unsigned long long>(clockPeriod.count());
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CLK_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CLK_AGNT_CMD_PERIOD_SET);
-    simulator_channel.pli_data_in = std::bitset<PLI_DATA_IN_SIZE>(timeVal).to_string();
+    SimulatorCommand command(PLI_DEST_CLK_GEN_AGENT, PLI_CLK_AGNT_CMD_PERIOD_SET);
+    command.SetDataIn(timeVal);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 std::chrono::nanoseconds ClockAgentGetPeriod()
 {
-    unsigned long long readTime;
-
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CLK_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CLK_AGNT_CMD_PERIOD_GET);
+    SimulatorCommand command(PLI_DEST_CLK_GEN_AGENT, PLI_CLK_AGNT_CMD_PERIOD_GET, true);
 
-    SimulatorChannelProcessRequest();
-    readTime = std::strtoll(simulator_channel.pli_data_out.c_str(), nullptr, 2) / 1000000;
-    return std::chrono::nanoseconds(readTime);
+    return PliDataOutTime(SimulatorChannelProcessRead(command));
 }
 
 
@@ -150,52 +241,35 @@ void ClockAgentSetJitter(std::chrono::nanoseconds jitter)
 {
     unsigned long long timeVal = jitter.count() * 1000000;
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CLK_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CLK_AGNT_CMD_JITTER_SET);
-    simulator_channel.pli_data_in = std::bitset<PLI_DATA_IN_SIZE>(timeVal).to_string();
+    SimulatorCommand command(PLI_DEST_CLK_GEN_AGENT, PLI_CLK_AGNT_CMD_JITTER_SET);
+    command.SetDataIn(timeVal);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 std::chrono::nanoseconds ClockAgentGetJitter()
 {
-    unsigned long long readJitter;
+    SimulatorCommand command(PLI_DEST_CLK_GEN_AGENT, PLI_CLK_AGNT_CMD_JITTER_GET, true);
 
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CLK_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CLK_AGNT_CMD_JITTER_GET);
-
-    SimulatorChannelProcessRequest();
-    readJitter = std::strtoll(simulator_channel.pli_data_out.c_str(), nullptr, 2) / 1000000;
-    return std::chrono::nanoseconds(readJitter);
+    return PliDataOutTime(SimulatorChannelProcessRead(command));
 }
 
 
 void ClockAgentSetDuty(int duty)
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CLK_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CLK_AGNT_CMD_DUTY_SET);
-    simulator_channel.pli_data_in = std::bitset<PLI_DATA_IN_SIZE>(duty).to_string();
+    SimulatorCommand command(PLI_DEST_CLK_GEN_AGENT, PLI_CLK_AGNT_CMD_DUTY_SET);
+    command.SetDataIn(static_cast<uint64_t>(duty));
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 int ClockAgentGetDuty()
 {
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CLK_GEN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CLK_AGNT_CMD_DUTY_GET);
+    SimulatorCommand command(PLI_DEST_CLK_GEN_AGENT, PLI_CLK_AGNT_CMD_DUTY_GET, true);
 
-    SimulatorChannelProcessRequest();
-    return std::stoi(simulator_channel.pli_data_out.c_str(), nullptr, 2);
+    return PliDataOutInt(SimulatorChannelProcessRead(command));
 }
 
 
@@ -205,23 +279,17 @@ int ClockAgentGetDuty()
 
 void MemBusAgentStart()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_START);
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_START);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void MemBusAgentStop()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_STOP);
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_STOP);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
@@ -231,138 +299,89 @@ void MemBusAgentWrite32(int address, uint32_t data)
     //std::cout << "Address: 0x" << std::hex << address << std::endl;
     //std::cout << "Data: 0x" << std::hex << data << std::endl;
 
-    std::string tmp = "1"; // Use blocking write
-    tmp.append("10"); // 32 bit write
-    tmp.append(std::bitset<16>(address).to_string());
-    tmp.append(std::bitset<32>(data).to_string());
-
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_WRITE);
-    simulator_channel.pli_data_in = tmp;
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_WRITE);
+    command.SetDataIn(MemBusAgentAccess(true, 0b10, address, data));
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelPostRequest(command);
 }
 
 
 void MemBusAgentWrite16(int address, uint16_t data)
 {
-    std::string tmp = "1"; // Use blocking write
-    tmp.append("01"); // 16 bit write
-    tmp.append(std::bitset<16>(address).to_string());
-    tmp.append("0000000000000000");
-    tmp.append(std::bitset<16>(data).to_string());
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_WRITE);
+    command.SetDataIn(MemBusAgentAccess(true, 0b01, address, data));
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_WRITE);
-    simulator_channel.pli_data_in = tmp;
-
-    SimulatorChannelProcessRequest();
+    SimulatorChannelPostRequest(command);
 }
 
 
 void MemBusAgentWrite8(int address, uint8_t data)
 {
-    std::string tmp = "1"; // Use blocking write
-    tmp.append("00"); // 8 bit write
-    tmp.append(std::bitset<16>(address).to_string());
-    tmp.append("000000000000000000000000");
-    tmp.append(std::bitset<8>(data).to_string());
-
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_WRITE);
-    simulator_channel.pli_data_in = tmp;
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_WRITE);
+    command.SetDataIn(MemBusAgentAccess(true, 0b00, address, data));
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelPostRequest(command);
 }
 
 
-uint32_t MemBusAgentRead32(int address)
+PliFuture<uint32_t> MemBusAgentRead32Async(int address)
 {
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_READ, true);
+    command.SetDataIn(MemBusAgentAccess(false, 0b10, address, 0));
 
-    //std::cout << "Memory bus agent 32-bit read:" << std::endl;
-    //std::cout << "Address: 0x" << std::hex << address << std::endl;
-
-    std::string tmp = "";
-    tmp.append("10"); // 32 bit access
-    tmp.append(std::bitset<16>(address).to_string());
-    tmp.append("00000000000000000000000000000000");
+    return PliFuture<uint32_t>(SimulatorChannelPostRead(command), PliDataOut32);
+}
 
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_READ);
-    simulator_channel.pli_data_in = tmp;
 
-    SimulatorChannelProcessRequest();
+PliFuture<uint16_t> MemBusAgentRead16Async(int address)
+{
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_READ, true);
+    command.SetDataIn(MemBusAgentAccess(false, 0b01, address, 0));
 
-    uint32_t rv = (uint32_t)strtoul(simulator_channel.pli_data_out.c_str(), NULL, 2);
-    //std::cout << "Data: 0x" << std::hex << rv << std::endl;
-    return rv;
+    return PliFuture<uint16_t>(SimulatorChannelPostRead(command), PliDataOut16);
 }
 
-uint16_t MemBusAgentRead16(int address)
+
+PliFuture<uint8_t> MemBusAgentRead8Async(int address)
 {
-    std::string tmp = "";
-    tmp.append("01"); // 16 bit access
-    tmp.append(std::bitset<16>(address).to_string());
-    tmp.append("00000000000000000000000000000000");
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_READ, true);
+    command.SetDataIn(MemBusAgentAccess(false, 0b00, address, 0));
 
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_READ);
-    simulator_channel.pli_data_in = tmp;
+    return PliFuture<uint8_t>(SimulatorChannelPostRead(command), PliDataOut8);
+}
 
-    SimulatorChannelProcessRequest();
 
-    return (uint16_t)strtoul(simulator_channel.pli_data_out.c_str(), NULL, 2);
+uint32_t MemBusAgentRead32(int address)
+{
+    return MemBusAgentRead32Async(address).Get();
 }
 
 
-uint8_t MemBusAgentRead8(int address)
+uint16_t MemBusAgentRead16(int address)
 {
-    std::string tmp = "";
-    tmp.append("00"); // 8 bit access
-    tmp.append(std::bitset<16>(address).to_string());
-    tmp.append("00000000000000000000000000000000");
-
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_READ);
-    simulator_channel.pli_data_in = tmp;
+    return MemBusAgentRead16Async(address).Get();
+}
 
-    SimulatorChannelProcessRequest();
 
-    return (uint8_t)strtoul(simulator_channel.pli_data_out.c_str(), NULL, 2);
+uint8_t MemBusAgentRead8(int address)
+{
+    return MemBusAgentRead8Async(address).Get();
 }
 
 
 void MemBusAgentXModeStart()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_X_MODE_START);
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_X_MODE_START);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void MemBusAgentXModeStop()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_X_MODE_STOP);
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_X_MODE_STOP);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
@@ -370,13 +389,10 @@ void memBusAgentSetXModeSetup(std::chrono::nanoseconds setup)
 {
     unsigned long long timeVal = setup.count() * 1000000;
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_SET_X_MODE_SETUP);
-    simulator_channel.pli_data_in = std::bitset<PLI_DATA_IN_SIZE>(timeVal).to_string();
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_SET_X_MODE_SETUP);
+    command.SetDataIn(timeVal);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
@@ -384,13 +400,10 @@ void MemBusAgentSetXModeHold(std::chrono::nanoseconds hold)
 {
     unsigned long long timeVal = hold.count() * 1000000;
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_SET_X_MODE_HOLD);
-    simulator_channel.pli_data_in = std::bitset<PLI_DATA_IN_SIZE>(timeVal).to_string();
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_SET_X_MODE_HOLD);
+    command.SetDataIn(timeVal);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
@@ -398,113 +411,86 @@ void MemBusAgentSetOutputDelay(std::chrono::nanoseconds delay)
 {
     unsigned long long timeVal = delay.count() * 1000000;
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_MEM_BUS_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_MEM_BUS_AGNT_SET_OUTPUT_DELAY);
-    simulator_channel.pli_data_in = std::bitset<PLI_DATA_IN_SIZE>(timeVal).to_string();
+    SimulatorCommand command(PLI_DEST_MEM_BUS_AGENT, PLI_MEM_BUS_AGNT_SET_OUTPUT_DELAY);
+    command.SetDataIn(timeVal);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentDriverStart()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_START);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_START);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentDriverStop()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_STOP);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_STOP);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentDriverFlush()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_FLUSH);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_FLUSH);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
-bool CanAgentDriverGetProgress()
+PliFuture<bool> CanAgentDriverGetProgressAsync()
 {
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_GET_PROGRESS);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_GET_PROGRESS, true);
+
+    return PliFuture<bool>(SimulatorChannelPostRead(command), PliDataOutMsbSet);
+}
 
-    SimulatorChannelProcessRequest();
 
-    if (simulator_channel.pli_data_out.at(0) == '1')
-        return true;
-    return false;
+bool CanAgentDriverGetProgress()
+{
+    return CanAgentDriverGetProgressAsync().Get();
 }
 
 
 char CanAgentDriverGetDrivenVal()
 {
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_GET_DRIVEN_VAL);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_GET_DRIVEN_VAL, true);
 
-    SimulatorChannelProcessRequest();
-
-    return simulator_channel.pli_data_out.c_str()[0];
+    return PliDataOutMsb(SimulatorChannelProcessRead(command));
 }
 
 
 void CanAgentDriverPushItem(char drivenValue, std::chrono::nanoseconds duration)
 {
-    unsigned long long timeVal = duration.count() * 1000000;
-
-    std::string tmp = "";
-    tmp.append(1, drivenValue);                                         // Driven value
-    tmp.append("0");                                                    // No message
-    tmp.append(std::bitset<PLI_DATA_IN_SIZE-2>(timeVal).to_string());   // Drive time
+    CanAgentDriverPushItem(drivenValue, PliFemtoseconds(duration), PLI_MESSAGE_NONE);
+}
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_PUSH_ITEM);
-    simulator_channel.pli_data_in = tmp;
 
-    SimulatorChannelProcessRequest();
+void CanAgentDriverPushItem(char drivenValue, std::chrono::nanoseconds duration, std::string msg)
+{
+    CanAgentDriverPushItem(drivenValue, PliFemtoseconds(duration),
+                           SimulatorChannelInternMessage(msg));
 }
 
 
-void CanAgentDriverPushItem(char drivenValue, std::chrono::nanoseconds duration, std::string msg)
+void CanAgentDriverPushItem(char drivenValue, std::chrono::nanoseconds duration,
+                            PliMessageId msgId)
 {
-    unsigned long long timeVal = duration.count() * 1000000;
+    CanAgentDriverPushItem(drivenValue, PliFemtoseconds(duration), msgId);
+}
 
-    std::string tmp = "";
-    tmp.append(1, drivenValue);                                         // Driven value
-    tmp.append("1");                                                    // Message included
-    tmp.append(std::bitset<PLI_DATA_IN_SIZE-2>(timeVal).to_string());   // Drive time
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = true;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_PUSH_ITEM);
-    simulator_channel.pli_message_data = msg;
-    simulator_channel.pli_data_in = tmp;
+void CanAgentDriverPushItem(char drivenValue, PliFemtoseconds duration, PliMessageId msgId)
+{
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_PUSH_ITEM);
+    command.SetMessageData(msgId);
+    command.SetDataIn(PliItemData(drivenValue, msgId != PLI_MESSAGE_NONE, duration));
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelPostRequest(command);
 }
 
 
@@ -512,213 +498,140 @@ void CanAgentDriverSetWaitTimeout(std::chrono::nanoseconds timeout)
 {
     unsigned long long timeVal = timeout.count() * 1000000;
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_SET_WAIT_TIMEOUT);
-    simulator_channel.pli_data_in = std::bitset<PLI_DATA_IN_SIZE>(timeVal).to_string();
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_SET_WAIT_TIMEOUT);
+    command.SetDataIn(timeVal);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentDriverWaitFinish()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_WAIT_FINISH);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_WAIT_FINISH);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentDriveSingleItem(char drivenValue, std::chrono::nanoseconds duration, std::string msg)
 {
-    unsigned long long timeVal = duration.count() * 1000000;
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_DRIVE_SINGLE_ITEM);
+    command.SetMessageData(msg);
+    command.SetDataIn(PliItemData(drivenValue, true, duration));
 
-    std::string tmp = "";
-    tmp.append(1, drivenValue);                                             // Driven value
-    tmp.append("1");                                                        // Message included
-    tmp.append(std::bitset<PLI_DATA_IN_SIZE-2>(timeVal).to_string());       // Drive time
-
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = true;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_DRIVE_SINGLE_ITEM);
-    simulator_channel.pli_message_data = msg;
-    simulator_channel.pli_data_in = tmp;
-
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentDriveSingleItem(char drivenValue, std::chrono::nanoseconds duration)
 {
-    unsigned long long timeVal = duration.count() * 1000000;
-    std::string data_in = "";
-    data_in.append(1, drivenValue);                                         // Driven value
-    data_in.append("0");                                                    // No message
-    data_in.append(std::bitset<PLI_DATA_IN_SIZE-2>(timeVal).to_string());   // Drive time
+    PliWord data_in = PliItemData(drivenValue, false, duration);
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_DRIVE_SINGLE_ITEM);
-    simulator_channel.pli_data_in = data_in;
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_DRIVE_SINGLE_ITEM);
+    command.SetDataIn(data_in);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentDriveAllItems()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_DRIVER_DRIVE_ALL_ITEM);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_DRIVER_DRIVE_ALL_ITEM);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentSetWaitForMonitor(bool waitForMonitor)
 {
-    std::string tmp = "";
-    tmp.append(std::bitset<PLI_DATA_IN_SIZE-1>(0).to_string());
-    if (waitForMonitor)
-        tmp.append("1");
-    else
-        tmp.append("0");
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_CMD_SET_WAIT_FOR_MONITOR);
+    command.SetDataIn(waitForMonitor ? 1 : 0);
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_CMD_SET_WAIT_FOR_MONITOR);
-    simulator_channel.pli_data_in = tmp;
-
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentMonitorStart()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_START);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_START);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentMonitorStop()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_STOP);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_STOP);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentMonitorFlush()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_FLUSH);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_FLUSH);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
-CanAgentMonitorState CanAgentMonitorGetState()
+PliFuture<CanAgentMonitorState> CanAgentMonitorGetStateAsync()
 {
-    CanAgentMonitorState retVal;
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_GET_STATE, true);
 
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_GET_STATE);
-
-    SimulatorChannelProcessRequest();
+    return PliFuture<CanAgentMonitorState>(SimulatorChannelPostRead(command),
+                                           PliDataOutMonitorState);
+}
 
-    if (!simulator_channel.pli_data_out.compare("000"))
-        retVal = CanAgentMonitorState::Disabled;
-    else if (!simulator_channel.pli_data_out.compare("001"))
-        retVal = CanAgentMonitorState::WaitingForTrigger;
-    else if (!simulator_channel.pli_data_out.compare("010"))
-        retVal = CanAgentMonitorState::Running;
-    else if (!simulator_channel.pli_data_out.compare("011"))
-        retVal = CanAgentMonitorState::Passed;
-    else
-        retVal = CanAgentMonitorState::Failed;
 
-    return retVal;
+CanAgentMonitorState CanAgentMonitorGetState()
+{
+    return CanAgentMonitorGetStateAsync().Get();
 }
 
 
 char CanAgentMonitorGetMonitoredVal()
 {
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_GET_MONITORED_VAL);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_GET_MONITORED_VAL, true);
 
-    SimulatorChannelProcessRequest();
-
-    return simulator_channel.pli_data_out.at(0);
+    return PliDataOutMsb(SimulatorChannelProcessRead(command));
 }
 
 void CanAgentMonitorPushItem(char monitorValue, std::chrono::nanoseconds duration,
                              std::chrono::nanoseconds sampleRate)
 {
-    unsigned long long timeVal = duration.count() * 1000000;
-    std::string tmp = "";
-    tmp.append(1, monitorValue);                                        // Driven value
-    tmp.append("0");                                                    // No message
-    tmp.append(std::bitset<PLI_DATA_IN_SIZE-2>(timeVal).to_string());   // Drive time
-
-    unsigned long long sampleRateVal = sampleRate.count() * 1000000;
-    std::string tmp_2 = "";
-    tmp_2.append(std::bitset<PLI_DATA_IN_SIZE-2>(sampleRateVal).to_string());
+    CanAgentMonitorPushItem(monitorValue, PliFemtoseconds(duration), PliFemtoseconds(sampleRate),
+                            PLI_MESSAGE_NONE);
+}
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_PUSH_ITEM);
-    simulator_channel.pli_data_in = tmp;
-    simulator_channel.pli_data_in_2 = tmp_2;
 
-    SimulatorChannelProcessRequest();
+void CanAgentMonitorPushItem(char monitorValue, std::chrono::nanoseconds duration,
+                             std::chrono::nanoseconds sampleRate, std::string msg)
+{
+    CanAgentMonitorPushItem(monitorValue, PliFemtoseconds(duration), PliFemtoseconds(sampleRate),
+                            SimulatorChannelInternMessage(msg));
 }
 
 
 void CanAgentMonitorPushItem(char monitorValue, std::chrono::nanoseconds duration,
-                             std::chrono::nanoseconds sampleRate, std::string msg)
+                             std::chrono::nanoseconds sampleRate, PliMessageId msgId)
 {
-    unsigned long long timeVal = duration.count() * 1000000;
+    CanAgentMonitorPushItem(monitorValue, PliFemtoseconds(duration), PliFemtoseconds(sampleRate),
+                            msgId);
+}
 
-    std::string tmp = "";
-    tmp.append(1, monitorValue);                                        // Driven value
-    tmp.append("1");                                                    // Message included
-    tmp.append(std::bitset<PLI_DATA_IN_SIZE-2>(timeVal).to_string());   // Drive time
 
-    unsigned long long sampleRateVal = sampleRate.count() * 1000000;
-    std::string tmp_2 = "";
-    tmp_2.append(std::bitset<PLI_DATA_IN_SIZE-2>(sampleRateVal).to_string());
+void CanAgentMonitorPushItem(char monitorValue, PliFemtoseconds duration,
+                             PliFemtoseconds sampleRate, PliMessageId msgId)
+{
+    unsigned long long sampleRateVal = static_cast<unsigned long long>(sampleRate.count());
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = true;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_PUSH_ITEM);
-    simulator_channel.pli_data_in = tmp;
-    simulator_channel.pli_message_data = msg;
-    simulator_channel.pli_data_in_2 = tmp_2;
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_PUSH_ITEM);
+    command.SetDataIn(PliItemData(monitorValue, msgId != PLI_MESSAGE_NONE, duration));
+    command.SetMessageData(msgId);
+    command.SetDataIn2(sampleRateVal & PLI_ITEM_TIME_MASK);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelPostRequest(command);
 }
 
 
@@ -726,153 +639,114 @@ void CanAgentMonitorSetWaitTimeout(std::chrono::nanoseconds timeout)
 {
     unsigned long long timeVal = timeout.count() * 1000000;
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_SET_WAIT_TIMEOUT);
-    simulator_channel.pli_data_in = std::bitset<PLI_DATA_IN_SIZE>(timeVal).to_string();
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_SET_WAIT_TIMEOUT);
+    command.SetDataIn(timeVal);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentMonitorWaitFinish()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_WAIT_FINISH);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_WAIT_FINISH);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentMonitorSingleItem(char monitorValue, std::chrono::nanoseconds duration,
                                std::chrono::nanoseconds sampleRate)
 {
-    unsigned long long timeVal = duration.count() * 1000000;
-    std::string tmp = "";
-
-    tmp.append(1, monitorValue);                                        // Driven value
-    tmp.append("0");                                                    // No Message
-    tmp.append(std::bitset<PLI_DATA_IN_SIZE-2>(timeVal).to_string());   // Drive time
-
     unsigned long long sampleRateVal = sampleRate.count() * 1000000;
-    std::string tmp_2 = "";
-    tmp_2.append(std::bitset<PLI_DATA_IN_SIZE-2>(sampleRateVal).to_string());
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_MONITOR_SINGLE_ITEM);
-    simulator_channel.pli_data_in = tmp;
-    simulator_channel.pli_data_in_2 = tmp_2;
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_MONITOR_SINGLE_ITEM);
+    command.SetDataIn(PliItemData(monitorValue, false, duration));
+    command.SetDataIn2(sampleRateVal & PLI_ITEM_TIME_MASK);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentMonitorSingleItem(char monitorValue, std::chrono::nanoseconds duration,
                                std::chrono::nanoseconds sampleRate, std::string msg)
 {
-    unsigned long long timeVal = duration.count() * 1000000;
-
-    std::string tmp = "";
-    tmp.append(1, monitorValue);                                        // Driven value
-    tmp.append("1");                                                    // Message included
-    tmp.append(std::bitset<PLI_DATA_IN_SIZE-2>(timeVal).to_string());   // Drive time
-
     unsigned long long sampleRateVal = sampleRate.count() * 1000000;
-    std::string tmp_2 = "";
-    tmp_2.append(std::bitset<PLI_DATA_IN_SIZE-2>(sampleRateVal).to_string());
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = true;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_MONITOR_SINGLE_ITEM);
-    simulator_channel.pli_data_in = tmp;
-    simulator_channel.pli_data_in_2 = tmp_2;
-    simulator_channel.pli_message_data = msg;
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_MONITOR_SINGLE_ITEM);
+    command.SetDataIn(PliItemData(monitorValue, true, duration));
+    command.SetDataIn2(sampleRateVal & PLI_ITEM_TIME_MASK);
+    command.SetMessageData(msg);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentMonitorAllItems()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_MONITOR_ALL_ITEMS);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_MONITOR_ALL_ITEMS);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentMonitorSetTrigger(CanAgentMonitorTrigger trigger)
 {
-    std::string tmp = "";
+    uint64_t code = 0;
     switch (trigger){
     case CanAgentMonitorTrigger::Immediately:
-        tmp.append("000");
+        code = 0b000;
         break;
     case CanAgentMonitorTrigger::RxRising:
-        tmp.append("001");
+        code = 0b001;
         break;
     case CanAgentMonitorTrigger::RxFalling:
-        tmp.append("010");
+        code = 0b010;
         break;
     case CanAgentMonitorTrigger::TxRising:
-        tmp.append("011");
+        code = 0b011;
         break;
     case CanAgentMonitorTrigger::TxFalling:
-        tmp.append("100");
+        code = 0b100;
         break;
     case CanAgentMonitorTrigger::TimeElapsed:
-        tmp.append("101");
+        code = 0b101;
         break;
     case CanAgentMonitorTrigger::DriverStart:
-        tmp.append("110");
+        code = 0b110;
         break;
     case CanAgentMonitorTrigger::DriverStop:
-        tmp.append("111");
+        code = 0b111;
         break;
     }
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_SET_TRIGGER);
-    simulator_channel.pli_data_in = tmp;
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_SET_TRIGGER);
+    command.SetDataIn(code);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 CanAgentMonitorTrigger CanAgentMonitorGetTrigger()
 {
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_GET_TRIGGER);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_GET_TRIGGER, true);
 
-    SimulatorChannelProcessRequest();
+    PliWord data = SimulatorChannelProcessRead(command);
 
-    if (!simulator_channel.pli_data_out.compare("000"))
+    if (data.aval == 0b000)
         return CanAgentMonitorTrigger::Immediately;
-    if (!simulator_channel.pli_data_out.compare("001"))
+    if (data.aval == 0b001)
         return CanAgentMonitorTrigger::RxRising;
-    if (!simulator_channel.pli_data_out.compare("010"))
+    if (data.aval == 0b010)
         return CanAgentMonitorTrigger::RxFalling;
-    if (!simulator_channel.pli_data_out.compare("011"))
+    if (data.aval == 0b011)
         return CanAgentMonitorTrigger::TxRising;
-    if (!simulator_channel.pli_data_out.compare("100"))
+    if (data.aval == 0b100)
         return CanAgentMonitorTrigger::TxFalling;
-    if (!simulator_channel.pli_data_out.compare("101"))
+    if (data.aval == 0b101)
         return CanAgentMonitorTrigger::TimeElapsed;
-    if (!simulator_channel.pli_data_out.compare("110"))
+    if (data.aval == 0b110)
         return CanAgentMonitorTrigger::DriverStart;
-    if (!simulator_channel.pli_data_out.compare("111"))
+    if (data.aval == 0b111)
         return CanAgentMonitorTrigger::DriverStop;
 
     return CanAgentMonitorTrigger::Immediately;
@@ -881,95 +755,87 @@ CanAgentMonitorTrigger CanAgentMonitorGetTrigger()
 
 void CanAgentCheckResult()
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_CHECK_RESULT);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_CHECK_RESULT);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentSetMonitorInputDelay(std::chrono::nanoseconds inputDelay)
 {
-    unsigned long long timeVal = inputDelay.count() * 1000000;
+    CanAgentSetMonitorInputDelay(PliFemtoseconds(inputDelay));
+}
 
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_MONITOR_SET_INPUT_DELAY);
-    simulator_channel.pli_data_in = std::bitset<PLI_DATA_IN_SIZE>(timeVal).to_string();
 
-    SimulatorChannelProcessRequest();
+void CanAgentSetMonitorInputDelay(PliFemtoseconds inputDelay)
+{
+    unsigned long long timeVal = static_cast<unsigned long long>(inputDelay.count());
+
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, PLI_CAN_AGNT_MONITOR_SET_INPUT_DELAY);
+    command.SetDataIn(timeVal);
+
+    SimulatorChannelProcessRequest(command);
 }
 
 
 void CanAgentConfigureTxToRxFeedback(bool enable)
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_CAN_AGENT);
-    if (enable)
-        simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_TX_RX_FEEDBACK_ENABLE);
-    else
-        simulator_channel.pli_cmd = std::string(PLI_CAN_AGNT_TX_RX_FEEDBACK_DISABLE);
+    SimulatorCommand command(PLI_DEST_CAN_AGENT, enable ? PLI_CAN_AGNT_TX_RX_FEEDBACK_ENABLE :
+                                                          PLI_CAN_AGNT_TX_RX_FEEDBACK_DISABLE);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 void TestControllerAgentEndTest(bool success)
 {
-    simulator_channel.read_access = false;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_TEST_CONTROLLER_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_TEST_AGNT_TEST_END);
+    SimulatorCommand command(PLI_DEST_TEST_CONTROLLER_AGENT, PLI_TEST_AGNT_TEST_END);
 
-    if (success)
-        simulator_channel.pli_data_in = std::string("1");
-    else
-        simulator_channel.pli_data_in = std::string("0");
+    command.SetDataIn(success ? 1 : 0);
 
-    SimulatorChannelProcessRequest();
+    SimulatorChannelProcessRequest(command);
 }
 
 
-std::chrono::nanoseconds TestControllerAgentGetCfgDutClockPeriod()
+PliFuture<PliFemtoseconds> TestControllerAgentGetCfgDutClockPeriodAsync()
 {
-    unsigned long long readTime;
+    SimulatorCommand command(PLI_DEST_TEST_CONTROLLER_AGENT, PLI_TEST_AGNT_GET_CFG, true);
+    command.SetMessageData("CFG_DUT_CLOCK_PERIOD");
 
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = true;
-    simulator_channel.pli_dest = std::string(PLI_DEST_TEST_CONTROLLER_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_TEST_AGNT_GET_CFG);
-    simulator_channel.pli_message_data = std::string("CFG_DUT_CLOCK_PERIOD");
+    return PliFuture<PliFemtoseconds>(SimulatorChannelPostRead(command),
+                                      PliDataOutFemtoseconds);
+}
 
-    SimulatorChannelProcessRequest();
 
-    readTime = std::strtoll(simulator_channel.pli_data_out.c_str(), nullptr, 2) / 1000000;
-    return std::chrono::nanoseconds(readTime);
+PliFemtoseconds TestControllerAgentGetCfgDutClockPeriod()
+{
+    return TestControllerAgentGetCfgDutClockPeriodAsync().Get();
+}
+
+
+PliFuture<int> TestControllerAgentGetBitTimingElementAsync(std::string elemName)
+{
+    SimulatorCommand command(PLI_DEST_TEST_CONTROLLER_AGENT, PLI_TEST_AGNT_GET_CFG, true);
+    command.SetMessageData(elemName);
+
+    return PliFuture<int>(SimulatorChannelPostRead(command), PliDataOutInt);
 }
 
 
 int TestControllerAgentGetBitTimingElement(std::string elemName)
 {
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = true;
-    simulator_channel.pli_dest = std::string(PLI_DEST_TEST_CONTROLLER_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_TEST_AGNT_GET_CFG);
-    simulator_channel.pli_message_data = elemName;
+    return TestControllerAgentGetBitTimingElementAsync(elemName).Get();
+}
+
 
-    SimulatorChannelProcessRequest();
-    return std::stoi(simulator_channel.pli_data_out.c_str(), nullptr, 2);
+PliFuture<int> TestControllerAgentGetSeedAsync()
+{
+    SimulatorCommand command(PLI_DEST_TEST_CONTROLLER_AGENT, PLI_TEST_AGNT_GET_SEED, true);
+
+    return PliFuture<int>(SimulatorChannelPostRead(command), PliDataOutInt);
 }
 
 
 int TestControllerAgentGetSeed()
 {
-    simulator_channel.read_access = true;
-    simulator_channel.use_msg_data = false;
-    simulator_channel.pli_dest = std::string(PLI_DEST_TEST_CONTROLLER_AGENT);
-    simulator_channel.pli_cmd = std::string(PLI_TEST_AGNT_GET_SEED);
-
-    SimulatorChannelProcessRequest();
-    return std::stoi(simulator_channel.pli_data_out.c_str(), nullptr, 2);
+    return TestControllerAgentGetSeedAsync().Get();
 }
\ No newline at end of file
@@ -14,6 +14,9 @@
 
 #include <chrono>
 #include <atomic>
+#include <string>
+
+#include "SimulatorChannel.hpp"
 
 extern "C" {
     #include "pli_utils.h"
@@ -26,90 +29,90 @@ extern "C" {
 /**
  * @subsection Agent destinations within testbench
  */
-#define PLI_DEST_TEST_CONTROLLER_AGENT (char*)"00000000"
-#define PLI_DEST_CLK_GEN_AGENT         (char*)"00000001"
-#define PLI_DEST_RES_GEN_AGENT         (char*)"00000010"
-#define PLI_DEST_MEM_BUS_AGENT         (char*)"00000011"
-#define PLI_DEST_CAN_AGENT             (char*)"00000100"
+#define PLI_DEST_TEST_CONTROLLER_AGENT 0b00000000
+#define PLI_DEST_CLK_GEN_AGENT         0b00000001
+#define PLI_DEST_RES_GEN_AGENT         0b00000010
+#define PLI_DEST_MEM_BUS_AGENT         0b00000011
+#define PLI_DEST_CAN_AGENT             0b00000100
 
 /**
  * @subsection Reset agent
  */
-#define PLI_RST_AGNT_CMD_ASSERT        (char*)"00000001"
-#define PLI_RST_AGNT_CMD_DEASSERT      (char*)"00000010"
-#define PLI_RST_AGNT_CMD_POLARITY_SET  (char*)"00000011"
-#define PLI_RST_AGNT_CMD_POLARITY_GET  (char*)"00000100"
+#define PLI_RST_AGNT_CMD_ASSERT        0b00000001
+#define PLI_RST_AGNT_CMD_DEASSERT      0b00000010
+#define PLI_RST_AGNT_CMD_POLARITY_SET  0b00000011
+#define PLI_RST_AGNT_CMD_POLARITY_GET  0b00000100
 
 /**
  * @subsection Clock generator agent
  */
-#define PLI_CLK_AGNT_CMD_START        (char*)"00000001"
-#define PLI_CLK_AGNT_CMD_STOP         (char*)"00000010"
-#define PLI_CLK_AGNT_CMD_PERIOD_SET   (char*)"00000011"
-#define PLI_CLK_AGNT_CMD_PERIOD_GET   (char*)"00000100"
-#define PLI_CLK_AGNT_CMD_JITTER_SET   (char*)"00000101"
-#define PLI_CLK_AGNT_CMD_JITTER_GET   (char*)"00000110"
-#define PLI_CLK_AGNT_CMD_DUTY_SET     (char*)"00000111"
-#define PLI_CLK_AGNT_CMD_DUTY_GET     (char*)"00001000"
+#define PLI_CLK_AGNT_CMD_START        0b00000001
+#define PLI_CLK_AGNT_CMD_STOP         0b00000010
+#define PLI_CLK_AGNT_CMD_PERIOD_SET   0b00000011
+#define PLI_CLK_AGNT_CMD_PERIOD_GET   0b00000100
+#define PLI_CLK_AGNT_CMD_JITTER_SET   0b00000101
+#define PLI_CLK_AGNT_CMD_JITTER_GET   0b00000110
+#define PLI_CLK_AGNT_CMD_DUTY_SET     0b00000111
+#define PLI_CLK_AGNT_CMD_DUTY_GET     0b00001000
 
 /**
  * @subsection Memory bus agent
  */
-#define PLI_MEM_BUS_AGNT_START             (char*)"00000001"
-#define PLI_MEM_BUS_AGNT_STOP              (char*)"00000010"
-#define PLI_MEM_BUS_AGNT_WRITE             (char*)"00000011"
-#define PLI_MEM_BUS_AGNT_READ              (char*)"00000100"
-#define PLI_MEM_BUS_AGNT_X_MODE_START      (char*)"00000101"
-#define PLI_MEM_BUS_AGNT_X_MODE_STOP       (char*)"00000110"
-#define PLI_MEM_BUS_AGNT_SET_X_MODE_SETUP  (char*)"00000111"
-#define PLI_MEM_BUS_AGNT_SET_X_MODE_HOLD   (char*)"00001000"
-#define PLI_MEM_BUS_AGNT_SET_PERIOD        (char*)"00001001"
-#define PLI_MEM_BUS_AGNT_SET_OUTPUT_DELAY  (char*)"00001010"
-#define PLI_MEM_BUS_AGNT_WAIT_DONE         (char*)"00001011"
+#define PLI_MEM_BUS_AGNT_START             0b00000001
+#define PLI_MEM_BUS_AGNT_STOP              0b00000010
+#define PLI_MEM_BUS_AGNT_WRITE             0b00000011
+#define PLI_MEM_BUS_AGNT_READ              0b00000100
+#define PLI_MEM_BUS_AGNT_X_MODE_START      0b00000101
+#define PLI_MEM_BUS_AGNT_X_MODE_STOP       0b00000110
+#define PLI_MEM_BUS_AGNT_SET_X_MODE_SETUP  0b00000111
+#define PLI_MEM_BUS_AGNT_SET_X_MODE_HOLD   0b00001000
+#define PLI_MEM_BUS_AGNT_SET_PERIOD        0b00001001
+#define PLI_MEM_BUS_AGNT_SET_OUTPUT_DELAY  0b00001010
+#define PLI_MEM_BUS_AGNT_WAIT_DONE         0b00001011
 
 /**
  * @subsection CAN agent
  */
-#define PLI_CAN_AGNT_DRIVER_START                  (char*)"00000001"
-#define PLI_CAN_AGNT_DRIVER_STOP                   (char*)"00000010"
-#define PLI_CAN_AGNT_DRIVER_FLUSH                  (char*)"00000011"
-#define PLI_CAN_AGNT_DRIVER_GET_PROGRESS           (char*)"00000100"
-#define PLI_CAN_AGNT_DRIVER_GET_DRIVEN_VAL         (char*)"00000101"
-#define PLI_CAN_AGNT_DRIVER_PUSH_ITEM              (char*)"00000110"
-#define PLI_CAN_AGNT_DRIVER_SET_WAIT_TIMEOUT       (char*)"00000111"
-#define PLI_CAN_AGNT_DRIVER_WAIT_FINISH            (char*)"00001000"
-#define PLI_CAN_AGNT_DRIVER_DRIVE_SINGLE_ITEM      (char*)"00001001"
-#define PLI_CAN_AGNT_DRIVER_DRIVE_ALL_ITEM         (char*)"00001010"
+#define PLI_CAN_AGNT_DRIVER_START                  0b00000001
+#define PLI_CAN_AGNT_DRIVER_STOP                   0b00000010
+#define PLI_CAN_AGNT_DRIVER_FLUSH                  0b00000011
+#define PLI_CAN_AGNT_DRIVER_GET_PROGRESS           0b00000100
+#define PLI_CAN_AGNT_DRIVER_GET_DRIVEN_VAL         0b00000101
+#define PLI_CAN_AGNT_DRIVER_PUSH_ITEM              0b00000110
+#define PLI_CAN_AGNT_DRIVER_SET_WAIT_TIMEOUT       0b00000111
+#define PLI_CAN_AGNT_DRIVER_WAIT_FINISH            0b00001000
+#define PLI_CAN_AGNT_DRIVER_DRIVE_SINGLE_ITEM      0b00001001
+#define PLI_CAN_AGNT_DRIVER_DRIVE_ALL_ITEM         0b00001010
 
-#define PLI_CAN_AGNT_MONITOR_START                 (char*)"00001011"
-#define PLI_CAN_AGNT_MONITOR_STOP                  (char*)"00001100"
-#define PLI_CAN_AGNT_MONITOR_FLUSH                 (char*)"00001101"
-#define PLI_CAN_AGNT_MONITOR_GET_STATE             (char*)"00001110"
-#define PLI_CAN_AGNT_MONITOR_GET_MONITORED_VAL     (char*)"00001111"
-#define PLI_CAN_AGNT_MONITOR_PUSH_ITEM             (char*)"00010000"
-#define PLI_CAN_AGNT_MONITOR_SET_WAIT_TIMEOUT      (char*)"00010001"
-#define PLI_CAN_AGNT_MONITOR_WAIT_FINISH           (char*)"00010010"
-#define PLI_CAN_AGNT_MONITOR_MONITOR_SINGLE_ITEM   (char*)"00010011"
-#define PLI_CAN_AGNT_MONITOR_MONITOR_ALL_ITEMS     (char*)"00010100"
+#define PLI_CAN_AGNT_MONITOR_START                 0b00001011
+#define PLI_CAN_AGNT_MONITOR_STOP                  0b00001100
+#define PLI_CAN_AGNT_MONITOR_FLUSH                 0b00001101
+#define PLI_CAN_AGNT_MONITOR_GET_STATE             0b00001110
+#define PLI_CAN_AGNT_MONITOR_GET_MONITORED_VAL     0b00001111
+#define PLI_CAN_AGNT_MONITOR_PUSH_ITEM             0b00010000
+#define PLI_CAN_AGNT_MONITOR_SET_WAIT_TIMEOUT      0b00010001
+#define PLI_CAN_AGNT_MONITOR_WAIT_FINISH           0b00010010
+#define PLI_CAN_AGNT_MONITOR_MONITOR_SINGLE_ITEM   0b00010011
+#define PLI_CAN_AGNT_MONITOR_MONITOR_ALL_ITEMS     0b00010100
 
-#define PLI_CAN_AGNT_MONITOR_SET_TRIGGER           (char*)"00010101"
-#define PLI_CAN_AGNT_MONITOR_GET_TRIGGER           (char*)"00010110"
+#define PLI_CAN_AGNT_MONITOR_SET_TRIGGER           0b00010101
+#define PLI_CAN_AGNT_MONITOR_GET_TRIGGER           0b00010110
 
-#define PLI_CAN_AGNT_MONITOR_CHECK_RESULT          (char*)"00011001"
+#define PLI_CAN_AGNT_MONITOR_CHECK_RESULT          0b00011001
 
-#define PLI_CAN_AGNT_MONITOR_SET_INPUT_DELAY       (char*)"00011010"
+#define PLI_CAN_AGNT_MONITOR_SET_INPUT_DELAY       0b00011010
 
-#define PLI_CAN_AGNT_TX_RX_FEEDBACK_ENABLE         (char*)"00011011"
-#define PLI_CAN_AGNT_TX_RX_FEEDBACK_DISABLE        (char*)"00011100"
+#define PLI_CAN_AGNT_TX_RX_FEEDBACK_ENABLE         0b00011011
+#define PLI_CAN_AGNT_TX_RX_FEEDBACK_DISABLE        0b00011100
 
-#define PLI_CAN_AGNT_CMD_SET_WAIT_FOR_MONITOR      (char*)"00011101"
+#define PLI_CAN_AGNT_CMD_SET_WAIT_FOR_MONITOR      0b00011101
 
 /**
  * @subsection Test controller bus agent
  */
-#define PLI_TEST_AGNT_TEST_END                     (char*)"00000001"
-#define PLI_TEST_AGNT_GET_CFG                      (char*)"00000010"
-#define PLI_TEST_AGNT_GET_SEED                     (char*)"00000011"
+#define PLI_TEST_AGNT_TEST_END                     0b00000001
+#define PLI_TEST_AGNT_GET_CFG                      0b00000010
+#define PLI_TEST_AGNT_GET_SEED                     0b00000011
 
 /**
  * @enum CAN Agent Monitor State.
@@ -182,10 +185,59 @@ enum class CanAgentMonitorTrigger
      DriverStop
 };
 
+
+/**
+ * Time in femtoseconds (time unit of GHDL, NVC and loopback simulator). Items of
+ * CAN agent are passed to simulator in this unit, so that clock periods which are
+ * not whole nanoseconds are not truncated.
+ */
+typedef std::chrono::duration<int64_t, std::femto> PliFemtoseconds;
+
+
+/**
+ * @class PliFuture
+ *
+ * Result of read request which was issued to simulator, but which was not
+ * necessarily processed yet. Several read requests can be in flight, "Get"
+ * waits till simulator processes the request, and returns data it read.
+ *
+ * Result shall be taken before SIMULATOR_CHANNEL_QUEUE_DEPTH further requests
+ * are issued to simulator (e.g. not held over pushing of test sequence to CAN
+ * agent). "Get" of overwritten result aborts the test.
+ *
+ * @tparam T Type of result
+ */
+template <typename T>
+class PliFuture
+{
+    public:
+        PliFuture(uint64_t seq, T (*decode)(const PliWord &data)):
+            seq_(seq), decode_(decode) {}
+
+        /**
+         * Waits till simulator processes the request.
+         * @returns Result of the request.
+         */
+        T Get() const
+        {
+            return decode_(SimulatorChannelGetReadData(seq_));
+        }
+
+    private:
+        /* Sequence number of request in Simulator Channel */
+        uint64_t seq_;
+
+        /* Converts "pli_data_out" to result */
+        T (*decode_)(const PliWord &data);
+};
+
+
 /**
  * @note All below mentioned functions are "blocking" from callers perspective
  *       Therefore they return only once the action they cause is finished
- *       inside simulation.
+ *       inside simulation. Exceptions are functions which only queue an action
+ *       (noted in their description), and functions with "Async" suffix which
+ *       return "PliFuture" of data they read.
  */
 
 /******************************************************************************
@@ -261,6 +313,15 @@ void ClockAgentStop();
 void ClockAgentSetPeriod(std::chrono::nanoseconds clock_period);
 
 
+/**
+ * @ingroup clockGeneratorAgent
+ *
+ * @brief Set clock generator agent period
+ * @param clock_period Period to be set (femtoseconds).
+ */
+void ClockAgentSetPeriod(PliFemtoseconds clock_period);
+
+
 /**
  * @ingroup clockGeneratorAgent
  *
@@ -334,6 +395,7 @@ void MemBusAgentStop();
  * @brief Execute 32-bit write by Memory bus agent.
  * @param address Address to write into (Must be 4 bytes aligned).
  * @param data Data to be written.
+ * @note Write is queued, function does not wait until simulator executes it.
  */
 void MemBusAgentWrite32(int address, uint32_t data);
 
@@ -344,6 +406,7 @@ void MemBusAgentWrite32(int address, uint32_t data);
  * @brief Execute 16-bit write by Memory bus agent.
  * @param address Address to write into (Must be 2 bytes aligned).
  * @param data Data to be written.
+ * @note Write is queued, function does not wait until simulator executes it.
  */
 void MemBusAgentWrite16(int address, uint16_t data);
 
@@ -354,6 +417,7 @@ void MemBusAgentWrite16(int address, uint16_t data);
  * @brief Execute 8-bit write by Memory bus agent.
  * @param address Address to write into.
  * @param data Data to be written.
+ * @note Write is queued, function does not wait until simulator executes it.
  */
 void MemBusAgentWrite8(int address, uint8_t data);
 
@@ -368,6 +432,16 @@ void MemBusAgentWrite8(int address, uint8_t data);
 uint32_t MemBusAgentRead32(int address);
 
 
+/**
+ * @ingroup memBusAgent
+ *
+ * @brief Issue 32-bit read by Memory bus agent, without waiting for its data.
+ * @param address Address to read from (Must be 4 bytes aligned).
+ * @return Future of data read by Memory bus agent.
+ */
+PliFuture<uint32_t> MemBusAgentRead32Async(int address);
+
+
 /**
  * @ingroup memBusAgent
  *
@@ -378,6 +452,16 @@ uint32_t MemBusAgentRead32(int address);
 uint16_t MemBusAgentRead16(int address);
 
 
+/**
+ * @ingroup memBusAgent
+ *
+ * @brief Issue 16-bit read by Memory bus agent, without waiting for its data.
+ * @param address Address to read from (Must be 2 bytes aligned).
+ * @return Future of data read by Memory bus agent.
+ */
+PliFuture<uint16_t> MemBusAgentRead16Async(int address);
+
+
 /**
  * @ingroup memBusAgent
  *
@@ -388,6 +472,16 @@ uint16_t MemBusAgentRead16(int address);
 uint8_t MemBusAgentRead8(int address);
 
 
+/**
+ * @ingroup memBusAgent
+ *
+ * @brief Issue 8-bit read by Memory bus agent, without waiting for its data.
+ * @param address Address to read from.
+ * @return Future of data read by Memory bus agent.
+ */
+PliFuture<uint8_t> MemBusAgentRead8Async(int address);
+
+
 /**
  * @ingroup memBusAgent
  *
@@ -484,6 +578,15 @@ void CanAgentDriverFlush();
 bool CanAgentDriverGetProgress();
 
 
+/**
+ * @ingroup canAgent
+ *
+ * @brief Issue check if CAN agent driver is driving, without waiting for result.
+ * @return Future of driving in progress.
+ */
+PliFuture<bool> CanAgentDriverGetProgressAsync();
+
+
 /**
  * @ingroup canAgent
  *
@@ -500,6 +603,7 @@ char CanAgentDriverGetDrivenVal();
  * @param driven_value Logic value corresponding to this item. (This value is
  *                    driven on "can_rx").
  * @param duration Time duration for which this value is driven.
+ * @note Item is queued, function does not wait until simulator processes it.
  */
 void CanAgentDriverPushItem(char driven_value, std::chrono::nanoseconds duration);
 
@@ -513,10 +617,41 @@ void CanAgentDriverPushItem(char driven_value, std::chrono::nanoseconds duration
  * @param duration Time duration for which this value is driven.
  * @param msg Message which will be printed in simulator when CAN Agent driver
  *            starts driving this value.
+ * @note Item is queued, function does not wait until simulator processes it.
  */
 void CanAgentDriverPushItem(char driven_value, std::chrono::nanoseconds duration, std::string msg);
 
 
+/**
+ * @ingroup canAgent
+ *
+ * @brief Insert item to CAN agent driver FIFO.
+ * @param driven_value Logic value corresponding to this item. (This value is
+ *                    driven on "can_rx").
+ * @param duration Time duration for which this value is driven.
+ * @param msg_id Id of message (see SimulatorChannelInternMessage) which will be
+ *               printed in simulator when CAN Agent driver starts driving this value.
+ * @note Item is queued, function does not wait until simulator processes it.
+ */
+void CanAgentDriverPushItem(char driven_value, std::chrono::nanoseconds duration,
+                            PliMessageId msg_id);
+
+
+/**
+ * @ingroup canAgent
+ *
+ * @brief Insert item to CAN agent driver FIFO.
+ * @param driven_value Logic value corresponding to this item. (This value is
+ *                    driven on "can_rx").
+ * @param duration Time duration (femtoseconds) for which this value is driven.
+ * @param msg_id Id of message (see SimulatorChannelInternMessage) which will be
+ *               printed in simulator when CAN Agent driver starts driving this
+ *               value, PLI_MESSAGE_NONE if item has no message.
+ * @note Item is queued, function does not wait until simulator processes it.
+ */
+void CanAgentDriverPushItem(char driven_value, PliFemtoseconds duration, PliMessageId msg_id);
+
+
 /**
  * @ingroup canAgent
  *
@@ -614,6 +749,15 @@ void CanAgentMonitorFlush();
 CanAgentMonitorState CanAgentMonitorGetState();
 
 
+/**
+ * @ingroup canAgent
+ *
+ * @brief Issue read of Monitor state, without waiting for result.
+ * @return Future of monitor state.
+ */
+PliFuture<CanAgentMonitorState> CanAgentMonitorGetStateAsync();
+
+
 /**
  * @ingroup canAgent
  *
@@ -630,6 +774,7 @@ char CanAgentMonitorGetMonitoredVal();
  * @param monitor_value Value to be monitored
  * @param duration Time for which monitor_value is monitored.
  * @param sample_rate Sample rate used to check this item during monitoring.
+ * @note Item is queued, function does not wait until simulator processes it.
  */
 void CanAgentMonitorPushItem(char monitor_value, std::chrono::nanoseconds duration,
                              std::chrono::nanoseconds sample_rate);
@@ -642,11 +787,42 @@ void CanAgentMonitorPushItem(char monitor_value, std::chrono::nanoseconds durati
  * @param monitor_value Value to be monitored
  * @param duration Time for which monitor_value is monitored.
  * @param msg Message to be printed when monitoring of this item starts.
+ * @note Item is queued, function does not wait until simulator processes it.
  */
 void CanAgentMonitorPushItem(char monitor_value, std::chrono::nanoseconds duration,
                              std::chrono::nanoseconds sample_rate, std::string msg);
 
 
+/**
+ * @ingroup canAgent
+ *
+ * @brief Insert Item to Monitor FIFO.
+ * @param monitor_value Value to be monitored
+ * @param duration Time for which monitor_value is monitored.
+ * @param msg_id Id of message (see SimulatorChannelInternMessage) to be printed
+ *               when monitoring of this item starts.
+ * @note Item is queued, function does not wait until simulator processes it.
+ */
+void CanAgentMonitorPushItem(char monitor_value, std::chrono::nanoseconds duration,
+                             std::chrono::nanoseconds sample_rate, PliMessageId msg_id);
+
+
+/**
+ * @ingroup canAgent
+ *
+ * @brief Insert Item to Monitor FIFO.
+ * @param monitor_value Value to be monitored
+ * @param duration Time (femtoseconds) for which monitor_value is monitored.
+ * @param sample_rate Sample rate (femtoseconds) used to check this item.
+ * @param msg_id Id of message (see SimulatorChannelInternMessage) to be printed
+ *               when monitoring of this item starts, PLI_MESSAGE_NONE if item has
+ *               no message.
+ * @note Item is queued, function does not wait until simulator processes it.
+ */
+void CanAgentMonitorPushItem(char monitor_value, PliFemtoseconds duration,
+                             PliFemtoseconds sample_rate, PliMessageId msg_id);
+
+
 /**
  * @ingroup canAgent
  *
@@ -746,6 +922,15 @@ void CanAgentCheckResult();
 void CanAgentSetMonitorInputDelay(std::chrono::nanoseconds input_delay);
 
 
+/**
+ * @ingroup canAgent
+ *
+ * @brief Set Monitor input delay (see above).
+ * @param input_delay Input delay to set (femtoseconds).
+ */
+void CanAgentSetMonitorInputDelay(PliFemtoseconds input_delay);
+
+
 /**
  * @ingroup canAgent
  *
@@ -777,21 +962,41 @@ void TestControllerAgentEndTest(bool success);
 /**
  * @ingroup testControllerAgent
  *
- * @brief
- * @return
+ * @brief Gets clock period of DUT configured in TB.
+ * @return Clock period of DUT (femtoseconds, not truncated to nanoseconds).
  */
-std::chrono::nanoseconds TestControllerAgentGetCfgDutClockPeriod();
+PliFemtoseconds TestControllerAgentGetCfgDutClockPeriod();
 
 
 /**
  * @ingroup testControllerAgent
  *
- * @brief
- * @return
+ * @brief Issue read of clock period of DUT, without waiting for result.
+ * @return Future of clock period of DUT.
+ */
+PliFuture<PliFemtoseconds> TestControllerAgentGetCfgDutClockPeriodAsync();
+
+
+/**
+ * @ingroup testControllerAgent
+ *
+ * @brief Gets bit timing element configured in TB.
+ * @param elem_name Name of TB generic (e.g. "CFG_DUT_BRP").
+ * @return Value of bit timing element.
  */
 int TestControllerAgentGetBitTimingElement(std::string elem_name);
 
 
+/**
+ * @ingroup testControllerAgent
+ *
+ * @brief Issue read of bit timing element, without waiting for result.
+ * @param elem_name Name of TB generic (e.g. "CFG_DUT_BRP").
+ * @return Future of value of bit timing element.
+ */
+PliFuture<int> TestControllerAgentGetBitTimingElementAsync(std::string elem_name);
+
+
 /**
  * @ingroup testControllerAgent
  *
@@ -801,4 +1006,13 @@ int TestControllerAgentGetBitTimingElement(std::string elem_name);
 int TestControllerAgentGetSeed();
 
 
+/**
+ * @ingroup testControllerAgent
+ *
+ * @brief Issue read of seed used by digital simulator, without waiting for result.
+ * @returns Future of seed within VHDL TB
+ */
+PliFuture<int> TestControllerAgentGetSeedAsync();
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,223 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Tool for sequence files (see SequenceFile).
+ *
+ * Usage:
+ *  seqtool dump <file>             Prints header, messages and items of file.
+ *  seqtool diff <file_a> <file_b>  Prints differences of two files.
+ *  seqtool replay <file> [seed]    Drives and monitors sequence in loopback
+ *                                  simulator.
+ *
+ * Exit code is 0 if files are equal / replay passed, 1 otherwise, 2 on error.
+ *
+ * Replay in HDL simulator (GHDL, VCS, NVC) is done by running test "replay"
+ * with "COMPLIANCE_SEQUENCE_FILE" environment variable set to the file.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <pli_lib.h>
+#include <test_lib.h>
+
+#include "LoopbackSimulator.hpp"
+
+using namespace test;
+
+static const char *replay_test_name = "replay";
+static TestSequence *replay_sequence = nullptr;
+static std::thread replay_thread;
+
+
+static void Usage(const char *name)
+{
+    std::cerr << "Usage: " << name << " dump <file>" << std::endl;
+    std::cerr << "       " << name << " diff <file_a> <file_b>" << std::endl;
+    std::cerr << "       " << name << " replay <file> [seed]" << std::endl;
+}
+
+
+static int Dump(const char *path)
+{
+    SequenceFile file;
+    if (!file.Open(path))
+        return 2;
+
+    TestSequence sequence(file.GetClockPeriod());
+    file.Read(sequence);
+
+    std::cout << "File:           " << path << " (" << file.GetSize() << " bytes)" << std::endl;
+    std::cout << "Clock period:   " << file.GetClockPeriod().count() << " fs" << std::endl;
+    std::cout << "Messages:       " << file.GetNumMessages() << std::endl;
+    std::cout << "Driver items:   " << file.GetNumDriverItems() << std::endl;
+    std::cout << "Monitor items:  " << file.GetNumMonitorItems() << std::endl;
+
+    std::cout << std::endl << "Driven sequence:" << std::endl;
+    sequence.Print(true);
+    std::cout << std::endl << "Monitored sequence:" << std::endl;
+    sequence.Print(false);
+
+    return 0;
+}
+
+
+/**
+ * Prints differing item of driver or monitor sequence.
+ */
+template<typename T>
+static void PrintDiff(const char *kind, size_t index, T *item_a, T *item_b)
+{
+    std::cout << kind << " item " << index << ":" << std::endl << " < ";
+    if (item_a != nullptr)
+        item_a->Print();
+    else
+        std::cout << "<none>" << std::endl;
+    std::cout << " > ";
+    if (item_b != nullptr)
+        item_b->Print();
+    else
+        std::cout << "<none>" << std::endl;
+}
+
+
+static int Diff(const char *path_a, const char *path_b)
+{
+    SequenceFile file_a;
+    SequenceFile file_b;
+    if (!file_a.Open(path_a) || !file_b.Open(path_b))
+        return 2;
+
+    if (file_a.GetClockPeriod() != file_b.GetClockPeriod())
+        std::cout << "Clock period: " << file_a.GetClockPeriod().count() << " fs / "
+                  << file_b.GetClockPeriod().count() << " fs" << std::endl;
+
+    TestSequence seq_a(file_a.GetClockPeriod());
+    TestSequence seq_b(file_b.GetClockPeriod());
+    file_a.Read(seq_a);
+    file_b.Read(seq_b);
+
+    size_t n_diffs = 0;
+    size_t n_items = std::max(seq_a.GetNumDriverItems(), seq_b.GetNumDriverItems());
+    for (size_t i = 0; i < n_items; i++)
+    {
+        DrvItem *item_a = seq_a.GetDriverItem(static_cast<int>(i));
+        DrvItem *item_b = seq_b.GetDriverItem(static_cast<int>(i));
+        if (item_a != nullptr && item_b != nullptr &&
+            item_a->value_ == item_b->value_ && item_a->cycles_ == item_b->cycles_ &&
+            item_a->message_id_ == item_b->message_id_)
+            continue;
+        PrintDiff("Driver", i, item_a, item_b);
+        n_diffs++;
+    }
+
+    n_items = std::max(seq_a.GetNumMonitorItems(), seq_b.GetNumMonitorItems());
+    for (size_t i = 0; i < n_items; i++)
+    {
+        MonItem *item_a = seq_a.GetMonitorItem(static_cast<int>(i));
+        MonItem *item_b = seq_b.GetMonitorItem(static_cast<int>(i));
+        if (item_a != nullptr && item_b != nullptr &&
+            item_a->value_ == item_b->value_ && item_a->cycles_ == item_b->cycles_ &&
+            item_a->sample_cycles_ == item_b->sample_cycles_ &&
+            item_a->message_id_ == item_b->message_id_)
+            continue;
+        PrintDiff("Monitor", i, item_a, item_b);
+        n_diffs++;
+    }
+
+    if (file_a.GetClockPeriod() != file_b.GetClockPeriod())
+        n_diffs++;
+
+    std::cout << n_diffs << " differences" << std::endl;
+
+    return (n_diffs > 0) ? 1 : 0;
+}
+
+
+static void RunReplay()
+{
+    ClockAgentSetPeriod(replay_sequence->GetClockPeriod());
+    CanAgentMonitorSetTrigger(CanAgentMonitorTrigger::DriverStart);
+
+    replay_sequence->PushDriverValuesToSimulator();
+    replay_sequence->PushMonitorValuesToSimulator();
+    CanAgentMonitorStart();
+    CanAgentDriverStart();
+    CanAgentMonitorWaitFinish();
+    CanAgentDriverWaitFinish();
+
+    bool passed = (CanAgentMonitorGetState() == CanAgentMonitorState::Passed);
+    CanAgentMonitorStop();
+    TestControllerAgentEndTest(passed);
+}
+
+
+/**
+ * Called by PLI library once loopback simulator passes control to test.
+ */
+extern "C" void RunCppTest(char *test_name)
+{
+    if (strcmp(test_name, replay_test_name) == 0)
+        replay_thread = std::thread(RunReplay);
+}
+
+
+static int Replay(const char *path, int seed)
+{
+    SequenceFile file;
+    if (!file.Open(path))
+        return 2;
+
+    TestSequence sequence(file.GetClockPeriod());
+    file.Read(sequence);
+    replay_sequence = &sequence;
+
+    LoopbackConfig config;
+    config.seed = seed;
+    LoopbackResult result = LoopbackSimulatorRun(replay_test_name, config);
+    if (replay_thread.joinable())
+        replay_thread.join();
+
+    return (result.test_ended && result.passed) ? 0 : 1;
+}
+
+
+int main(int argc, char *argv[])
+{
+    if (argc == 3 && strcmp(argv[1], "dump") == 0)
+        return Dump(argv[2]);
+    if (argc == 4 && strcmp(argv[1], "diff") == 0)
+        return Diff(argv[2], argv[3]);
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "replay") == 0)
+        return Replay(argv[2], (argc == 4) ? std::atoi(argv[3]) : 0);
+
+    Usage(argv[0]);
+    return 2;
+}
@@ -26,10 +26,9 @@
  *
  *****************************************************************************/
 
-#include <unistd.h>
 #include <stdlib.h>
+#include <assert.h>
 #include <atomic>
-#include <bitset>
 
 #include "SimulatorChannel.hpp"
 #include "PliComplianceLib.hpp"
@@ -39,167 +38,368 @@ extern "C" {
 }
 
 
-SimulatorChannel simulator_channel
+SimulatorChannel simulator_channel;
+
+
+SimulatorCommand::SimulatorCommand(uint8_t dest, uint8_t cmd, bool read_access):
+    pli_dest(dest),
+    pli_cmd(cmd),
+    pli_message_id(PLI_MESSAGE_NONE),
+    read_access(read_access)
+{}
+
+
+void SimulatorCommand::SetDataIn(uint64_t data)
+{
+    pli_data_in = PliWord{data, 0};
+}
+
+
+void SimulatorCommand::SetDataIn(const PliWord &data)
+{
+    pli_data_in = data;
+}
+
+
+void SimulatorCommand::SetDataIn2(uint64_t data)
+{
+    pli_data_in_2 = PliWord{data, 0};
+}
+
+
+void SimulatorCommand::SetMessageData(const std::string &msg)
 {
-    ATOMIC_VAR_INIT(SimulatorChannelFsm::FREE),     // fsm
+    pli_message_id = SimulatorChannelInternMessage(msg);
+}
+
+
+void SimulatorCommand::SetMessageData(PliMessageId msg_id)
+{
+    pli_message_id = msg_id;
+}
 
-    "",                                             // pli_dest
-    "",                                             // pli_cmd
-    "",                                             // pli_data_in
-    "",                                             // pli_data_in_2
-    "",                                             // pli_data_out
-    "",                                             // pli_message_data
 
-    ATOMIC_VAR_INIT(false),                         // read access
-    ATOMIC_VAR_INIT(false),                         // use_msg_data
+static inline void CpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
 
-    ATOMIC_VAR_INIT(false),                         // req
-};
 
-static std::string PliWord(int width, std::string input)
+/**
+ * Waits until simulator processes given number of commands. Spins first, then parks
+ * until simulator wakes the test up (see SimulatorChannelNotify).
+ * @param target Number of processed commands to wait for
+ */
+static void SimulatorChannelWait(uint64_t target)
 {
-    std::string rv = std::string(width, '0');
+    if (simulator_channel.processed.load() >= target)
+        return;
+
+    simulator_channel.n_waits++;
+    for (size_t i = 0; i < simulator_channel.spin_budget; i++)
+    {
+        CpuRelax();
+        if (simulator_channel.processed.load() >= target) {
+            simulator_channel.n_spin_waits++;
+            return;
+        }
+    }
+
+    simulator_channel.n_park_waits++;
+    std::unique_lock<std::mutex> lock(simulator_channel.wait_mutex);
+    simulator_channel.wake_at.store(target);
+    simulator_channel.wait_cv.wait(lock, [target]() {
+        return simulator_channel.processed.load() >= target;
+    });
+    simulator_channel.wake_at.store(UINT64_MAX);
+}
 
-    for (size_t i = 0; i < input.length(); i++)
-        rv[width - i - 1] = input[input.length() - i - 1];
 
-    return rv;
+/**
+ * Counts command as processed, and wakes up test if it is parked and waits for this
+ * command. Called by simulator after it finished a command.
+ */
+static void SimulatorChannelNotify()
+{
+    // Both "processed" and "wake_at" are sequentially consistent. Either test sees
+    // the command processed before it parks, or simulator sees test parked.
+    uint64_t processed = simulator_channel.processed.fetch_add(1) + 1;
+    if (processed < simulator_channel.wake_at.load())
+        return;
+
+    std::lock_guard<std::mutex> lock(simulator_channel.wait_mutex);
+    simulator_channel.wait_cv.notify_one();
 }
 
-void SimulatorChannelStartRequest()
+
+void SimulatorChannelPostRequest(const SimulatorCommand &command)
 {
-    std::atomic_thread_fence(std::memory_order_seq_cst);
-    simulator_channel.req.store(true);
+    // When queue is full, wait till simulator processes half of it, so that test does
+    // not wake up for each processed command.
+    if (!simulator_channel.queue.TryPush(command))
+    {
+        SimulatorChannelWait(simulator_channel.issued - SIMULATOR_CHANNEL_QUEUE_DEPTH / 2);
+        simulator_channel.queue.TryPush(command);
+    }
+    simulator_channel.issued++;
 }
 
 
 void SimulatorChannelWaitRequestDone()
 {
-    std::atomic_thread_fence(std::memory_order_seq_cst);
-    while (simulator_channel.req.load())
-        usleep(100);
+    SimulatorChannelWait(simulator_channel.issued);
 }
 
 
-void SimulatorChannelProcessRequest()
+void SimulatorChannelProcessRequest(const SimulatorCommand &command)
 {
-    SimulatorChannelStartRequest();
+    SimulatorChannelPostRequest(command);
     SimulatorChannelWaitRequestDone();
 }
 
 
+uint64_t SimulatorChannelPostRead(const SimulatorCommand &command)
+{
+    uint64_t seq = simulator_channel.issued;
+
+    SimulatorChannelPostRequest(command);
+    return seq;
+}
+
+
+PliWord SimulatorChannelGetReadData(uint64_t seq)
+{
+    SimulatorChannelWait(seq + 1);
+
+    const SimulatorReadData &read_data =
+        simulator_channel.read_data[seq % SIMULATOR_CHANNEL_QUEUE_DEPTH];
+
+    // Checked also in release build, returning data of other request would pass
+    // unnoticed.
+    if (read_data.seq != seq) {
+        std::cerr << "Simulator Channel: data of read request " << seq
+                  << " were overwritten by later requests!" << std::endl;
+        std::abort();
+    }
+
+    return read_data.data;
+}
+
+
+PliWord SimulatorChannelProcessRead(const SimulatorCommand &command)
+{
+    return SimulatorChannelGetReadData(SimulatorChannelPostRead(command));
+}
+
+
 bool SimulatorChannelIsRequestPending()
 {
-    return simulator_channel.req.load();
+    return !simulator_channel.queue.Empty();
 }
 
 
-void SimulatorChannelClearRequest()
+void SimulatorChannelSetSpinBudget(size_t spin_budget)
 {
-    simulator_channel.req.store(false);
+    simulator_channel.spin_budget = spin_budget;
 }
 
 
-void ProcessPliClkCallback()
+void SimulatorChannelSetMaxBatch(size_t max_batch)
 {
-    std::atomic<bool> req;
-    char pli_read_data[2 * PLI_DATA_OUT_SIZE];
-    char pli_ack[128];
+    simulator_channel.max_batch = (max_batch > 0) ? max_batch : 1;
+}
 
-    // Check if there is hanging request on SimulatorChannel!
-    std::atomic_thread_fence(std::memory_order_seq_cst);
-    req.store(SimulatorChannelIsRequestPending());
-    std::atomic_thread_fence(std::memory_order_seq_cst);
 
-    //
-    // Callback cannot poll on PLI hanshake since it is blocking for digital
-    // simulator! Therefore Callback is processed as automata!
-    //
-    switch (simulator_channel.fsm.load())
-    {
-        case SimulatorChannelFsm::FREE:
-            if (req.load())
-            {
-                pli_drive_str_value(
-                    PLI_SIGNAL_DEST,
-                    PliWord(PLI_DEST_SIZE, simulator_channel.pli_dest).c_str());
+SimulatorChannelStats SimulatorChannelGetStats()
+{
+    return SimulatorChannelStats{simulator_channel.n_waits,
+                                 simulator_channel.n_spin_waits,
+                                 simulator_channel.n_park_waits,
+                                 simulator_channel.n_callbacks};
+}
 
-                pli_drive_str_value(
-                    PLI_SIGNAL_CMD,
-                    PliWord(PLI_CMD_SIZE, simulator_channel.pli_cmd).c_str());
 
-                pli_drive_str_value(
-                    PLI_SIGNAL_DATA_IN,
-                    PliWord(PLI_DATA_IN_SIZE, simulator_channel.pli_data_in).c_str());
+PliMessageId SimulatorChannelInternMessage(const std::string &msg)
+{
+    SimulatorMessageTable &table = simulator_channel.messages;
+    std::string key = msg.substr(0, PLI_STR_BUF_MAX_MSG_LEN);
 
-                pli_drive_str_value(
-                    PLI_SIGNAL_DATA_IN_2,
-                    PliWord(PLI_DATA_IN_2_SIZE, simulator_channel.pli_data_in_2).c_str());
+    if (key.empty())
+        return PLI_MESSAGE_NONE;
 
-                if (simulator_channel.use_msg_data)
-                {
-                    // Pad by spaces
-                    std::string space_paded = std::string(PLI_STR_BUF_MAX_MSG_LEN, ' ');
-                    for (size_t i = 0; i < simulator_channel.pli_message_data.length(); i++)
-                        space_paded[i] = simulator_channel.pli_message_data[i];
+    std::lock_guard<std::mutex> lock(table.mutex);
 
-                    // Convert to ASCII encoding
-                    std::string vector = "";
-                    for (size_t i = 0; i < space_paded.length(); i++)
-                        vector.append(std::bitset<8>(space_paded.at(i)).to_string());
+    auto it = table.ids.find(key);
+    if (it != table.ids.end())
+        return it->second;
 
-                    // No need to pad anymore
-                    pli_drive_str_value(PLI_SIGNAL_STR_BUF_IN, vector.c_str());
-                }
+    // Message with id PLI_MESSAGE_NONE is empty
+    if (table.size == 0)
+        table.size = 1;
 
-                std::atomic_thread_fence(std::memory_order_acquire);
+    size_t max_size = SIMULATOR_CHANNEL_MSG_CHUNK_SIZE * SIMULATOR_CHANNEL_MSG_MAX_CHUNKS;
+    if (table.size >= max_size)
+        return PLI_MESSAGE_NONE;
 
-                pli_drive_str_value(
-                    PLI_SIGNAL_REQ, std::string("1").c_str());
+    std::unique_ptr<std::string[]> &chunk =
+        table.chunks[table.size / SIMULATOR_CHANNEL_MSG_CHUNK_SIZE];
+    if (!chunk)
+        chunk.reset(new std::string[SIMULATOR_CHANNEL_MSG_CHUNK_SIZE]);
 
-                simulator_channel.fsm.store(SimulatorChannelFsm::REQ_UP);
-                std::atomic_thread_fence(std::memory_order_acquire);
-            }
-            break;
+    PliMessageId msg_id = static_cast<PliMessageId>(table.size++);
+    chunk[msg_id % SIMULATOR_CHANNEL_MSG_CHUNK_SIZE] = key;
+    table.ids.emplace(std::move(key), msg_id);
 
-        case SimulatorChannelFsm::REQ_UP:
-            memset(pli_ack, 0, sizeof(pli_ack));
-            pli_read_str_value(PLI_SIGNAL_ACK, pli_ack);
+    return msg_id;
+}
+
+
+const std::string& SimulatorChannelGetMessage(PliMessageId msg_id)
+{
+    static const std::string empty_msg;
+    const std::unique_ptr<std::string[]> &chunk =
+        simulator_channel.messages.chunks[msg_id / SIMULATOR_CHANNEL_MSG_CHUNK_SIZE];
+
+    if (msg_id == PLI_MESSAGE_NONE || !chunk)
+        return empty_msg;
+    return chunk[msg_id % SIMULATOR_CHANNEL_MSG_CHUNK_SIZE];
+}
+
+
+/**
+ * Drives command on PLI signals of TB and issues request.
+ */
+static void DriveCommand(const SimulatorCommand &command)
+{
+    pli_drive_word_value(PLI_SIG_DEST, command.pli_dest, 0);
+    pli_drive_word_value(PLI_SIG_CMD, command.pli_cmd, 0);
+
+    pli_drive_word_value(PLI_SIG_DATA_IN, command.pli_data_in.aval,
+                         command.pli_data_in.bval);
+    pli_drive_word_value(PLI_SIG_DATA_IN_2, command.pli_data_in_2.aval,
+                         command.pli_data_in_2.bval);
+
+    // Command without message drives spaces, so that TB does not show message of
+    // previous command.
+    if (command.pli_message_id != simulator_channel.driven_msg_id ||
+        !simulator_channel.msg_driven)
+    {
+        // ASCII encoding padded by spaces, first character is in most significant byte
+        const std::string &msg = SimulatorChannelGetMessage(command.pli_message_id);
+        uint32_t msg_aval[PLI_MAX_VEC_WORDS] = {};
+        uint32_t msg_bval[PLI_MAX_VEC_WORDS] = {};
+
+        for (size_t i = 0; i < PLI_STR_BUF_MAX_MSG_LEN; i++)
+        {
+            uint32_t chr = (i < msg.size()) ? static_cast<uint8_t>(msg[i]) : ' ';
+            size_t bit = PLI_STR_BUF_IN_SIZE - 8 * (i + 1);
+            msg_aval[bit / 32] |= chr << (bit % 32);
+        }
+
+        pli_drive_vector_value(PLI_SIG_STR_BUF_IN, msg_aval, msg_bval);
+        simulator_channel.driven_msg_id = command.pli_message_id;
+        simulator_channel.msg_driven = true;
+    }
+
+    pli_drive_word_value(PLI_SIG_REQ, 1, 0);
+
+    simulator_channel.fsm.store(SimulatorChannelFsm::REQ_UP);
+}
+
+
+/**
+ * Advances processing of commands by one step of FSM.
+ * @returns true if FSM advanced, false if it waits for simulator (or there is no
+ *          command to process)
+ */
+static bool SimulatorChannelStep()
+{
+    SimulatorCommand *command;
+    uint64_t ack_aval;
+    uint64_t ack_bval;
+
+    switch (simulator_channel.fsm.load())
+    {
+        case SimulatorChannelFsm::FREE:
+            command = simulator_channel.queue.Front();
+            if (command == nullptr)
+                return false;
+            DriveCommand(*command);
+            return true;
 
-            if (strcmp(pli_ack, "1"))
-                return;
+        case SimulatorChannelFsm::REQ_UP:
+            pli_read_word_value(PLI_SIG_ACK, &ack_aval, &ack_bval);
+            if (ack_aval != 1 || ack_bval != 0)
+                return false;
 
             /* Copy back read data for read access */
-            if (simulator_channel.read_access)
+            if (simulator_channel.queue.Front()->read_access)
             {
-                pli_read_str_value(PLI_SIGNAL_DATA_OUT, pli_read_data);
-                simulator_channel.pli_data_out = std::string(pli_read_data);
+                uint64_t seq = simulator_channel.processed.load();
+                SimulatorReadData &read_data =
+                    simulator_channel.read_data[seq % SIMULATOR_CHANNEL_QUEUE_DEPTH];
+
+                pli_read_word_value(PLI_SIG_DATA_OUT, &read_data.data.aval,
+                                    &read_data.data.bval);
+                read_data.seq = seq;
             }
 
-            pli_drive_str_value(
-                    PLI_SIGNAL_REQ, std::string("0").c_str());
+            pli_drive_word_value(PLI_SIG_REQ, 0, 0);
 
             simulator_channel.fsm.store(SimulatorChannelFsm::ACK_UP);
-            std::atomic_thread_fence(std::memory_order_acquire);
-            break;
+            return true;
 
         case SimulatorChannelFsm::ACK_UP:
-            memset(pli_ack, 0, sizeof(pli_ack));
-
-            pli_read_str_value(PLI_SIGNAL_ACK, pli_ack);
-            if (strcmp(pli_ack, (char*) "0"))
-                return;
-
-            pli_drive_str_value(
-                    PLI_SIGNAL_REQ, std::string("0").c_str());
+            pli_read_word_value(PLI_SIG_ACK, &ack_aval, &ack_bval);
+            if (ack_aval != 0 || ack_bval != 0)
+                return false;
 
+            // Command is done, signal it to test (data out are visible to test once it
+            // sees the command processed).
+            simulator_channel.queue.Pop();
             simulator_channel.fsm.store(SimulatorChannelFsm::FREE);
-            std::atomic_thread_fence(std::memory_order_acquire);
-            SimulatorChannelClearRequest();
-            std::atomic_thread_fence(std::memory_order_acquire);
-            break;
+            SimulatorChannelNotify();
+            simulator_channel.n_batch_done++;
+
+            // Issue next queued command right away, without waiting for next callback.
+            command = simulator_channel.queue.Front();
+            if (command != nullptr)
+                DriveCommand(*command);
+            return true;
 
         default:
-            break;
+            return false;
     }
-}
\ No newline at end of file
+}
+
+
+int SimulatorChannelIsIdle()
+{
+    return simulator_channel.fsm.load() == SimulatorChannelFsm::FREE &&
+           simulator_channel.queue.Empty();
+}
+
+
+int SimulatorChannelWaitsForAck()
+{
+    return simulator_channel.fsm.load() != SimulatorChannelFsm::FREE;
+}
+
+
+void ProcessPliClkCallback()
+{
+    //
+    // Callback cannot poll on PLI hanshake since it is blocking for digital
+    // simulator! Therefore Callback is processed as automata. It takes all steps
+    // for which it does not need to wait for simulator, but it finishes at most
+    // "max_batch" commands, so that simulation time advances.
+    //
+    simulator_channel.n_callbacks++;
+    simulator_channel.n_batch_done = 0;
+
+    while (simulator_channel.n_batch_done < simulator_channel.max_batch)
+        if (!SimulatorChannelStep())
+            break;
+}
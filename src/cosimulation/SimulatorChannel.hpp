@@ -14,6 +14,52 @@
 
 #include <iostream>
 #include <atomic>
+#include <string>
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+#include <unordered_map>
+
+#include "SpscRing.hpp"
+
+extern "C" {
+    #include "pli_utils.h"
+}
+
+/**
+ * Number of commands which can be queued in Simulator Channel.
+ */
+#define SIMULATOR_CHANNEL_QUEUE_DEPTH 256
+
+/**
+ * Default number of polls for which test thread spins when waiting for simulator,
+ * before it parks (sleeps until simulator wakes it up).
+ */
+#define SIMULATOR_CHANNEL_SPIN_BUDGET 4000
+
+/**
+ * Default maximal number of commands which PLI callback finishes in single call.
+ */
+#define SIMULATOR_CHANNEL_MAX_BATCH 16
+
+/**
+ * Number of messages in single chunk of message table, and maximal number of chunks.
+ */
+#define SIMULATOR_CHANNEL_MSG_CHUNK_SIZE 256
+#define SIMULATOR_CHANNEL_MSG_MAX_CHUNKS 256
+
+/**
+ * Id of message interned in message table of Simulator Channel.
+ */
+typedef uint16_t PliMessageId;
+
+/**
+ * Id of empty message (command has no message).
+ */
+#define PLI_MESSAGE_NONE 0
+
 
 /**
  * @enum State machine for processing of request to simulator.
@@ -27,32 +73,71 @@ enum class SimulatorChannelFsm
 
 
 /**
- * @struct Shared memory channel for issuing request to simulator.
+ * @struct Value of logic vector in 4-state encoding. Each bit of vector is given by
+ *         pair of bits (aval, bval): 00 = '0', 10 = '1', 11 = 'X', 01 = 'Z'.
  */
-struct SimulatorChannel
+struct PliWord
 {
-    /*
-     * FSM for request processing.
-     *
-     * THIS SHOULD NOT BE DIRECTLY ACCESSES.
-     *
-     * Only simulator reads/modifies it as it processes requests!
+    uint64_t aval = 0;
+    uint64_t bval = 0;
+};
+
+
+/**
+ * @struct Data read by command with read access, tagged by sequence number of the
+ *         command (number of commands issued before it).
+ */
+struct SimulatorReadData
+{
+    uint64_t seq = UINT64_MAX;
+    PliWord data;
+};
+
+
+/**
+ * @struct Command (request) to simulator. Fixed size record, fields hold binary
+ *         values which are driven on PLI signals of TB.
+ */
+struct SimulatorCommand
+{
+    /**
+     * Creates command without input data.
+     * @param dest PLI Destination
+     * @param cmd PLI Command
+     * @param read_access Command returns data ("pli_data_out" is sampled)
+     */
+    SimulatorCommand(uint8_t dest, uint8_t cmd, bool read_access = false);
+
+    SimulatorCommand() = default;
+
+    void SetDataIn(uint64_t data);
+    void SetDataIn(const PliWord &data);
+    void SetDataIn2(uint64_t data);
+
+    /**
+     * Sets message data and enables their use. Message is interned in message
+     * table (see SimulatorChannelInternMessage).
      */
-    std::atomic<SimulatorChannelFsm> fsm;
+    void SetMessageData(const std::string &msg);
+
+    /**
+     * Sets message data to message already interned in message table.
+     */
+    void SetMessageData(PliMessageId msg_id);
 
     /**
      * PLI Destination.
      * Agent in TB to which request will be sent. This will be
      * translated to "pli_dest" signal in TB.
      */
-    std::string pli_dest;
+    uint8_t pli_dest;
 
     /**
      * PLI Command
      * Command which will be sent to an agent given by "pli_dest".
      * This will be translated to "pli_cmd" signal in TB.
      */
-    std::string pli_cmd;
+    uint8_t pli_cmd;
 
     /**
      * PLI Data In
@@ -60,7 +145,7 @@ struct SimulatorChannel
      * specific (pli_cmd) for each command. This will be translated to
      * "pli_data_in" signal in TB.
      */
-    std::string pli_data_in;
+    PliWord pli_data_in;
 
     /**
      * PLI Data In 2
@@ -68,47 +153,139 @@ struct SimulatorChannel
      * command specific (pli_cmd) for each command. This will be translated to
      * "pli_data_in_2" signal in TB.
      */
-    std::string pli_data_in_2;
+    PliWord pli_data_in_2;
+
+    /**
+     * PLI Message data
+     * Id of message which sends additional information (like print message in
+     * case of driver/monitor) as part of request to simulator. Text of message
+     * is driven on "pli_str_buf_in" signal in TB (padded by spaces). Command with
+     * PLI_MESSAGE_NONE drives spaces (TB shows no message).
+     */
+    PliMessageId pli_message_id;
+
+    /**
+     * Read access
+     * Indicates pli_data_out signal shall be sampled as part of this request and
+     * data shall be returned in "read_data" of Simulator Channel.
+     */
+    bool read_access;
+};
+
+
+/**
+ * @struct Table of messages interned by Simulator Channel. Each distinct message
+ *         is stored once, commands refer to it by its id.
+ *
+ * Messages are interned by test (under mutex), and read by simulator without lock:
+ * message is never modified once interned, and it is written before id of the
+ * message is posted in a command. Messages are held in chunks which are never
+ * moved, so adding a message does not affect messages which are read.
+ */
+struct SimulatorMessageTable
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, PliMessageId> ids;
+    std::unique_ptr<std::string[]> chunks[SIMULATOR_CHANNEL_MSG_MAX_CHUNKS];
+
+    /* Number of interned messages (including PLI_MESSAGE_NONE) */
+    size_t size = 0;
+};
+
+
+/**
+ * @struct Shared memory channel for issuing requests to simulator.
+ *
+ * Test thread is the only producer of commands, PLI callback is the only
+ * consumer. Commands are processed by simulator in the order in which they
+ * were issued.
+ */
+struct SimulatorChannel
+{
+    /*
+     * FSM for request processing.
+     *
+     * THIS SHOULD NOT BE DIRECTLY ACCESSES.
+     *
+     * Only simulator reads/modifies it as it processes requests!
+     */
+    std::atomic<SimulatorChannelFsm> fsm{SimulatorChannelFsm::FREE};
+
+    /**
+     * Queue of commands issued by test and not yet processed by simulator.
+     * Command at front of queue is being processed by simulator.
+     */
+    SpscRing<SimulatorCommand, SIMULATOR_CHANNEL_QUEUE_DEPTH> queue;
+
+    /**
+     * Number of commands issued to the channel (modified only by test).
+     */
+    uint64_t issued = 0;
+
+    /**
+     * Number of commands processed by simulator (modified only by simulator).
+     */
+    std::atomic<uint64_t> processed{0};
 
     /**
      * PLI Data Out
-     * Output data from simulator for a request. Meaning of these data is command
-     * specific (pli_cmd) for each command. This value is taken from "pli_data_out"
-     * signal in TB! Data are obtained only when "read_access = true".
+     * Output data from simulator for commands with read access. Taken from
+     * "pli_data_out" signal in TB. Data of command with sequence number "seq" are
+     * in "read_data[seq % SIMULATOR_CHANNEL_QUEUE_DEPTH]", so they stay valid till
+     * SIMULATOR_CHANNEL_QUEUE_DEPTH further commands are issued.
      */
-    std::string pli_data_out;
+    SimulatorReadData read_data[SIMULATOR_CHANNEL_QUEUE_DEPTH];
 
     /**
-     * PLI Message data
-     * Input data which can send additional information (like print message in
-     * case of driver/monitor) as part of request to simulator. These data are
-     * interpreted only when "use_msg_data = true". These data are driven on
-     * "pli_str_buf_in" signal in TB.
+     * Waiting of test for simulator. Test spins for at most "spin_budget" polls,
+     * then it parks on condition variable. Simulator wakes it up once number of
+     * processed commands reaches "wake_at" (set only while test is parked).
+     * With single CPU, simulator can't run while test spins, so test parks
+     * right away.
      */
-    std::string pli_message_data;
+    size_t spin_budget = (std::thread::hardware_concurrency() > 1) ?
+                            SIMULATOR_CHANNEL_SPIN_BUDGET : 0;
+    std::mutex wait_mutex;
+    std::condition_variable wait_cv;
+    std::atomic<uint64_t> wake_at{UINT64_MAX};
 
     /**
-     * Read access
-     * Indicates pli_data_out signal shall be sampled as part of this request and
-     * data shall be returned in "pli_data_out"
+     * Counters of waits (modified only by test): all waits, waits finished while
+     * spinning, and waits which parked.
      */
-    std::atomic<bool> read_access;
+    uint64_t n_waits = 0;
+    uint64_t n_spin_waits = 0;
+    uint64_t n_park_waits = 0;
 
     /**
-     * Use message data
-     * Indicates "pli_str_buf_in" shall be driven by "pli_message_data". This can
-     * be used to provide additional information (like debug message) to TB!
+     * Maximal number of commands finished in single PLI callback, number of commands
+     * finished in current callback, and number of PLI callbacks (modified only by
+     * simulator).
      */
-    std::atomic<bool> use_msg_data;
+    size_t max_batch = SIMULATOR_CHANNEL_MAX_BATCH;
+    size_t n_batch_done = 0;
+    std::atomic<uint64_t> n_callbacks{0};
 
     /**
-     * A request variable.
-     *
-     * THIS SHOULD NOT BE DIRECTLY ACCESSES.
-     *
-     * Only simulator reads/modifies it as it processes requests.
+     * Messages of commands, and id of message which is driven on "pli_str_buf_in"
+     * (modified only by simulator). Message is driven only when it differs from
+     * the message driven before. PLI_MESSAGE_NONE is driven as spaces.
      */
-    std::atomic<bool> req;
+    SimulatorMessageTable messages;
+    PliMessageId driven_msg_id = PLI_MESSAGE_NONE;
+    bool msg_driven = false;
+};
+
+
+/**
+ * @struct Statistics of waiting of test for simulator, and of PLI callbacks.
+ */
+struct SimulatorChannelStats
+{
+    uint64_t n_waits;
+    uint64_t n_spin_waits;
+    uint64_t n_park_waits;
+    uint64_t n_callbacks;
 };
 
 extern SimulatorChannel simulator_channel;
@@ -120,13 +297,15 @@ extern SimulatorChannel simulator_channel;
  * always executed in Simulator context and can alter value on top level PLI
  * signals (without corrupting simulator internals)!
  *
- * PLI Callback alternates FSM of Simulator Channel.
+ * PLI Callback alternates FSM of Simulator Channel. In single call, it takes all
+ * steps of FSM which do not need simulator to proceed (e.g. if "pli_ack" is already
+ * answered), and it finishes up to "max_batch" commands.
  *
  * The operation of requests from test to Simulator is following:
- *  1. Test context configures PLI command, PLI Destination and PLI Data and
- *     issues a request processing. This can be blocking (processSimulatorRequest)
- *     or non-blocking (startSimulatorRequest).
- *  2. PLI callback is called in simulator context and it detects pending request.
+ *  1. Test context creates command (PLI command, PLI Destination and PLI Data) and
+ *     queues it to Simulator Channel. This can be blocking (SimulatorChannelProcessRequest)
+ *     or non-blocking (SimulatorChannelPostRequest).
+ *  2. PLI callback is called in simulator context and it detects pending command.
  *     PLI callback drives "pli_data_in", "pli_cmd", "pli_dest" and issues "pli_req".
  *  3. Simulator proceeds with simulation and notices "pli_req". It processes it
  *     and delivers it to dedicated agent in TB.
@@ -137,16 +316,35 @@ extern SimulatorChannel simulator_channel;
  *  6. Simulator proceeds and it notices that "pli_req" is 0. It drives "pli_ack"
  *     to 0.
  *  7. PLI callback is called in simulator context and it detects that "pli_ack"
- *     is equal to "0". This finishes processing of this handshake-like request
- *     to simulator and signals this to SimulatorChannel singleton.
- *  8. Test which issued request processing (in case of blocking processing),
- *     proceeds (SimulatorChannelProcessRequest returns). If this was a read
- *     request, then test can read data from SimulatorChannel which were returned
- *     by simulator on "pli_data_out".
+ *     is equal to "0". This finishes processing of the command, and PLI callback
+ *     removes it from the queue. If there is next command in the queue, PLI
+ *     callback issues it right away (continues by 2.).
+ *  8. Test which issued blocking request proceeds (SimulatorChannelProcessRequest
+ *     returns) once all commands it issued were processed. If this was a read
+ *     request, then test can take data which were returned by simulator on
+ *     "pli_data_out" (SimulatorChannelGetReadData). Test can also post several
+ *     read requests, and take their data later (SimulatorChannelPostRead).
  */
 extern "C" void ProcessPliClkCallback();
 
 
+/**
+ * @brief Indicates Simulator Channel has nothing to process: no command is in
+ *        progress, and test did not queue any. Called in simulator context.
+ *
+ * Once idle, Simulator Channel stays idle until test queues a command, so PLI
+ * callback needs to be called only to pick up new commands.
+ */
+extern "C" int SimulatorChannelIsIdle();
+
+
+/**
+ * @brief Indicates command is in progress, and Simulator Channel waits till
+ *        simulator changes "pli_ack". Called in simulator context.
+ */
+extern "C" int SimulatorChannelWaitsForAck();
+
+
 /**********************************************************************
  * Control functions
  *********************************************************************/
@@ -154,19 +352,16 @@ extern "C" void ProcessPliClkCallback();
 /**
  * @brief Issue request to simulator via Simulator Channel.
  *
- * Once all "pli_" prefixed attributes are filled, this function issues request
- * to simulator.
- *
- * This function is non-blocking.
+ * Command is queued and processed by simulator after all previously issued
+ * commands. This function is non-blocking (it waits only if queue is full).
  *
- * Do not call this function multiple times without waiting for the end of
- * previous request!
+ * @param command Command to issue.
  */
-void SimulatorChannelStartRequest();
+void SimulatorChannelPostRequest(const SimulatorCommand &command);
 
 
 /**
- * @brief Wait till request in Simulator Channel is processed.
+ * @brief Wait till all requests issued to Simulator Channel are processed.
  */
 void SimulatorChannelWaitRequestDone();
 
@@ -174,24 +369,101 @@ void SimulatorChannelWaitRequestDone();
 /**
  * @brief Issue request to simulator via Simulator Channel.
  *
- * Once all "pli_" prefixed attributes are filled, this function issues request
- * to simulator.
+ * This function is blocking, it returns only after the request (and all
+ * previously issued requests) were processed!
  *
- * This function is blocking, it returns only after the request was processed!
+ * @param command Command to issue.
  */
-void SimulatorChannelProcessRequest();
+void SimulatorChannelProcessRequest(const SimulatorCommand &command);
 
 
 /**
- * @brief Indicates there was a request issued on a Simulator channel.
+ * @brief Issue read request to simulator via Simulator Channel.
+ *
+ * Same as SimulatorChannelPostRequest, but returns sequence number of the request
+ * by which test takes data read by it. Test can issue further requests before it
+ * takes the data, so that several read requests are in flight.
+ *
+ * @param command Command to issue (with read access).
+ * @returns Sequence number of the request.
+ */
+uint64_t SimulatorChannelPostRead(const SimulatorCommand &command);
+
+
+/**
+ * @brief Wait till read request is processed, and take data it read.
+ *
+ * Data shall be taken before SIMULATOR_CHANNEL_QUEUE_DEPTH further requests are
+ * issued, otherwise they are overwritten by later requests. Taking overwritten
+ * data aborts the test.
+ *
+ * @param seq Sequence number of the request (returned by SimulatorChannelPostRead).
+ * @returns Data returned by simulator on "pli_data_out".
+ */
+PliWord SimulatorChannelGetReadData(uint64_t seq);
+
+
+/**
+ * @brief Issue read request to simulator via Simulator Channel, and wait for data
+ *        it read (blocking).
+ *
+ * @param command Command to issue (with read access).
+ * @returns Data returned by simulator on "pli_data_out".
+ */
+PliWord SimulatorChannelProcessRead(const SimulatorCommand &command);
+
+
+/**
+ * @brief Indicates there are requests which were not processed yet.
  */
 bool SimulatorChannelIsRequestPending();
 
 
 /**
- * @brief Clear hanging request on a Simulator Channel.
+ * @brief Sets for how long test spins when it waits for simulator.
+ *
+ * Spinning gives lowest latency with fast simulators, but it burns CPU time
+ * which slow simulator may need. Zero spin budget parks right away.
+ *
+ * @param spin_budget Number of polls before test thread parks.
+ */
+void SimulatorChannelSetSpinBudget(size_t spin_budget);
+
+
+/**
+ * @brief Sets maximal number of commands finished in single PLI callback.
+ *
+ * Callback finishes more commands only if simulator answers them without
+ * simulation time advancing. Value 1 takes at most one handshake per callback.
+ *
+ * @param max_batch Maximal number of commands finished in single callback.
+ */
+void SimulatorChannelSetMaxBatch(size_t max_batch);
+
+
+/**
+ * @returns Statistics of waiting for simulator and of PLI callbacks.
+ */
+SimulatorChannelStats SimulatorChannelGetStats();
+
+
+/**
+ * @brief Interns message in message table of Simulator Channel.
+ *
+ * Message is truncated to PLI_STR_BUF_MAX_MSG_LEN characters. Interning the same
+ * message again returns the same id. If message table is full, message is dropped.
+ *
+ * @param msg Message to intern.
+ * @returns Id of the message, PLI_MESSAGE_NONE if message is empty or dropped.
+ */
+PliMessageId SimulatorChannelInternMessage(const std::string &msg);
+
+
+/**
+ * @param msg_id Id of message returned by SimulatorChannelInternMessage.
+ * @returns Interned message (empty for PLI_MESSAGE_NONE).
  */
-void SimulatorChannelClearRequest();
+const std::string& SimulatorChannelGetMessage(PliMessageId msg_id);
 
 
-#endif
\ No newline at end of file
+#endif
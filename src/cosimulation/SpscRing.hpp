@@ -0,0 +1,111 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *****************************************************************************/
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class SpscRing
+ *
+ * Bounded lock-free queue with single producer and single consumer. Items are stored
+ * in place, consumer processes item at front of the queue, and only then it removes
+ * it from the queue (so that producer does not overwrite item being processed).
+ *
+ * @tparam T Type of item (copied into the queue)
+ * @tparam N Capacity of queue (power of two)
+ */
+template <typename T, size_t N>
+class SpscRing
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Capacity must be power of two");
+
+    public:
+        /**
+         * Inserts item at the end of queue. Called only by producer.
+         * @param item Item to insert
+         * @returns true if item was inserted, false if queue is full
+         */
+        bool TryPush(const T &item)
+        {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_.load(std::memory_order_acquire) == N)
+                return false;
+
+            items_[tail & (N - 1)] = item;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Called only by consumer.
+         * @returns Item at front of queue, nullptr if queue is empty
+         */
+        T* Front()
+        {
+            size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire))
+                return nullptr;
+
+            return &items_[head & (N - 1)];
+        }
+
+        /**
+         * Removes item at front of queue (queue must not be empty). Called only by consumer.
+         */
+        void Pop()
+        {
+            head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /**
+         * @returns Number of items in queue. Exact only when called by producer or consumer
+         *          (other side may change it concurrently).
+         */
+        size_t Size() const
+        {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+
+        bool Empty() const
+        {
+            return Size() == 0;
+        }
+
+    private:
+        /* Index of front item (modified only by consumer) */
+        alignas(64) std::atomic<size_t> head_{0};
+
+        /* Index after last item (modified only by producer) */
+        alignas(64) std::atomic<size_t> tail_{0};
+
+        alignas(64) T items_[N];
+};
+
+#endif
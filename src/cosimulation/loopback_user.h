@@ -0,0 +1,114 @@
+#ifndef LOOPBACK_USER_H
+#define LOOPBACK_USER_H
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Interface of loopback simulator (see LoopbackSimulator.hpp). Plays
+ *        the role of VPI/VHPI of HDL simulator for PLI library.
+ *
+ * Values of signals are in 4-state encoding (as VPI vector value). Each bit is
+ * given by pair of bits (aval, bval): 00 = '0', 10 = '1', 11 = 'X', 01 = 'Z'.
+ * First word holds bits 31..0 of signal.
+ *
+ * Simulation time unit is femtosecond.
+ *****************************************************************************/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Handle of signal or of callback */
+typedef struct lbObjectS *lbHandleT;
+
+typedef enum {
+    lbCbValueChange,
+    lbCbAfterDelay,
+    lbCbStartOfSimulation,
+    lbCbEndOfSimulation
+} lbCbReasonT;
+
+typedef enum {
+    lbSizeP
+} lbIntPropertyT;
+
+typedef enum {
+    lbNameP,
+    lbFullNameP
+} lbStrPropertyT;
+
+typedef void (*lbCbRtnT)(void);
+
+/**
+ * @returns Handle of signal with given full name (e.g. "tb/vip/pli_clk"),
+ *          NULL if there is no such signal.
+ */
+lbHandleT lb_handle_by_name(const char *name);
+
+/**
+ * @returns Integer property of signal (number of bits for lbSizeP).
+ */
+int32_t lb_get(lbIntPropertyT property, lbHandleT handle);
+
+/**
+ * @returns String property of signal.
+ */
+const char* lb_get_str(lbStrPropertyT property, lbHandleT handle);
+
+/**
+ * @brief Reads value of signal. Buffers shall hold (size + 31) / 32 words.
+ */
+void lb_get_value(lbHandleT handle, uint32_t *aval, uint32_t *bval);
+
+/**
+ * @brief Drives value to signal. Callbacks on value change of the signal are
+ *        called in next delta cycle.
+ */
+void lb_put_value(lbHandleT handle, const uint32_t *aval, const uint32_t *bval);
+
+/**
+ * @brief Registers callback.
+ * @param reason Reason to call the callback.
+ * @param handle Signal for lbCbValueChange, NULL otherwise.
+ * @param delay Delay for lbCbAfterDelay (callback is called once).
+ * @param cb_rtn Callback function.
+ * @returns Handle of callback.
+ */
+lbHandleT lb_register_cb(lbCbReasonT reason, lbHandleT handle, uint64_t delay,
+                         lbCbRtnT cb_rtn);
+
+/**
+ * @brief Removes callback.
+ * @returns 0 if succesfull, -1 otherwise.
+ */
+int lb_remove_cb(lbHandleT cb_handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -17,8 +17,24 @@
 
 #include "pli_handle_manager.h"
 
-/* List of handles which has been already queried by library */
-static struct hlist_node *list_head = NULL;
+/* Names of signals in CTU CAN FD VIP (indexed by pli_signal) */
+static const char *hman_signal_names[PLI_SIG_COUNT] = {
+    [PLI_SIG_CLOCK]             = PLI_SIGNAL_CLOCK,
+    [PLI_SIG_CONTROL_REQ]       = PLI_SIGNAL_CONTROL_REQ,
+    [PLI_SIG_CONTROL_GNT]       = PLI_SIGNAL_CONTROL_GNT,
+    [PLI_SIG_TEST_NAME_ARRAY]   = PLI_SIGNAL_TEST_NAME_ARRAY,
+    [PLI_SIG_REQ]               = PLI_SIGNAL_REQ,
+    [PLI_SIG_ACK]               = PLI_SIGNAL_ACK,
+    [PLI_SIG_CMD]               = PLI_SIGNAL_CMD,
+    [PLI_SIG_DEST]              = PLI_SIGNAL_DEST,
+    [PLI_SIG_DATA_IN]           = PLI_SIGNAL_DATA_IN,
+    [PLI_SIG_DATA_IN_2]         = PLI_SIGNAL_DATA_IN_2,
+    [PLI_SIG_DATA_OUT]          = PLI_SIGNAL_DATA_OUT,
+    [PLI_SIG_STR_BUF_IN]        = PLI_SIGNAL_STR_BUF_IN
+};
+
+/* Table of signal handles (indexed by pli_signal), filled by hman_init */
+static struct hman_signal hman_signals[PLI_SIG_COUNT];
 
 
 #if PLI_KIND == PLI_KIND_GHDL_VPI
@@ -82,7 +98,7 @@ static T_PLI_HANDLE hman_get_ctu_vip_handle()
         vpi_free_object(top_mod_it);
 
         full_path = vpi_get_str(vpiFullName, ctu_vip_handle);
-        pli_printf(PLI_INFO, "Found CTU CAN FD VIP is: %s", full_path, ctu_vip_handle);
+        pli_printf(PLI_INFO, "Found CTU CAN FD VIP is: %s", full_path);
     }
 
     return ctu_vip_handle;
@@ -158,6 +174,15 @@ static T_PLI_HANDLE hman_create_ctu_vip_signal_handle(const char *signal_name)
     if (sig_handle != NULL)
         return sig_handle;
 
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+    char full_name[1024];
+    snprintf(full_name, sizeof(full_name), "%s%s%s", CTU_VIP_HIERARCHICAL_PATH,
+             PLI_HIER_SEP, signal_name);
+
+    lbHandleT sig_handle = lb_handle_by_name(full_name);
+    if (sig_handle != NULL)
+        return sig_handle;
+
 #endif
 
     pli_printf(PLI_ERROR, "Can't find handle for signal %s", signal_name);
@@ -166,123 +191,86 @@ static T_PLI_HANDLE hman_create_ctu_vip_signal_handle(const char *signal_name)
 }
 
 
-/**
- * @brief Searches handle list for handle with matching signal name.
- * @param signal_name Name of signal whose handle to search for
- * @param Pointer to handle node in Handle list.
- */
-static struct hlist_node* hman_search_handle_list(const char *signal_name)
+/******************************************************************************
+ * Public API
+ *****************************************************************************/
+
+int hman_init()
 {
-    pli_printf(PLI_DEBUG, "hman_search_handle_list: %s", signal_name);
+    pli_printf(PLI_DEBUG, "hman_init");
 
-    if (list_head == NULL)
-        return NULL;
+    int rv = 0;
 
-    struct hlist_node *current = list_head;
-    for (;;)
+    for (size_t i = 0; i < PLI_SIG_COUNT; i++)
     {
-        if (!strcmp(current->signal_name, signal_name))
-            return current;
-        if (current->next == NULL)
-            break;
-        current = current->next;
-    }
-    return NULL;
-}
-
+        struct hman_signal *entry = &hman_signals[i];
 
-/**
- * Adds new top signal handle to "top_signals_handle" list.
- */
-static struct hlist_node* hman_add_handle_to_list(T_PLI_HANDLE handle, const char *signal_name)
-{
-    pli_printf(PLI_DEBUG, "hman_add_handle_to_list: %s", signal_name);
-
-    /* First entry to empty list */
-    if (list_head == NULL)
-    {
-        list_head = (struct hlist_node *)pli_malloc(sizeof(struct hlist_node));
-        list_head->next = NULL;
-        list_head->handle = handle; /* Handle allocated from simulator by caller */
-
-        list_head->signal_name = (char *)pli_malloc(strlen(signal_name) + 1);
-        if (list_head->signal_name == NULL) {
-            pli_printf(PLI_ERROR, "Failed to allocate memory for hlist_node name!");
-            return NULL;
+        entry->signal_name = hman_signal_names[i];
+        entry->handle = hman_create_ctu_vip_signal_handle(entry->signal_name);
+        if (entry->handle == NULL) {
+            rv = -1;
+            continue;
         }
+        entry->signal_size = (size_t) PLI_GET(P_PLI_SIZE, entry->handle);
 
-        strcpy(list_head->signal_name, signal_name);
-        list_head->signal_size = (size_t) PLI_GET(P_PLI_SIZE, handle);
+        size_t n_words = (entry->signal_size + 31) / 32;
+#if PLI_KIND == PLI_KIND_GHDL_VPI
+        entry->vec_buf = pli_malloc(n_words * sizeof(s_vpi_vecval));
+#elif (PLI_KIND == PLI_KIND_VCS_VHPI) || (PLI_KIND == PLI_KIND_NVC_VHPI)
+        entry->enum_buf = pli_malloc(entry->signal_size * sizeof(vhpiEnumT));
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+        entry->vec_aval = pli_malloc(n_words * sizeof(uint32_t));
+        entry->vec_bval = pli_malloc(n_words * sizeof(uint32_t));
+#endif
+        entry->str_buf = pli_malloc(entry->signal_size + 1);
+        entry->drv_aval = pli_malloc(n_words * sizeof(uint32_t));
+        entry->drv_bval = pli_malloc(n_words * sizeof(uint32_t));
+        entry->drv_valid = 0;
 
-        return list_head;
+        char *full_name;
+#if PLI_KIND == PLI_KIND_GHDL_VPI
+        full_name = vpi_get_str(vpiFullName, entry->handle);
+#elif (PLI_KIND == PLI_KIND_VCS_VHPI) || (PLI_KIND == PLI_KIND_NVC_VHPI)
+        full_name = (char *)vhpi_get_str(vhpiFullNameP, entry->handle);
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+        full_name = (char *)lb_get_str(lbFullNameP, entry->handle);
+#endif
+        pli_printf(PLI_DEBUG, "Caching signal handle of: %s", full_name);
     }
 
-    struct hlist_node *current = list_head;
-
-    /* Get last entry in the list*/
-    while (current->next != NULL)
-        current = current->next;
+    return rv;
+}
 
-    /* Append entry to the end */
-    current->next = (struct hlist_node *)pli_malloc(sizeof(struct hlist_node));
-    current = current->next;
-    current->next = NULL;
-    current->handle = handle;
 
-    current->signal_name = (char *)pli_malloc(strlen(signal_name) + 1);
-    if (current->signal_name == NULL) {
-        pli_printf(PLI_ERROR, "Failed to allocate memory for hlist_node name!");
+struct hman_signal* hman_get_ctu_vip_net_handle(enum pli_signal signal)
+{
+    if ((size_t)signal >= PLI_SIG_COUNT || hman_signals[signal].handle == NULL)
         return NULL;
-    }
-
-    current->signal_size = (size_t) PLI_GET(P_PLI_SIZE, handle);
-    strcpy(current->signal_name, signal_name);
 
-    return current;
+    return &hman_signals[signal];
 }
 
 
-/******************************************************************************
- * Public API
- *****************************************************************************/
-
-struct hlist_node* hman_get_ctu_vip_net_handle(const char *signal_name)
+void hman_cleanup()
 {
-    pli_printf(PLI_DEBUG, "hman_get_ctu_vip_net_handle: %s", signal_name);
-
-    /* Get enry from list (cached handle) */
-    struct hlist_node* list_entry = hman_search_handle_list(signal_name);
+    pli_printf(PLI_DEBUG, "hman_cleanup");
 
-    /* Not found -> Get from simulator and cache */
-    if (list_entry == NULL)
+    for (size_t i = 0; i < PLI_SIG_COUNT; i++)
     {
-        T_PLI_HANDLE new_signal_handle = hman_create_ctu_vip_signal_handle(signal_name);
+        struct hman_signal *entry = &hman_signals[i];
 
-        char *full_name;
 #if PLI_KIND == PLI_KIND_GHDL_VPI
-        full_name = vpi_get_str(vpiFullName, new_signal_handle);
+        free(entry->vec_buf);
 #elif (PLI_KIND == PLI_KIND_VCS_VHPI) || (PLI_KIND == PLI_KIND_NVC_VHPI)
-        full_name = (char *)vhpi_get_str(vhpiFullNameP, new_signal_handle);
+        free(entry->enum_buf);
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+        free(entry->vec_aval);
+        free(entry->vec_bval);
 #endif
-        pli_printf(PLI_DEBUG, "Caching signal handle of: %s", full_name);
-        list_entry = hman_add_handle_to_list(new_signal_handle, signal_name);
+        free(entry->str_buf);
+        free(entry->drv_aval);
+        free(entry->drv_bval);
     }
 
-    return list_entry;
-}
-
-
-void hman_cleanup()
-{
-    pli_printf(PLI_DEBUG, "hman_cleanup");
-
-    struct hlist_node *current = list_head;
-    struct hlist_node *next;
-
-    while (current)
-    {
-        next = current->next;
-        free(current);
-        current = next;
-    }
+    memset(hman_signals, 0, sizeof(hman_signals));
 }
@@ -31,9 +31,8 @@
  *        multiple times (avoids memory leaks inside GHDL!
  *      - Locates CTU CAN FD VIP in hierarchy of HDL simulation.
  *
- * Handle manager maintains cache of handles to signals which has been already
- * obtained. If handle to a signal with equal name is queried, cached value is
- * returned instead.
+ * Handle manager queries handles to all signals at start of simulation, and
+ * keeps them in table indexed by pli_signal.
  *
  * This assumes that we do not query handles to signals with the same name at
  * different places in hierarchy. This is reasonable assumption as all the
@@ -44,32 +43,56 @@
 #include "pli_utils.h"
 
 /**
- * @brief Handle List entry.
+ * @brief Entry of signal table.
  *
- * By buffering already queried handles and their names, in list/cache, we can
- * avoid querying the handle from HDL simulator multiple times. Instead, only
- * first time the handle is queried from HDL sim. All next queries search the
- * list and return cached version.
+ * Handles to all signals (see pli_signal) are queried from HDL simulator only
+ * once, at start of simulation, and stored in table indexed by pli_signal.
+ * Accessing a signal then needs no search and no query to HDL simulator.
+ *
+ * Each entry also owns buffers for values of the signal, so that driving and
+ * reading the signal does not allocate memory.
  *
  * This helps performance-wise, and also avoids memory leaks in GHDL.
  */
-struct hlist_node {
+struct hman_signal {
     T_PLI_HANDLE handle;
-    char *signal_name;
+    const char *signal_name;
     size_t signal_size;
-    struct hlist_node *next;
+
+    /* Buffers for values of the signal (allocated once, sized by signal) */
+#if PLI_KIND == PLI_KIND_GHDL_VPI
+    s_vpi_vecval *vec_buf;
+#elif (PLI_KIND == PLI_KIND_VCS_VHPI) || (PLI_KIND == PLI_KIND_NVC_VHPI)
+    vhpiEnumT *enum_buf;
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+    uint32_t *vec_aval;
+    uint32_t *vec_bval;
+#endif
+    char *str_buf;
+
+    /* Last value driven to the signal (valid only if "drv_valid" is set) */
+    uint32_t *drv_aval;
+    uint32_t *drv_bval;
+    int drv_valid;
 };
 
+/**
+ * @brief Queries handles of all signals in CTU CAN FD VIP test controller agent.
+ *        Shall be called at start of simulation.
+ * @returns 0 if handles of all signals were found, -1 otherwise.
+ */
+int hman_init();
+
 /**
  * @brief Returns handle to signal in CTU CAN FD VIP test controller agent.
- * @returns Pointer to handle entry in list of handles.
+ * @returns Pointer to entry in table of signals, NULL if signal was not found.
  */
-struct hlist_node* hman_get_ctu_vip_net_handle(const char *signal_name);
+struct hman_signal* hman_get_ctu_vip_net_handle(enum pli_signal signal);
 
 /**
  * @brief Should be called at the end of simulation to perform cleanup
- *        (free cached handles)
+ *        (forget cached handles, free value buffers)
  */
 void hman_cleanup();
 
-#endif
\ No newline at end of file
+#endif
@@ -20,8 +20,18 @@
 #include "pli_utils.h"
 #include "pli_handle_manager.h"
 
-// Global message print severity level
-static t_pli_msg_severity pli_severity_level = PLI_INFO;
+/**
+ * Functions imported from C++ (log writer, runtime level of "Pli" category)
+ */
+int LogPliIsEnabled(int severity);
+void LogPliWrite(int severity, const char *line);
+void LogFlush();
+
+/* Number of heap allocations done by library (pli_malloc) */
+static size_t pli_alloc_count = 0;
+
+/* Number of drives skipped since signal already had the driven value */
+static size_t pli_drive_skip_count = 0;
 
 
 #if (PLI_KIND == PLI_KIND_VCS_VHPI) || (PLI_KIND == PLI_KIND_NVC_VHPI)
@@ -56,98 +66,287 @@ static char std_logic_char_to_raw(char std_logic) {
     }
 }
 
-#endif
+static uint32_t logic4_to_raw(uint32_t aval, uint32_t bval) {
+    if (bval == 0)
+        return aval ? 0x3 : 0x2;
+    return aval ? 0x1 : 0x4;
+}
+
+static void raw_to_logic4(uint32_t raw, uint64_t *aval, uint64_t *bval, size_t bit) {
+    switch (raw) {
+    case 0x2: case 0x6: break;                                  // '0', 'L'
+    case 0x3: case 0x7: *aval |= (uint64_t)1 << bit; break;     // '1', 'H'
+    case 0x4: *bval |= (uint64_t)1 << bit; break;               // 'Z'
+    default:                                                    // 'U', 'X', 'W', '-'
+        *aval |= (uint64_t)1 << bit;
+        *bval |= (uint64_t)1 << bit;
+        break;
+    }
+}
+
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+
+static void std_logic_char_to_logic4(char std_logic, uint32_t *aval, uint32_t *bval,
+                                     size_t bit)
+{
+    uint32_t mask = (uint32_t)1 << (bit % 32);
 
+    switch (std_logic) {
+    case '0': case 'L': break;
+    case '1': case 'H': aval[bit / 32] |= mask; break;
+    case 'Z': bval[bit / 32] |= mask; break;
+    default:                                                    // 'U', 'X', 'W', '-'
+        aval[bit / 32] |= mask;
+        bval[bit / 32] |= mask;
+        break;
+    }
+}
 
-int pli_drive_str_value(const char *signal_name, const char *value)
+static char logic4_to_std_logic_char(const uint32_t *aval, const uint32_t *bval, size_t bit)
 {
-    pli_printf(PLI_DEBUG, "pli_drive_str_value: %s = %s", signal_name, value);
+    uint32_t a = (aval[bit / 32] >> (bit % 32)) & 0x1;
+    uint32_t b = (bval[bit / 32] >> (bit % 32)) & 0x1;
+
+    if (b)
+        return a ? 'X' : 'Z';
+    return a ? '1' : '0';
+}
+
+#endif
 
-    struct hlist_node* node = hman_get_ctu_vip_net_handle(signal_name);
+
+int pli_drive_str_value(enum pli_signal signal, const char *value)
+{
+    struct hman_signal *node = hman_get_ctu_vip_net_handle(signal);
 
     if (node == NULL)
         return -1;
 
-#if PLI_KIND == PLI_KIND_GHDL_VPI
-    char *signal_buffer = pli_malloc(node->signal_size + 1);
+    pli_printf(PLI_DEBUG, "pli_drive_str_value: %s = %s", node->signal_name, value);
 
+    // Value is driven not via pli_drive_vector_value, forget last driven value
+    node->drv_valid = 0;
+
+#if PLI_KIND == PLI_KIND_GHDL_VPI
     s_vpi_value vpi_value;
     vpi_value.format = vpiBinStrVal;
-    vpi_value.value.str = signal_buffer;
+    vpi_value.value.str = node->str_buf;
 
-    memset(signal_buffer, 0, node->signal_size + 1);
-    strcpy(signal_buffer, value);
+    memset(node->str_buf, 0, node->signal_size + 1);
+    strncpy(node->str_buf, value, node->signal_size);
 
     vpi_put_value(node->handle, &vpi_value, NULL, vpiNoDelay);
-    free(signal_buffer);
 
-#elif PLI_KIND == PLI_KIND_VCS_VHPI
+#elif (PLI_KIND == PLI_KIND_VCS_VHPI) || (PLI_KIND == PLI_KIND_NVC_VHPI)
 
     size_t len = node->signal_size;
+    size_t value_len = strlen(value);
 
-    // Allocate Buffers
-    unsigned *tmp = pli_malloc(sizeof(unsigned) * len);
-    unsigned *tmp2 = pli_malloc(sizeof(unsigned) * len);
-    for (size_t i = 0; i < len; i++) {
-        tmp[i] = 0x2;
-        tmp2[i] = 0x2;
-    }
-
-    // Convert std_logic string to VCS raw format
-    for (size_t i = 0; i < strlen(value); i++)
-        tmp[i] = (unsigned)std_logic_char_to_raw(value[i]);
-
-    // Flip bits - VCD passes the vector in reverse order
-    if (len > 1) {
-        for (size_t i = 0; i < len; i += 8)
-            tmp2[i] = tmp[len - i - 1];
-    } else {
-        tmp2[0] = tmp[0];
-    }
+    // Convert std_logic string to raw format, missing characters are '0'
+    for (size_t i = 0; i < len; i++)
+        node->enum_buf[i] = (i < value_len) ? (vhpiEnumT)std_logic_char_to_raw(value[i]) : 0x2;
 
     vhpiValueT vhpi_value;
-    vhpi_value.bufSize = (vhpiIntT)(sizeof(unsigned) * len);
+
+#if PLI_KIND == PLI_KIND_VCS_VHPI
+    vhpi_value.bufSize = (vhpiIntT)(sizeof(vhpiEnumT) * len);
 
     if (len == 1) {
         vhpi_value.format = vhpiEnumVal;
-        vhpi_value.value.enumval = tmp2[0];
+        vhpi_value.value.enumval = node->enum_buf[0];
     } else {
         vhpi_value.format = vhpiEnumVecVal;
-        vhpi_value.value.enums = tmp;
+        vhpi_value.value.enums = node->enum_buf;
+    }
+#else
+    vhpi_value.bufSize = (size_t)(sizeof(vhpiEnumT) * len);
+
+    if (len == 1) {
+        vhpi_value.format = vhpiLogicVal;
+        vhpi_value.value.enumv = node->enum_buf[0];
+    } else {
+        vhpi_value.format = vhpiLogicVecVal;
+        vhpi_value.value.enumvs = node->enum_buf;
     }
+#endif
 
     vhpi_put_value(node->handle, &vhpi_value, vhpiForcePropagate);
 
-    free(tmp);
-    free(tmp2);
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+
+    size_t len = node->signal_size;
+    size_t value_len = strlen(value);
+    size_t n_words = (len + 31) / 32;
+
+    memset(node->vec_aval, 0, n_words * sizeof(uint32_t));
+    memset(node->vec_bval, 0, n_words * sizeof(uint32_t));
+
+    // First character is most significant bit, missing characters are '0'
+    for (size_t i = 0; i < len && i < value_len; i++)
+        std_logic_char_to_logic4(value[i], node->vec_aval, node->vec_bval, len - i - 1);
+
+    lb_put_value(node->handle, node->vec_aval, node->vec_bval);
+
+#endif
+
+    return 0;
+}
+
+
+int pli_read_str_value(enum pli_signal signal, char *ret_value)
+{
+    struct hman_signal *node = hman_get_ctu_vip_net_handle(signal);
+
+    if (node == NULL)
+        return -1;
+
+    pli_printf(PLI_DEBUG, "pli_read_str_value: %s Entered", node->signal_name);
+
+#if PLI_KIND == PLI_KIND_GHDL_VPI
+    s_vpi_value vpi_value;
+    vpi_value.format = vpiBinStrVal;
+    vpi_get_value(node->handle, &vpi_value);
+    strcpy(ret_value, vpi_value.value.str);
+
+#elif PLI_KIND == PLI_KIND_VCS_VHPI
+
+    size_t len = node->signal_size;
+
+    vhpiValueT vhpi_value;
+    vhpi_value.bufSize = (vhpiIntT)len;
+    vhpi_value.format = vhpiRawData;
+
+    vhpi_get_value(node->handle, &vhpi_value);
+
+    // Convert VCS raw to std_logic string, VCS passes the vector in reverse order.
+    // Caller must satisfy sufficient length of ret_value buffer
+    for (size_t i = 0; i < len; i++)
+        ret_value[len - i - 1] = raw_to_std_logic_char(((char*)(vhpi_value.value.ptr))[i]);
 
 #elif PLI_KIND == PLI_KIND_NVC_VHPI
 
     size_t len = node->signal_size;
+    vhpiValueT vhpi_value;
+    vhpi_value.bufSize = (size_t)(len * sizeof(vhpiEnumT));
 
-    // Allocate Buffers
-    uint32_t *tmp = pli_malloc(sizeof(uint32_t) * len);
+    if (len > 1) {
+        vhpi_value.format = vhpiLogicVecVal;
+        // NVC expects the buffer to be allocated, VCS allocates the buffer
+        // for us and (likely) also disposes it
+        vhpi_value.value.enumvs = node->enum_buf;
+    } else {
+        vhpi_value.format = vhpiLogicVal;
+    }
+
+    vhpi_get_value(node->handle, &vhpi_value);
+
+    // Caller must satisfy sufficient length of ret_value buffer
+    if (len > 1) {
+        for (size_t i = 0; i < len; i++)
+            ret_value[i] = raw_to_std_logic_char((char)node->enum_buf[i]);
+    } else {
+        ret_value[0] = raw_to_std_logic_char((char)(vhpi_value.value.intg));
+    }
+
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+
+    size_t len = node->signal_size;
+
+    lb_get_value(node->handle, node->vec_aval, node->vec_bval);
+
+    // Caller must satisfy sufficient length of ret_value buffer
     for (size_t i = 0; i < len; i++)
-        tmp[i] = 0x2;
+        ret_value[i] = logic4_to_std_logic_char(node->vec_aval, node->vec_bval, len - i - 1);
 
-    // Convert std_logic string to VCS raw format
-    for (size_t i = 0; i < strlen(value); i++)
-        tmp[i] = (unsigned)std_logic_char_to_raw(value[i]);
+#endif
+
+    pli_printf(PLI_DEBUG, "pli_read_str_value: %s Returns: %s", node->signal_name, ret_value);
+
+    return 0;
+}
+
+
+int pli_drive_vector_value(enum pli_signal signal, const uint32_t *aval,
+                           const uint32_t *bval)
+{
+    struct hman_signal *node = hman_get_ctu_vip_net_handle(signal);
+
+    if (node == NULL)
+        return -1;
+
+    // Skip driving the signal if it already has the value
+    size_t n_words = (node->signal_size + 31) / 32;
+    size_t top_bits = node->signal_size % 32;
+    uint32_t top_mask = top_bits ? (((uint32_t)1 << top_bits) - 1) : 0xFFFFFFFF;
+    int changed = !node->drv_valid;
+
+    for (size_t i = 0; i < n_words; i++) {
+        uint32_t mask = (i == n_words - 1) ? top_mask : 0xFFFFFFFF;
+        if (((node->drv_aval[i] ^ aval[i]) | (node->drv_bval[i] ^ bval[i])) & mask)
+            changed = 1;
+        node->drv_aval[i] = aval[i] & mask;
+        node->drv_bval[i] = bval[i] & mask;
+    }
+    node->drv_valid = 1;
+
+    if (!changed) {
+        pli_drive_skip_count++;
+        return 0;
+    }
+
+#if PLI_KIND == PLI_KIND_GHDL_VPI
+    for (size_t i = 0; i < n_words; i++) {
+        node->vec_buf[i].aval = (PLI_INT32)node->drv_aval[i];
+        node->vec_buf[i].bval = (PLI_INT32)node->drv_bval[i];
+    }
+
+    s_vpi_value vpi_value;
+    vpi_value.format = vpiVectorVal;
+    vpi_value.value.vector = node->vec_buf;
+
+    vpi_put_value(node->handle, &vpi_value, NULL, vpiNoDelay);
+
+#elif (PLI_KIND == PLI_KIND_VCS_VHPI) || (PLI_KIND == PLI_KIND_NVC_VHPI)
+
+    // Enum values of std_logic, most significant bit first
+    vhpiEnumT *raw = node->enum_buf;
+    size_t len = node->signal_size;
+
+    for (size_t i = 0; i < len; i++) {
+        size_t bit = len - i - 1;
+        raw[i] = logic4_to_raw((aval[bit / 32] >> (bit % 32)) & 0x1,
+                               (bval[bit / 32] >> (bit % 32)) & 0x1);
+    }
 
     vhpiValueT vhpi_value;
-    vhpi_value.bufSize = (size_t)(sizeof(uint32_t) * len);
+
+#if PLI_KIND == PLI_KIND_VCS_VHPI
+    vhpi_value.bufSize = (vhpiIntT)(sizeof(vhpiEnumT) * len);
+
+    if (len == 1) {
+        vhpi_value.format = vhpiEnumVal;
+        vhpi_value.value.enumval = raw[0];
+    } else {
+        vhpi_value.format = vhpiEnumVecVal;
+        vhpi_value.value.enums = raw;
+    }
+#else
+    vhpi_value.bufSize = (size_t)(sizeof(vhpiEnumT) * len);
 
     if (len == 1) {
         vhpi_value.format = vhpiLogicVal;
-        vhpi_value.value.enumv = tmp[0];
+        vhpi_value.value.enumv = raw[0];
     } else {
         vhpi_value.format = vhpiLogicVecVal;
-        vhpi_value.value.enumvs = tmp;
+        vhpi_value.value.enumvs = raw;
     }
+#endif
 
     vhpi_put_value(node->handle, &vhpi_value, vhpiForcePropagate);
 
-    free(tmp);
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+
+    lb_put_value(node->handle, node->drv_aval, node->drv_bval);
 
 #endif
 
@@ -155,20 +354,38 @@ int pli_drive_str_value(const char *signal_name, const char *value)
 }
 
 
-int pli_read_str_value(const char *signal_name, char *ret_value)
+int pli_drive_word_value(enum pli_signal signal, uint64_t aval, uint64_t bval)
 {
-    pli_printf(PLI_DEBUG, "pli_read_str_value: %s Entered", signal_name);
+    uint32_t aval_words[2] = {(uint32_t)aval, (uint32_t)(aval >> 32)};
+    uint32_t bval_words[2] = {(uint32_t)bval, (uint32_t)(bval >> 32)};
 
-    struct hlist_node* node = hman_get_ctu_vip_net_handle(signal_name);
+    return pli_drive_vector_value(signal, aval_words, bval_words);
+}
 
-    if (node == NULL)
+
+int pli_read_word_value(enum pli_signal signal, uint64_t *aval, uint64_t *bval)
+{
+    struct hman_signal *node = hman_get_ctu_vip_net_handle(signal);
+
+    *aval = 0;
+    *bval = 0;
+
+    if (node == NULL || node->signal_size > 64)
         return -1;
 
 #if PLI_KIND == PLI_KIND_GHDL_VPI
     s_vpi_value vpi_value;
-    vpi_value.format = vpiBinStrVal;
+    vpi_value.format = vpiVectorVal;
     vpi_get_value(node->handle, &vpi_value);
-    strcpy(ret_value, vpi_value.value.str);
+
+    for (size_t i = 0; i < (node->signal_size + 31) / 32; i++) {
+        *aval |= (uint64_t)(uint32_t)vpi_value.value.vector[i].aval << (32 * i);
+        *bval |= (uint64_t)(uint32_t)vpi_value.value.vector[i].bval << (32 * i);
+    }
+    if (node->signal_size < 64) {
+        *aval &= ((uint64_t)1 << node->signal_size) - 1;
+        *bval &= ((uint64_t)1 << node->signal_size) - 1;
+    }
 
 #elif PLI_KIND == PLI_KIND_VCS_VHPI
 
@@ -180,74 +397,54 @@ int pli_read_str_value(const char *signal_name, char *ret_value)
 
     vhpi_get_value(node->handle, &vhpi_value);
 
-    // Convert VCS raw to std_logic string
-    char *tmp = pli_malloc(len + 1);
-    memset(tmp, 0, len + 1);
-    for (size_t i = 0; i < len; i++) {
-        char *bit = (char*)(vhpi_value.value.ptr) + i;
-        tmp[i] = raw_to_std_logic_char(*bit);
-    }
-
-    // Flip bit order word.
-    char *tmp2 = pli_malloc(len + 1);
-    memset(tmp2, 0, len + 1);
-    for (size_t i = 0; i < len; i ++)
-        tmp2[i] = tmp[len - i - 1];
-
-    // Caller must satisfy sufficient length of ret_value buffer
-    memcpy(ret_value, tmp2, len);
-
-    free(tmp);
-    free(tmp2);
+    // Raw data hold least significant bit first
+    for (size_t i = 0; i < len; i++)
+        raw_to_logic4((uint32_t)((char*)(vhpi_value.value.ptr))[i], aval, bval, i);
 
 #elif PLI_KIND == PLI_KIND_NVC_VHPI
 
+    vhpiEnumT *raw = node->enum_buf;
     size_t len = node->signal_size;
+
     vhpiValueT vhpi_value;
     vhpi_value.bufSize = (size_t)(len * sizeof(vhpiEnumT));
 
     if (len > 1) {
         vhpi_value.format = vhpiLogicVecVal;
-        // NVC expects the buffer to be allocated, VCS allocates the buffer
-        // for us and (likely) also disposes it
-        vhpi_value.value.ptr = pli_malloc(vhpi_value.bufSize);
+        vhpi_value.value.enumvs = raw;
     } else {
         vhpi_value.format = vhpiLogicVal;
     }
 
     vhpi_get_value(node->handle, &vhpi_value);
-    char *tmp = pli_malloc(len + 1);
-    memset(tmp, 0, len + 1);
 
+    // Logic vector holds most significant bit first
     if (len > 1) {
-        for (size_t i = 0; i < len; i++) {
-            uint32_t *bit = (uint32_t*)(vhpi_value.value.ptr) + i;
-            tmp[i] = raw_to_std_logic_char((char)*bit);
-        }
+        for (size_t i = 0; i < len; i++)
+            raw_to_logic4((uint32_t)raw[i], aval, bval, len - i - 1);
     } else {
-        tmp[0] = raw_to_std_logic_char((char)(vhpi_value.value.intg));
+        raw_to_logic4((uint32_t)vhpi_value.value.intg, aval, bval, 0);
     }
 
-    // Caller must satisfy sufficient length of ret_value buffer
-    memcpy(ret_value, tmp, len);
+#elif PLI_KIND == PLI_KIND_LOOPBACK
 
-    free(tmp);
+    lb_get_value(node->handle, node->vec_aval, node->vec_bval);
 
-    if (len > 1)
-        free(vhpi_value.value.ptr);
+    for (size_t i = 0; i < (node->signal_size + 31) / 32; i++) {
+        *aval |= (uint64_t)node->vec_aval[i] << (32 * i);
+        *bval |= (uint64_t)node->vec_bval[i] << (32 * i);
+    }
 
 #endif
 
-    pli_printf(PLI_DEBUG, "pli_read_str_value: %s Returns: %s", signal_name, ret_value);
-
     return 0;
 }
 
 
 T_PLI_HANDLE pli_register_cb(T_PLI_REASON reason, T_PLI_HANDLE handle, void (*cb_fnc)(T_PLI_CB_ARGS))
 {
-    pli_printf(PLI_DEBUG, "pli_register_cb: reason: %d, handle: %p, cb_fnc: %p",
-                reason, handle, cb_fnc);
+    pli_printf(PLI_DEBUG, "pli_register_cb: reason: %d, handle: %p, cb_fnc: 0x%jx",
+                (int)reason, (void *)handle, (uintmax_t)(uintptr_t)cb_fnc);
 
 #if PLI_KIND == PLI_KIND_GHDL_VPI
     s_cb_data cb;
@@ -291,8 +488,8 @@ T_PLI_HANDLE pli_register_cb(T_PLI_REASON reason, T_PLI_HANDLE handle, void (*cb
     cb.value = &value;
     cb.obj = handle;
 
-    // TODO: Figure out why VCS returns NULL handle despite correctly registering the handle!
-    return vhpi_register_cb(&cb, 0);
+    // Handle of callback is returned only on request
+    return vhpi_register_cb(&cb, vhpiReturnCb);
 
 #elif PLI_KIND == PLI_KIND_NVC_VHPI
 
@@ -310,52 +507,171 @@ T_PLI_HANDLE pli_register_cb(T_PLI_REASON reason, T_PLI_HANDLE handle, void (*cb
     cb.value = &value;
     cb.obj = handle;
 
-    return vhpi_register_cb(&cb, 0);
+    return vhpi_register_cb(&cb, vhpiReturnCb);
+
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+
+    return lb_register_cb(reason, handle, 0, cb_fnc);
 
 #endif
 
 }
 
-void pli_printf(t_pli_msg_severity severity, const char *fmt, ...)
+
+T_PLI_HANDLE pli_register_delay_cb(uint64_t delay, void (*cb_fnc)(T_PLI_CB_ARGS))
 {
-    if (severity >= pli_severity_level) {
-        va_list args;
-        va_start(args, fmt);
+#if PLI_KIND == PLI_KIND_GHDL_VPI
+    s_cb_data cb;
+    s_vpi_time vpi_delay = {
+        .type = vpiSimTime,
+        .high = (PLI_UINT32)(delay >> 32),
+        .low = (PLI_UINT32)delay,
+        .real = 0.0
+    };
+
+    cb.reason = cbAfterDelay;
+    cb.cb_rtn = (PLI_INT32 (*)(struct t_cb_data*cb))(cb_fnc);
+    cb.obj = NULL;
+    cb.time = &vpi_delay;
+    cb.value = NULL;
+    cb.user_data = NULL;
 
-        char tmp[2048];
-        vsnprintf(tmp, 2048, fmt, args);
+    return vpi_register_cb(&cb);
 
-#if PLI_KIND == PLI_KIND_GHDL_VPI
-        vpi_printf("%s ", PLI_TAG);
-        vpi_printf("%s\n", tmp);
 #elif PLI_KIND == PLI_KIND_VCS_VHPI
-        vhpi_printf("%s ", PLI_TAG);
-        vhpi_printf("%s\n", tmp);
+
+    static vhpiCbDataT cb;
+    static vhpiTimeT time;
+
+    time = (vhpiTimeT)delay;
+
+    cb.reason = vhpiCbAfterDelay;
+    cb.cbf = cb_fnc;
+    cb.time = &time;
+    cb.value = NULL;
+    cb.obj = NULL;
+
+    return vhpi_register_cb(&cb, vhpiReturnCb);
+
 #elif PLI_KIND == PLI_KIND_NVC_VHPI
-        vhpi_printf("%s %s\n", PLI_TAG, tmp);
+
+    static vhpiCbDataT cb;
+    static vhpiTimeT time;
+
+    time.high = (int32_t)(delay >> 32);
+    time.low = (uint32_t)delay;
+
+    cb.reason = vhpiCbAfterDelay;
+    cb.cb_rtn = cb_fnc;
+    cb.time = &time;
+    cb.value = NULL;
+    cb.obj = NULL;
+
+    return vhpi_register_cb(&cb, vhpiReturnCb);
+
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+
+    return lb_register_cb(lbCbAfterDelay, NULL, delay, cb_fnc);
+
 #endif
-        va_end(args);
-    }
+}
+
+
+uint64_t pli_get_time_resolution_fs()
+{
+#if PLI_KIND == PLI_KIND_GHDL_VPI || PLI_KIND == PLI_KIND_VCS_VHPI
+    // Precision is given as power of ten (e.g. -15 for femtoseconds).
+  #if PLI_KIND == PLI_KIND_GHDL_VPI
+    int precision = (int)vpi_get(vpiTimePrecision, NULL);
+  #else
+    int precision = (int)vhpi_get(vhpiPrecisionP, NULL);
+  #endif
+    uint64_t res = 1;
+    for (int i = -15; i < precision && i < 3; i++)
+        res *= 10;
+    return res;
+
+#elif PLI_KIND == PLI_KIND_NVC_VHPI
+
+    vhpiPhysT res = vhpi_get_phys(vhpiResolutionLimitP, NULL);
+    uint64_t fs = ((uint64_t)(uint32_t)res.high << 32) | res.low;
+    return (fs > 0) ? fs : 1;
+
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+
+    return 1;
+
+#endif
+}
+
+
+int pli_remove_cb(T_PLI_HANDLE cb_handle)
+{
+#if PLI_KIND == PLI_KIND_GHDL_VPI
+    return vpi_remove_cb(cb_handle) ? 0 : -1;
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+    return lb_remove_cb(cb_handle);
+#else
+    return (vhpi_remove_cb(cb_handle) == 0) ? 0 : -1;
+#endif
+}
+
+void pli_log_printf(t_pli_msg_severity severity, const char *fmt, ...)
+{
+    if (!LogPliIsEnabled(severity))
+        return;
+
+    va_list args;
+    va_start(args, fmt);
+
+    char tmp[2048];
+    vsnprintf(tmp, sizeof(tmp), fmt, args);
+
+    // Simulator transcript gets PLI messages, after messages queued before.
+#if PLI_KIND == PLI_KIND_GHDL_VPI
+    LogFlush();
+    vpi_printf("%s %s\n", PLI_TAG, tmp);
+#elif PLI_KIND == PLI_KIND_VCS_VHPI || PLI_KIND == PLI_KIND_NVC_VHPI
+    LogFlush();
+    vhpi_printf("%s %s\n", PLI_TAG, tmp);
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+    char line[2200];
+    snprintf(line, sizeof(line), "%s %s", PLI_TAG, tmp);
+    LogPliWrite(severity, line);
+#endif
+
+    va_end(args);
 }
 
 void* pli_malloc(size_t size)
 {
-    pli_printf(PLI_DEBUG, "pli_malloc: size=%d", size);
+    pli_printf(PLI_DEBUG, "pli_malloc: size=%zu", size);
 
     void *p = malloc(size);
+    pli_alloc_count++;
 
     if (p == NULL) {
-        pli_printf(PLI_ERROR, "malloc failed for size of: %d", size);
-        pli_printf(PLI_ERROR, "Can't continue, exiting application...", size);
+        pli_printf(PLI_ERROR, "malloc failed for size of: %zu", size);
+        pli_printf(PLI_ERROR, "Can't continue, exiting application...");
         exit(1);
     }
 
     return p;
 }
 
+size_t pli_get_alloc_count()
+{
+    return pli_alloc_count;
+}
+
+size_t pli_get_drive_skip_count()
+{
+    return pli_drive_skip_count;
+}
+
 void pli_print_handle(T_PLI_HANDLE handle)
 {
-    pli_printf(PLI_INFO, "HANDLE: %p", handle);
+    pli_printf(PLI_INFO, "HANDLE: %p", (void *)handle);
 }
 
 
@@ -31,6 +31,7 @@
  *****************************************************************************/
 
 #include <string.h>
+#include <stdint.h>
 #include <pthread.h>
 
 
@@ -58,6 +59,26 @@
 #define PLI_SIGNAL_DATA_OUT "pli_data_out"
 #define PLI_SIGNAL_STR_BUF_IN "pli_str_buf_in"
 
+/**
+ * Signals accessed via PLI. Handles to them are resolved once at start of simulation
+ * and kept in table indexed by this enum (see pli_handle_manager.h).
+ */
+enum pli_signal {
+    PLI_SIG_CLOCK,
+    PLI_SIG_CONTROL_REQ,
+    PLI_SIG_CONTROL_GNT,
+    PLI_SIG_TEST_NAME_ARRAY,
+    PLI_SIG_REQ,
+    PLI_SIG_ACK,
+    PLI_SIG_CMD,
+    PLI_SIG_DEST,
+    PLI_SIG_DATA_IN,
+    PLI_SIG_DATA_IN_2,
+    PLI_SIG_DATA_OUT,
+    PLI_SIG_STR_BUF_IN,
+    PLI_SIG_COUNT
+};
+
 #define PLI_REQ_SIZE 1
 #define PLI_ACK_SIZE 1
 #define PLI_CMD_SIZE 8
@@ -70,10 +91,15 @@
 // Each character is 8 bit vector
 #define PLI_STR_BUF_MAX_MSG_LEN (PLI_STR_BUF_IN_SIZE/8)
 
+// Maximal width of signal driven via vector of words
+#define PLI_MAX_VEC_BITS PLI_STR_BUF_IN_SIZE
+#define PLI_MAX_VEC_WORDS (PLI_MAX_VEC_BITS/32)
+
 
 #define PLI_KIND_GHDL_VPI 0
 #define PLI_KIND_VCS_VHPI 1
 #define PLI_KIND_NVC_VHPI 2
+#define PLI_KIND_LOOPBACK 3
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -189,9 +215,35 @@
 #define PLI_FREE vhpi_release_handle
 #define PLI_GET vhpi_get
 
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+
+#include "loopback_user.h"
+
+#define PLI_TAG "\033[1;33mLOOPBACK: \033[0m"
+#define PLI_HIER_SEP "/"
+
+// Types
+#define T_PLI_HANDLE lbHandleT
+#define T_PLI_REASON lbCbReasonT
+#define T_PLI_CB_ARGS void
+#define PLI_CB_ARG T_PLI_CB_ARGS
+#define UNUSED_PLI_CB_ARG
+
+// Properties
+#define P_PLI_NAME lbNameP
+#define P_PLI_FULL_NAME lbFullNameP
+#define P_PLI_SIZE lbSizeP
+#define P_PLI_CB_VALUE_CHANGE lbCbValueChange
+#define P_PLI_CB_START_OF_SIMULATION lbCbStartOfSimulation
+#define P_PLI_CB_END_OF_SIMULATION lbCbEndOfSimulation
+
+// Functions
+#define PLI_GET_STR lb_get_str
+#define PLI_GET lb_get
+
 // Unknown
 #else
-    #error Invalid PLI_KIND. Set to either 0 (VPI), 1 (VCS VHPI) or 2 (NVC VHPI)
+    #error Invalid PLI_KIND. Set to either 0 (VPI), 1 (VCS VHPI), 2 (NVC VHPI) or 3 (Loopback)
 #endif
 
 typedef enum {
@@ -200,10 +252,22 @@ typedef enum {
     PLI_ERROR
 } t_pli_msg_severity;
 
+/**
+ * Minimal severity of PLI messages which are compiled in. Debug messages are
+ * compiled in only in debug build.
+ */
+#ifndef PLI_MIN_SEVERITY
+    #ifdef DEBUG_BUILD
+        #define PLI_MIN_SEVERITY PLI_DEBUG
+    #else
+        #define PLI_MIN_SEVERITY PLI_INFO
+    #endif
+#endif
+
 /**
  * @brief Drive value to net in Simulator. Signal shall be logic or logic vector.
  *
- * @param signalName Name of the signal/net to be driven.
+ * @param signal Signal/net to be driven.
  * @param value Value to be driven to the signal. String shall have format:
  *                 "10UZXLH" for all values of std_logic_vector.
  * @returns 0 if succesfull, -1 otherwise
@@ -211,20 +275,67 @@ typedef enum {
  * @warning This function should be called only in simulator context as result
  *          of simulator callback.
  */
-int pli_drive_str_value(const char *signal_name, const char *value);
+int pli_drive_str_value(enum pli_signal signal, const char *value);
 
 
 /**
  * @brief Read value from net in Simulator. Signal shall be logic or logic vector.
  *
- * @param signalName Name of the signal/net to read value from.
+ * @param signal Signal/net to read value from.
  * @param value Value read from the signal.
  * @returns 0 if succesfull, -1 otherwise
  *
  * @warning This function should be called only in simulator context as result
  *          of simulator callback.
  */
-int pli_read_str_value(const char *signal_name, char *ret_value);
+int pli_read_str_value(enum pli_signal signal, char *ret_value);
+
+
+/**
+ * @brief Drive value to net in Simulator. Signal shall be logic or logic vector
+ *        of at most PLI_MAX_VEC_BITS bits.
+ *
+ * Value is given in 4-state encoding (as VPI vector value). Each bit of signal
+ * is given by pair of bits (aval, bval): 00 = '0', 10 = '1', 11 = 'X', 01 = 'Z'.
+ *
+ * Signal is driven only if the value differs from value which was last driven
+ * to it by this function.
+ *
+ * @param signal Signal/net to be driven.
+ * @param aval Words of value (first word holds bits 31..0 of signal).
+ * @param bval Words of value (first word holds bits 31..0 of signal).
+ * @returns 0 if succesfull, -1 otherwise
+ *
+ * @warning This function should be called only in simulator context as result
+ *          of simulator callback.
+ */
+int pli_drive_vector_value(enum pli_signal signal, const uint32_t *aval,
+                           const uint32_t *bval);
+
+
+/**
+ * @brief Drive value to net in Simulator. Signal shall be logic or logic vector
+ *        of at most 64 bits. Value is in 4-state encoding (see pli_drive_vector_value).
+ *
+ * @param signal Signal/net to be driven.
+ * @param aval Value (bit 0 is bit 0 of signal)
+ * @param bval Value (bit 0 is bit 0 of signal)
+ * @returns 0 if succesfull, -1 otherwise
+ */
+int pli_drive_word_value(enum pli_signal signal, uint64_t aval, uint64_t bval);
+
+
+/**
+ * @brief Read value from net in Simulator. Signal shall be logic or logic vector
+ *        of at most 64 bits. Value is in 4-state encoding (see pli_drive_vector_value),
+ *        'L' and 'H' are read as '0' and '1', 'U', 'W' and '-' are read as 'X'.
+ *
+ * @param signal Signal/net to read value from.
+ * @param aval Value read from the signal.
+ * @param bval Value read from the signal.
+ * @returns 0 if succesfull, -1 otherwise
+ */
+int pli_read_word_value(enum pli_signal signal, uint64_t *aval, uint64_t *bval);
 
 
 /**
@@ -236,16 +347,67 @@ int pli_read_str_value(const char *signal_name, char *ret_value);
 T_PLI_HANDLE pli_register_cb(T_PLI_REASON reason, T_PLI_HANDLE handle, void (*cb_fnc)(T_PLI_CB_ARGS));
 
 
+/**
+ * @brief Register callback which is called once, after simulation time advances
+ *        by given delay.
+ * @param delay Delay in simulator time units (see pli_get_time_resolution_fs).
+ * @param cb_fnc Callback function.
+ * @returns Handle of callback, NULL if registration failed.
+ */
+T_PLI_HANDLE pli_register_delay_cb(uint64_t delay, void (*cb_fnc)(T_PLI_CB_ARGS));
+
+
+/**
+ * @returns Simulator time unit (resolution limit) in femtoseconds, at least 1.
+ */
+uint64_t pli_get_time_resolution_fs();
+
+
+/**
+ * @brief Remove callback which was not called yet (or repetitive callback).
+ * @param cb_handle Handle of callback returned by its registration.
+ * @returns 0 if succesfull, -1 otherwise
+ */
+int pli_remove_cb(T_PLI_HANDLE cb_handle);
+
+
 /**
  * @brief Universal PLI print
+ *
+ * Message is printed to simulator transcript (vpi_printf / vhpi_printf) after
+ * log is flushed, with loopback simulator via log writer thread. Runtime level
+ * is the one of "Pli" log category. Messages below PLI_MIN_SEVERITY are
+ * compiled out (their parameters are not evaluated).
+ *
  * @param severity Severity of the message, see t_pli_msg_severity
  * @param fmt Message format to be printed in simulator log
    @param ... Parameters for message format
- * @param
  */
-void pli_printf(t_pli_msg_severity severity, const char *fmt, ...);
+#define pli_printf(severity, ...) \
+    do { \
+        if ((severity) >= PLI_MIN_SEVERITY) \
+            pli_log_printf((severity), __VA_ARGS__); \
+    } while (0)
+
+void pli_log_printf(t_pli_msg_severity severity, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
 
 
 void* pli_malloc(size_t size);
 
+
+/**
+ * @returns Number of heap allocations done by the library so far. It does not
+ *          change once handles of all signals are resolved (allocations happen
+ *          only at start of simulation).
+ */
+size_t pli_get_alloc_count();
+
+
+/**
+ * @returns Number of drives of signals which were skipped since signal already
+ *          had the driven value (see pli_drive_vector_value).
+ */
+size_t pli_get_drive_skip_count();
+
 #endif
@@ -41,6 +41,17 @@
  *      using memory barriers (SW side) and hand-shake like operation (TB side)
  *      of this protocol.
  *
+ *      In doorbell mode (PLI_DOORBELL_MODE), callback on "pli_clk" is armed
+ *      only while it is needed. While request is in progress, callback on
+ *      "pli_ack" is armed instead (simulator calls it only when TB answers).
+ *      Once there is no request, callback on "pli_clk" stays armed for next
+ *      PLI_CLK_LINGER clock cycles (test usually issues next request shortly).
+ *      Then, only "doorbell" callback is armed, which is called each
+ *      PLI_DOORBELL_PERIOD_FS of simulation time, and which arms callback on
+ *      "pli_clk" once test issues request. Idle simulation (e.g.
+ *      while test waits till CAN agent finishes) then runs without callback in
+ *      each clock cycle.
+ *
  *****************************************************************************/
 
 #include <stdio.h>
@@ -53,11 +64,56 @@
 /* Test information shared with test thread */
 char test_name[128];
 
+/* Number of heap allocations of PLI library once simulation started */
+static size_t start_alloc_count = 0;
+
+/*
+ * Doorbell mode, period (in femtoseconds) in which test is checked for new
+ * requests when there are no requests, and number of "pli_clk" cycles for which
+ * callback on "pli_clk" stays armed after last request is processed.
+ */
+#ifndef PLI_DOORBELL_MODE
+    #define PLI_DOORBELL_MODE 1
+#endif
+
+#ifndef PLI_DOORBELL_PERIOD_FS
+    #define PLI_DOORBELL_PERIOD_FS 100000000ULL
+#endif
+
+#ifndef PLI_CLK_LINGER
+    #define PLI_CLK_LINGER 16
+#endif
+
+/* Doorbell period in simulator time units (set at start of simulation) */
+static uint64_t doorbell_period = PLI_DOORBELL_PERIOD_FS;
+
+/* Remaining "pli_clk" cycles before falling back to doorbell */
+static size_t clk_linger = PLI_CLK_LINGER;
+
+/* Callback which processes requests of test */
+enum pli_req_cb {
+    PLI_REQ_CB_NONE,
+    PLI_REQ_CB_CLK,
+    PLI_REQ_CB_ACK,
+    PLI_REQ_CB_DOORBELL
+};
+
+static enum pli_req_cb armed_cb = PLI_REQ_CB_NONE;
+static T_PLI_HANDLE armed_cb_handle = NULL;
+
+/* Number of calls of each callback */
+static size_t n_cb_calls[PLI_REQ_CB_DOORBELL + 1];
+
 /**
  * Functions imported from C++
  */
 void RunCppTest(char* test_name);
 void ProcessPliClkCallback();
+void LogFlush();
+int SimulatorChannelIsIdle();
+int SimulatorChannelWaitsForAck();
+
+static void arm_req_cb(enum pli_req_cb req_cb);
 
 /**
  * Register hook on signal which gives away control to SW part of TB!
@@ -67,21 +123,21 @@ void sw_control_req_callback(PLI_CB_ARG)
     UNUSED_PLI_CB_ARG
 
     char req_val;
-    pli_read_str_value(PLI_SIGNAL_CONTROL_REQ, &(req_val));
+    pli_read_str_value(PLI_SIG_CONTROL_REQ, &(req_val));
     if (req_val != '1') {
         pli_printf(PLI_INFO, "Simulator control request dropped to zero");
         return;
     }
 
     pli_printf(PLI_INFO, "Simulator requests passing control to SW!");
-    pli_drive_str_value(PLI_SIGNAL_CONTROL_GNT, "1");
+    pli_drive_str_value(PLI_SIG_CONTROL_GNT, "1");
     pli_printf(PLI_INFO, "Control passed to SW");
 
     char test_name_binary[1024];
     memset(test_name_binary, 0, sizeof(test_name_binary));
     memset(test_name, 0, sizeof(test_name));
 
-    pli_read_str_value(PLI_SIGNAL_TEST_NAME_ARRAY, &(test_name_binary[0]));
+    pli_read_str_value(PLI_SIG_TEST_NAME_ARRAY, &(test_name_binary[0]));
 
     /*
      * GHDL VPI does not support passing strings or custom arrays.
@@ -101,6 +157,34 @@ void sw_control_req_callback(PLI_CB_ARG)
 }
 
 
+/**
+ * Arms callback which processes requests of test in next step: "doorbell" if
+ * there was no request for PLI_CLK_LINGER clock cycles, callback on "pli_ack"
+ * if request waits for TB, and callback on "pli_clk" otherwise.
+ */
+static void rearm_req_cb()
+{
+    if (!PLI_DOORBELL_MODE)
+        return;
+
+    if (SimulatorChannelIsIdle()) {
+        if (clk_linger > 0) {
+            clk_linger--;
+            arm_req_cb(PLI_REQ_CB_CLK);
+        } else {
+            arm_req_cb(PLI_REQ_CB_DOORBELL);
+        }
+        return;
+    }
+
+    clk_linger = PLI_CLK_LINGER;
+    if (SimulatorChannelWaitsForAck())
+        arm_req_cb(PLI_REQ_CB_ACK);
+    else
+        arm_req_cb(PLI_REQ_CB_CLK);
+}
+
+
 /**
  * PLI clock callback. Called regularly from TB upon PLI clock which is generated
  * in simulation. Processes request from Test thread. Called in simulator context.
@@ -108,7 +192,81 @@ void sw_control_req_callback(PLI_CB_ARG)
 void pli_clk_callback(PLI_CB_ARG)
 {
     UNUSED_PLI_CB_ARG
+    n_cb_calls[PLI_REQ_CB_CLK]++;
+    ProcessPliClkCallback();
+    rearm_req_cb();
+}
+
+
+/**
+ * PLI acknowledge callback. Called when TB answers request from Test thread.
+ * Called in simulator context.
+ */
+void pli_ack_callback(PLI_CB_ARG)
+{
+    UNUSED_PLI_CB_ARG
+    n_cb_calls[PLI_REQ_CB_ACK]++;
     ProcessPliClkCallback();
+    rearm_req_cb();
+}
+
+
+/**
+ * Doorbell callback. Called once per PLI_DOORBELL_PERIOD_FS while there are no
+ * requests from Test thread. Called in simulator context.
+ */
+void pli_doorbell_callback(PLI_CB_ARG)
+{
+    UNUSED_PLI_CB_ARG
+    n_cb_calls[PLI_REQ_CB_DOORBELL]++;
+
+    // Callback after delay is called only once, it is not armed anymore.
+    armed_cb = PLI_REQ_CB_NONE;
+    armed_cb_handle = NULL;
+
+    if (SimulatorChannelIsIdle())
+        arm_req_cb(PLI_REQ_CB_DOORBELL);
+    else
+        arm_req_cb(PLI_REQ_CB_CLK);
+}
+
+
+/**
+ * Arms callback which processes requests of test, and disarms the one which was
+ * armed before.
+ */
+static void arm_req_cb(enum pli_req_cb req_cb)
+{
+    if (req_cb == armed_cb)
+        return;
+
+    if (armed_cb_handle != NULL && pli_remove_cb(armed_cb_handle))
+        pli_printf(PLI_ERROR, "Cannot remove callback processing requests");
+
+    switch (req_cb)
+    {
+    case PLI_REQ_CB_CLK:
+        armed_cb_handle = pli_register_cb(P_PLI_CB_VALUE_CHANGE,
+                                          hman_get_ctu_vip_net_handle(PLI_SIG_CLOCK)->handle,
+                                          &pli_clk_callback);
+        break;
+    case PLI_REQ_CB_ACK:
+        armed_cb_handle = pli_register_cb(P_PLI_CB_VALUE_CHANGE,
+                                          hman_get_ctu_vip_net_handle(PLI_SIG_ACK)->handle,
+                                          &pli_ack_callback);
+        break;
+    case PLI_REQ_CB_DOORBELL:
+        armed_cb_handle = pli_register_delay_cb(doorbell_period, &pli_doorbell_callback);
+        break;
+    default:
+        armed_cb_handle = NULL;
+        break;
+    }
+
+    if (req_cb != PLI_REQ_CB_NONE && armed_cb_handle == NULL)
+        pli_printf(PLI_ERROR, "Cannot register callback processing requests");
+
+    armed_cb = req_cb;
 }
 
 
@@ -118,7 +276,7 @@ void pli_clk_callback(PLI_CB_ARG)
 int register_control_transfer_cb()
 {
     pli_printf(PLI_INFO, "Registering callback for control request...");
-    struct hlist_node* node = hman_get_ctu_vip_net_handle(PLI_SIGNAL_CONTROL_REQ);
+    struct hman_signal *node = hman_get_ctu_vip_net_handle(PLI_SIG_CONTROL_REQ);
 
     if (node == NULL)
     {
@@ -141,7 +299,7 @@ int register_control_transfer_cb()
  */
 int register_pli_clk_cb()
 {
-    struct hlist_node *node = hman_get_ctu_vip_net_handle(PLI_SIGNAL_CLOCK);
+    struct hman_signal *node = hman_get_ctu_vip_net_handle(PLI_SIG_CLOCK);
 
     if (node == NULL)
     {
@@ -149,11 +307,13 @@ int register_pli_clk_cb()
         return -1;
     }
 
-    if (pli_register_cb(P_PLI_CB_VALUE_CHANGE, node->handle, &pli_clk_callback) == NULL)
+    armed_cb_handle = pli_register_cb(P_PLI_CB_VALUE_CHANGE, node->handle, &pli_clk_callback);
+    if (armed_cb_handle == NULL)
     {
         pli_printf(PLI_INFO, "Cannot register cbValueChange call back for %s", PLI_SIGNAL_CLOCK);
         return -2;
     }
+    armed_cb = PLI_REQ_CB_CLK;
 
     return 0;
 }
@@ -167,6 +327,19 @@ void pli_start_of_sim(PLI_CB_ARG)
     UNUSED_PLI_CB_ARG
     pli_printf(PLI_INFO, "Simulation start callback");
 
+    pli_printf(PLI_INFO, "Resolving handles of PLI signals");
+    if (hman_init())
+        pli_printf(PLI_ERROR, "Can't resolve handles of all PLI signals");
+    start_alloc_count = pli_get_alloc_count();
+    pli_printf(PLI_INFO, "Done");
+
+    doorbell_period = PLI_DOORBELL_PERIOD_FS / pli_get_time_resolution_fs();
+    if (doorbell_period == 0)
+        doorbell_period = 1;
+    pli_printf(PLI_INFO, "Simulator time unit: %llu fs, doorbell period: %llu time units",
+               (unsigned long long)pli_get_time_resolution_fs(),
+               (unsigned long long)doorbell_period);
+
     // If order of registration is swapped, then the PLI_CLK callback stops
     // working in NVC once the control transfer callback is called!
 
@@ -188,7 +361,13 @@ void pli_end_of_sim(PLI_CB_ARG)
 {
     UNUSED_PLI_CB_ARG
     pli_printf(PLI_INFO, "End of simulation callback SW");
+    pli_printf(PLI_INFO, "PLI heap allocations during simulation: %zu, skipped drives: %zu",
+               pli_get_alloc_count() - start_alloc_count, pli_get_drive_skip_count());
+    pli_printf(PLI_INFO, "PLI callbacks: clock: %zu, acknowledge: %zu, doorbell: %zu",
+               n_cb_calls[PLI_REQ_CB_CLK], n_cb_calls[PLI_REQ_CB_ACK],
+               n_cb_calls[PLI_REQ_CB_DOORBELL]);
     hman_cleanup();
+    LogFlush();
 }
 
 
@@ -234,4 +413,11 @@ void (*vhpi_startup_routines[])() = {
    0
 };
 
+#elif PLI_KIND == PLI_KIND_LOOPBACK
+
+void (*lb_startup_routines[])() = {
+   handle_register,
+   0
+};
+
 #endif
\ No newline at end of file
@@ -26,32 +26,40 @@
  *
  *****************************************************************************/
 
-#include <chrono>
 #include <iostream>
 #include <iomanip>
 
 #include "DrvItem.h"
 
+static_assert(sizeof(test::DrvItem) == 8, "Driver item shall be 8 byte record");
 
-test::DrvItem::DrvItem(std::chrono::nanoseconds duration, StdLogic value):
-    duration_(duration),
-    value_(value)
-{
-    message_ = std::string();
-}
+
+test::DrvItem::DrvItem(uint32_t cycles, StdLogic value):
+    cycles_(cycles),
+    value_(value),
+    message_id_(PLI_MESSAGE_NONE)
+{}
 
 
-test::DrvItem::DrvItem(std::chrono::nanoseconds duration, StdLogic value,
+test::DrvItem::DrvItem(uint32_t cycles, StdLogic value,
                        std::string message):
-    duration_(duration),
+    cycles_(cycles),
+    value_(value),
+    message_id_(SimulatorChannelInternMessage(message))
+{}
+
+
+test::DrvItem::DrvItem(uint32_t cycles, StdLogic value,
+                       PliMessageId message_id):
+    cycles_(cycles),
     value_(value),
-    message_(message)
+    message_id_(message_id)
 {}
 
 
 bool test::DrvItem::HasMessage()
 {
-    if (message_.size() > 0)
+    if (message_id_ != PLI_MESSAGE_NONE)
         return true;
     return false;
 }
@@ -60,7 +68,7 @@ bool test::DrvItem::HasMessage()
 void test::DrvItem::Print()
 {
     if (HasMessage() == true)
-        std::cout << std::setw (20) << message_;
+        std::cout << std::setw (20) << SimulatorChannelGetMessage(message_id_);
 
     if (value_ == StdLogic::LOGIC_0)
         std::cout << std::setw (20) << "0";
@@ -69,5 +77,5 @@ void test::DrvItem::Print()
     else
         std::cout << std::setw (20) << char(value_);
 
-    std::cout << std::setw (20) << std::dec << duration_.count() << " ns\n";
+    std::cout << std::setw (20) << std::dec << cycles_ << " cycles\n";
 }
\ No newline at end of file
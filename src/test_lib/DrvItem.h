@@ -28,10 +28,11 @@
  *
  *****************************************************************************/
 
+#include <cstdint>
 #include <string>
-#include <chrono>
 
 #include <can_lib.h>
+#include <pli_lib.h>
 
 #include "test.h"
 
@@ -40,13 +41,15 @@
  * @class DriverItem
  * @brief CAN Agent driver item
  *
- * Represents single item to be driver by CAN Agent driver.
+ * Represents single item to be driver by CAN Agent driver. Duration is in clock
+ * cycles, clock period is held once by test sequence (8 bytes per item).
  */
 class test::DrvItem
 {
     public:
-        DrvItem(std::chrono::nanoseconds duration, StdLogic value);
-        DrvItem(std::chrono::nanoseconds duration, StdLogic value, std::string message);
+        DrvItem(uint32_t cycles, StdLogic value);
+        DrvItem(uint32_t cycles, StdLogic value, std::string message);
+        DrvItem(uint32_t cycles, StdLogic value, PliMessageId message_id);
 
         /**
          * @brief Checks if items has message printed by digital simulator when CAN agent starts
@@ -62,10 +65,10 @@ class test::DrvItem
         void Print();
 
         /**
-         * Time for which the item is driven. When this is CAN bit, then this
-         * represents length of the bit on CAN bus.
+         * Number of clock cycles for which the item is driven. When this is CAN
+         * bit, then this represents length of the bit on CAN bus.
          */
-        std::chrono::nanoseconds duration_;
+        uint32_t cycles_;
 
         /**
          * Value which is driven by CAN agent driver.
@@ -73,9 +76,10 @@ class test::DrvItem
         StdLogic value_;
 
         /**
-         * Message to be displayed by digital simulator when driving of item starts.
+         * Id of message (interned by SimulatorChannelInternMessage) to be displayed by
+         * digital simulator when driving of item starts.
          */
-        std::string message_;
+        PliMessageId message_id_;
 };
 
 #endif
\ No newline at end of file
@@ -26,35 +26,43 @@
  *
  *****************************************************************************/
 
-#include <chrono>
 #include <iostream>
 #include <iomanip>
 
 #include "MonItem.h"
 
-test::MonItem::MonItem(std::chrono::nanoseconds duration, StdLogic value,
-                       std::chrono::nanoseconds sample_rate)
+test::MonItem::MonItem(uint32_t cycles, StdLogic value, uint32_t sample_cycles)
 {
-    this->duration_ = duration;
-    this->sample_rate_ = sample_rate;
+    this->cycles_ = cycles;
+    this->sample_cycles_ = sample_cycles;
     this->value_ = value;
-    this->message_ = std::string();
+    this->message_id_ = PLI_MESSAGE_NONE;
 }
 
 
-test::MonItem::MonItem(std::chrono::nanoseconds duration, StdLogic value,
-                       std::chrono::nanoseconds sample_rate, std::string message)
+test::MonItem::MonItem(uint32_t cycles, StdLogic value, uint32_t sample_cycles,
+                       std::string message)
 {
-    this->duration_ = duration;
-    this->sample_rate_ = sample_rate;
+    this->cycles_ = cycles;
+    this->sample_cycles_ = sample_cycles;
     this->value_ = value;
-    this->message_ = message;
+    this->message_id_ = SimulatorChannelInternMessage(message);
+}
+
+
+test::MonItem::MonItem(uint32_t cycles, StdLogic value, uint32_t sample_cycles,
+                       PliMessageId message_id)
+{
+    this->cycles_ = cycles;
+    this->sample_cycles_ = sample_cycles;
+    this->value_ = value;
+    this->message_id_ = message_id;
 }
 
 
 bool test::MonItem::HasMessage()
 {
-    if (message_.size() > 0)
+    if (message_id_ != PLI_MESSAGE_NONE)
         return true;
     return false;
 }
@@ -63,7 +71,7 @@ bool test::MonItem::HasMessage()
 void test::MonItem::Print()
 {
     if (HasMessage())
-        std::cout << std::setw (20) << message_;
+        std::cout << std::setw (20) << SimulatorChannelGetMessage(message_id_);
     std::cout << std::setw (20) << (char)value_;
-    std::cout << std::setw (20) << std::dec << duration_.count() << " ns\n";
+    std::cout << std::setw (20) << std::dec << cycles_ << " cycles\n";
 }
\ No newline at end of file
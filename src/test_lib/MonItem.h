@@ -28,8 +28,10 @@
  *
  *****************************************************************************/
 
+#include <cstdint>
 #include <string>
-#include <chrono>
+
+#include <pli_lib.h>
 
 #include "test.h"
 
@@ -38,15 +40,17 @@
  * @class MonitorItem
  * @brief CAN Agent monitor item
  *
- * Represents single item to be monitored by CAN Agent monitor.
+ * Represents single item to be monitored by CAN Agent monitor. Duration and
+ * sample rate are in clock cycles, clock period is held once by test sequence.
  */
 class test::MonItem
 {
     public:
-        MonItem(std::chrono::nanoseconds duration, StdLogic value,
-                std::chrono::nanoseconds sample_rate);
-        MonItem(std::chrono::nanoseconds duration, StdLogic value,
-                std::chrono::nanoseconds sample_rate, std::string message);
+        MonItem(uint32_t cycles, StdLogic value, uint32_t sample_cycles);
+        MonItem(uint32_t cycles, StdLogic value, uint32_t sample_cycles,
+                std::string message);
+        MonItem(uint32_t cycles, StdLogic value, uint32_t sample_cycles,
+                PliMessageId message_id);
 
         /**
          * Checks if item has message which will be printed by digital simulator
@@ -62,16 +66,16 @@ class test::MonItem
         void Print();
 
         /**
-         * Time for which the item is monitored. When this is CAN bit, then this
-         * represents length of the bit on CAN bus.
+         * Number of clock cycles for which the item is monitored. When this is CAN
+         * bit, then this represents length of the bit on CAN bus.
          */
-        std::chrono::nanoseconds duration_;
+        uint32_t cycles_;
 
         /**
-         * Sample rate of this item. Indicates how often during monitoring of
-         * item CAN agent monitor checks value of can_tx.
+         * Sample rate of this item (in clock cycles). Indicates how often during
+         * monitoring of item CAN agent monitor checks value of can_tx.
          */
-        std::chrono::nanoseconds sample_rate_;
+        uint32_t sample_cycles_;
 
         /**
          * Value towards which can_tc shall be checked by CAN agent monitor during monitoring.
@@ -79,10 +83,10 @@ class test::MonItem
         StdLogic value_;
 
         /**
-         * Message to be displayed by digital simulator when monitoring of item
-         * starts.
+         * Id of message (interned by SimulatorChannelInternMessage) to be displayed
+         * by digital simulator when monitoring of item starts.
          */
-        std::string message_;
+        PliMessageId message_id_;
 };
 
 #endif
\ No newline at end of file
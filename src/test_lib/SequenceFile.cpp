@@ -0,0 +1,323 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *****************************************************************************/
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SequenceFile.h"
+
+
+static void PutVarint(std::vector<uint8_t> &buf, uint64_t val)
+{
+    while (val >= 0x80)
+    {
+        buf.push_back(static_cast<uint8_t>(val | 0x80));
+        val >>= 7;
+    }
+    buf.push_back(static_cast<uint8_t>(val));
+}
+
+
+static void PutLe(std::vector<uint8_t> &buf, uint64_t val, size_t n_bytes)
+{
+    for (size_t i = 0; i < n_bytes; i++)
+        buf.push_back(static_cast<uint8_t>(val >> (8 * i)));
+}
+
+
+static uint64_t GetLe(const uint8_t *data, size_t n_bytes)
+{
+    uint64_t val = 0;
+    for (size_t i = 0; i < n_bytes; i++)
+        val |= static_cast<uint64_t>(data[i]) << (8 * i);
+    return val;
+}
+
+
+/**
+ * @returns true if byte is one of StdLogic values.
+ */
+static bool IsStdLogic(uint8_t byte)
+{
+    switch (static_cast<test::StdLogic>(byte))
+    {
+    case test::StdLogic::LOGIC_0:
+    case test::StdLogic::LOGIC_1:
+    case test::StdLogic::LOGIC_H:
+    case test::StdLogic::LOGIC_L:
+    case test::StdLogic::LOGIC_Z:
+    case test::StdLogic::LOGIC_X:
+    case test::StdLogic::LOGIC_W:
+    case test::StdLogic::LOGIC_U:
+    case test::StdLogic::LOGIC_DC:
+        return true;
+    default:
+        return false;
+    }
+}
+
+
+/**
+ * Decodes varint at given offset, and moves offset behind it.
+ * @returns false if varint exceeds end of data.
+ */
+static bool GetVarint(const uint8_t *data, size_t size, size_t *offset, uint64_t *val)
+{
+    *val = 0;
+    for (size_t shift = 0; shift < 64 && *offset < size; shift += 7)
+    {
+        uint8_t byte = data[(*offset)++];
+        *val |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+
+test::SequenceFile::~SequenceFile()
+{
+    Close();
+}
+
+
+bool test::SequenceFile::Write(const std::string &path, TestSequence &sequence)
+{
+    PliFemtoseconds clock_period = sequence.GetClockPeriod();
+    std::vector<uint8_t> messages;
+    std::vector<uint8_t> records;
+    std::unordered_map<PliMessageId, uint32_t> msg_index;
+
+    if (clock_period <= PliFemtoseconds(0))
+        return false;
+
+    auto add_message = [&](PliMessageId msg_id) -> uint32_t {
+        if (msg_id == PLI_MESSAGE_NONE)
+            return 0;
+        auto it = msg_index.find(msg_id);
+        if (it != msg_index.end())
+            return it->second;
+
+        const std::string &msg = SimulatorChannelGetMessage(msg_id);
+        PutVarint(messages, msg.size());
+        messages.insert(messages.end(), msg.begin(), msg.end());
+
+        uint32_t index = static_cast<uint32_t>(msg_index.size() + 1);
+        msg_index.emplace(msg_id, index);
+        return index;
+    };
+
+    for (size_t i = 0; i < sequence.GetNumDriverItems(); i++)
+    {
+        DrvItem *item = sequence.GetDriverItem(static_cast<int>(i));
+        records.push_back(static_cast<uint8_t>(item->value_));
+        PutVarint(records, item->cycles_);
+        PutVarint(records, add_message(item->message_id_));
+    }
+
+    for (size_t i = 0; i < sequence.GetNumMonitorItems(); i++)
+    {
+        MonItem *item = sequence.GetMonitorItem(static_cast<int>(i));
+        records.push_back(static_cast<uint8_t>(item->value_));
+        PutVarint(records, item->cycles_);
+        PutVarint(records, item->sample_cycles_);
+        PutVarint(records, add_message(item->message_id_));
+    }
+
+    std::vector<uint8_t> header;
+    char magic[8] = {};
+    strncpy(magic, SEQUENCE_FILE_MAGIC, sizeof(magic));
+    header.insert(header.end(), magic, magic + sizeof(magic));
+    PutLe(header, SEQUENCE_FILE_VERSION, 4);
+    PutLe(header, msg_index.size(), 4);
+    PutLe(header, static_cast<uint64_t>(clock_period.count()), 8);
+    PutLe(header, sequence.GetNumDriverItems(), 4);
+    PutLe(header, sequence.GetNumMonitorItems(), 4);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(header.data()),
+               static_cast<std::streamsize>(header.size()));
+    file.write(reinterpret_cast<const char*>(messages.data()),
+               static_cast<std::streamsize>(messages.size()));
+    file.write(reinterpret_cast<const char*>(records.data()),
+               static_cast<std::streamsize>(records.size()));
+
+    return file.good();
+}
+
+
+bool test::SequenceFile::Open(const std::string &path)
+{
+    Close();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "Can't open sequence file: " << path << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < SEQUENCE_FILE_HEADER_SIZE)
+    {
+        std::cerr << "Sequence file too short: " << path << std::endl;
+        close(fd);
+        return false;
+    }
+
+    void *map = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        std::cerr << "Can't map sequence file: " << path << std::endl;
+        return false;
+    }
+
+    data_ = static_cast<const uint8_t*>(map);
+    size_ = static_cast<size_t>(st.st_size);
+
+    if (!Parse())
+    {
+        std::cerr << "Invalid sequence file: " << path << std::endl;
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+
+void test::SequenceFile::Close()
+{
+    if (data_ != nullptr)
+        munmap(const_cast<uint8_t*>(data_), size_);
+
+    data_ = nullptr;
+    size_ = 0;
+    messages_.clear();
+    n_driver_items_ = 0;
+    n_monitor_items_ = 0;
+}
+
+
+bool test::SequenceFile::Parse()
+{
+    char magic[8] = {};
+    strncpy(magic, SEQUENCE_FILE_MAGIC, sizeof(magic));
+    if (memcmp(data_, magic, sizeof(magic)) != 0 ||
+        GetLe(data_ + 8, 4) != SEQUENCE_FILE_VERSION)
+        return false;
+
+    size_t n_messages = GetLe(data_ + 12, 4);
+    uint64_t clock_period = GetLe(data_ + 16, 8);
+    n_driver_items_ = GetLe(data_ + 24, 4);
+    n_monitor_items_ = GetLe(data_ + 28, 4);
+
+    if (clock_period == 0 || clock_period > INT64_MAX)
+        return false;
+    clock_period_ = PliFemtoseconds(static_cast<int64_t>(clock_period));
+
+    size_t offset = SEQUENCE_FILE_HEADER_SIZE;
+    uint64_t val;
+
+    for (size_t i = 0; i < n_messages; i++)
+    {
+        if (!GetVarint(data_, size_, &offset, &val) || val > size_ - offset)
+            return false;
+        messages_.emplace_back(reinterpret_cast<const char*>(data_ + offset),
+                               static_cast<size_t>(val));
+        offset += static_cast<size_t>(val);
+    }
+
+    // Check records, so that Read does not need to
+    driver_offset_ = offset;
+    for (size_t i = 0; i < n_driver_items_ + n_monitor_items_; i++)
+    {
+        if (i == n_driver_items_)
+            monitor_offset_ = offset;
+
+        size_t n_varints = (i < n_driver_items_) ? 2 : 3;
+        if (offset >= size_ || !IsStdLogic(data_[offset++]))
+            return false;
+        for (size_t j = 0; j < n_varints; j++)
+        {
+            if (!GetVarint(data_, size_, &offset, &val))
+                return false;
+
+            // Durations and sample rates shall fit to items
+            if (j < n_varints - 1 && val > UINT32_MAX)
+                return false;
+        }
+        if (val > n_messages)
+            return false;
+    }
+    if (n_monitor_items_ == 0)
+        monitor_offset_ = offset;
+
+    return offset == size_;
+}
+
+
+void test::SequenceFile::Read(TestSequence &sequence)
+{
+    std::vector<PliMessageId> msg_ids;
+    size_t offset = driver_offset_;
+    uint64_t cycles;
+    uint64_t sample_cycles;
+    uint64_t msg;
+
+    msg_ids.push_back(PLI_MESSAGE_NONE);
+    for (auto &message : messages_)
+        msg_ids.push_back(SimulatorChannelInternMessage(std::string(message)));
+
+    for (size_t i = 0; i < n_driver_items_; i++)
+    {
+        StdLogic value = static_cast<StdLogic>(data_[offset++]);
+        GetVarint(data_, size_, &offset, &cycles);
+        GetVarint(data_, size_, &offset, &msg);
+        sequence.AppendDriverItem(DrvItem(static_cast<uint32_t>(cycles), value, msg_ids[msg]));
+    }
+
+    offset = monitor_offset_;
+    for (size_t i = 0; i < n_monitor_items_; i++)
+    {
+        StdLogic value = static_cast<StdLogic>(data_[offset++]);
+        GetVarint(data_, size_, &offset, &cycles);
+        GetVarint(data_, size_, &offset, &sample_cycles);
+        GetVarint(data_, size_, &offset, &msg);
+        sequence.AppendMonitorItem(MonItem(static_cast<uint32_t>(cycles), value,
+                                           static_cast<uint32_t>(sample_cycles), msg_ids[msg]));
+    }
+}
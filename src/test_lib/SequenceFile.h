@@ -0,0 +1,139 @@
+#ifndef SEQUENCE_FILE_H
+#define SEQUENCE_FILE_H
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Binary file with driver and monitor sequence of test sequence.
+ *
+ * File layout (integers of header are little endian):
+ *
+ *   Header:
+ *      char     magic[8]           "CANSEQ" padded by zeros
+ *      uint32_t version            SEQUENCE_FILE_VERSION
+ *      uint32_t n_messages         Number of messages
+ *      uint64_t clock_period       Clock period in femtoseconds
+ *      uint32_t n_driver_items     Number of driver records
+ *      uint32_t n_monitor_items    Number of monitor records
+ *
+ *   Messages:          varint length, characters (without terminator)
+ *   Driver records:    value (character), varint duration, varint message
+ *   Monitor records:   value (character), varint duration, varint sample rate,
+ *                      varint message
+ *
+ * Durations and sample rates are in clock cycles. Message of a record is index
+ * to messages of the file starting with 1, 0 means record has no message.
+ * Varints are unsigned LEB128 (7 bits per byte, least significant first).
+ *
+ * File holds no pointers nor aligned data, so it is read directly from memory
+ * mapping of the file.
+ *****************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "test.h"
+#include "TestSequence.h"
+
+#define SEQUENCE_FILE_MAGIC "CANSEQ"
+#define SEQUENCE_FILE_VERSION 2
+#define SEQUENCE_FILE_HEADER_SIZE 32
+
+
+/**
+ * @namespace test
+ * @class SequenceFile
+ * @brief Sequence file mapped to memory.
+ */
+class test::SequenceFile
+{
+    public:
+        SequenceFile() = default;
+        SequenceFile(const SequenceFile&) = delete;
+        SequenceFile& operator=(const SequenceFile&) = delete;
+        ~SequenceFile();
+
+        /**
+         * @brief Writes driver and monitor sequence of test sequence to file.
+         * @param path Path of the file.
+         * @param sequence Sequence to write.
+         * @returns true if file was written, false if file can't be written.
+         */
+        static bool Write(const std::string &path, TestSequence &sequence);
+
+        /**
+         * @brief Maps file to memory and checks its header and records.
+         * @param path Path of the file.
+         * @returns true if file is valid sequence file, false otherwise.
+         */
+        bool Open(const std::string &path);
+
+        /**
+         * @brief Unmaps file.
+         */
+        void Close();
+
+        /**
+         * @brief Appends items of the file to driver and monitor sequence.
+         * @param sequence Test sequence (with the same clock period as the file).
+         */
+        void Read(TestSequence &sequence);
+
+        PliFemtoseconds GetClockPeriod() const { return clock_period_; }
+        size_t GetNumDriverItems() const { return n_driver_items_; }
+        size_t GetNumMonitorItems() const { return n_monitor_items_; }
+
+        /**
+         * @returns Size of the file in bytes.
+         */
+        size_t GetSize() const { return size_; }
+
+        /**
+         * @param index Index of message (starting with 1).
+         * @returns Message of the file (points to mapping of the file).
+         */
+        std::string_view GetMessage(size_t index) const { return messages_[index - 1]; }
+        size_t GetNumMessages() const { return messages_.size(); }
+
+    private:
+        const uint8_t *data_ = nullptr;
+        size_t size_ = 0;
+
+        PliFemtoseconds clock_period_{0};
+        size_t n_driver_items_ = 0;
+        size_t n_monitor_items_ = 0;
+        std::vector<std::string_view> messages_;
+
+        /* Offset of first driver and monitor record */
+        size_t driver_offset_ = 0;
+        size_t monitor_offset_ = 0;
+
+        bool Parse();
+};
+
+#endif
@@ -36,12 +36,14 @@
 #include <test_lib.h>
 
 #include "TestLoader.h"
+#include "../cosimulation/Log.hpp"
 
 
 /******************************************************************************
  * Implementations of compliance tests
  *****************************************************************************/
 #include "../compliance_tests/TestDemo.cpp"
+#include "../compliance_tests/TestReplay.cpp"
 
 #include "../compliance_tests/TestIso_7_1_1.cpp"
 #include "../compliance_tests/TestIso_7_1_2.cpp"
@@ -274,6 +276,8 @@ test::TestBase* ConstructTestObject(std::string name)
         test_ptr = new TestBase;
     } else if (name == "demo") {
         test_ptr = new TestDemo;
+    } else if (name == "replay") {
+        test_ptr = new TestReplay;
     } else if (name == "iso_7_1_1") {
         test_ptr = new TestIso_7_1_1;
     } else if (name == "iso_7_1_2") {
@@ -690,53 +694,49 @@ test::TestBase* ConstructTestObject(std::string name)
 }
 
 
+/**
+ * Formats test message and queues it to log.
+ */
+static void TestVMessage(const char *fmt, va_list args)
+{
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    std::string line = "\033[1;92mSW test: \033[0m";
+    size_t prefix_len = line.size();
+    int len = vsnprintf(nullptr, 0, fmt, args);
+    line.resize(prefix_len + static_cast<size_t>(len > 0 ? len : 0));
+    vsnprintf(&line[prefix_len], line.size() - prefix_len + 1, fmt, args_copy);
+    va_end(args_copy);
+
+    LogWrite(LogCategory::Test, LogSeverity::Info, line);
+}
+
+
 void TestMessage(const char *fmt, ...)
 {
+    if (!LOG_ENABLED(LogCategory::Test, LogSeverity::Info))
+        return;
+
     va_list args;
     va_start(args, fmt);
-
-    printf("\033[1;92mSW test: \033[0m");
-
-    while (*fmt != '\0')
-    {
-        if (*fmt != '%')
-        {
-            printf("%c", *fmt);
-            fmt++;
-            continue;
-        }
-
-        fmt++;
-
-        switch (*fmt)
-        {
-        case 'd':
-            printf("%d", va_arg(args, int));
-            break;
-        case 'f':
-            printf("%f", va_arg(args, double));
-            break;
-        case 's':
-            printf("%s", va_arg(args, char *));
-            break;
-        case 'c':
-            printf("%c", va_arg(args, int));
-            break;
-        default:
-            break;
-        }
-        fmt++;
-    }
+    TestVMessage(fmt, args);
     va_end(args);
-    printf("\n");
-    fflush(stdout);
 }
 
-void TestBigMessage(std::string message, ...)
+
+void TestBigMessage(const char *fmt, ...)
 {
-    TestMessage(std::string(80, '*').c_str());
-    TestMessage(message.c_str());
-    TestMessage(std::string(80, '*').c_str());
+    if (!LOG_ENABLED(LogCategory::Test, LogSeverity::Info))
+        return;
+
+    const std::string line(80, '*');
+    va_list args;
+    va_start(args, fmt);
+    TestMessage("%s", line.c_str());
+    TestVMessage(fmt, args);
+    TestMessage("%s", line.c_str());
+    va_end(args);
 }
 
 
@@ -750,9 +750,7 @@ int cppTestThread(char *test_name)
 
 void RunCppTest(char* test_name)
 {
-    TestMessage(std::string(80, '*').c_str());
-    TestMessage("Running C++ test: %s", test_name);
-    TestMessage(std::string(80, '*').c_str());
+    TestBigMessage("Running C++ test: %s", test_name);
 
     testThread = new std::thread(cppTestThread, test_name);
 
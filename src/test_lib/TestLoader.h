@@ -59,18 +59,18 @@ test::TestBase* ConstructTestObject(std::string name);
 
 
 /**
- * Prints message to standard output. Message with "SW test" prefix is printed.
+ * Prints message to standard output (via log writer thread, category "Test").
+ * Message with "SW test" prefix is printed.
  *
- * @param message String to be printed.
- * @todo Implement support of varargs!
+ * @param fmt Format of message (as printf).
  */
-void TestMessage(const char *fmt, ...);
+void TestMessage(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
 
 
 /**
  * Prints message enclosed with line of "*".
- * @param message String to be printed.
+ * @param fmt Format of message (as printf).
  */
-void TestBigMessage(std::string message, ...);
+void TestBigMessage(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
 
 #endif
\ No newline at end of file
@@ -31,17 +31,21 @@
 
 #include "TestSequence.h"
 
-test::TestSequence::TestSequence(std::chrono::nanoseconds clock_period)
+test::TestSequence::TestSequence(PliFemtoseconds clock_period,
+                                 SequenceMessages messages)
 {
     this->clock_period = clock_period;
+    this->messages = messages;
 }
 
 
-test::TestSequence::TestSequence(std::chrono::nanoseconds clock_period,
+test::TestSequence::TestSequence(PliFemtoseconds clock_period,
                                  can::BitFrame& frame,
-                                 SequenceType sequence_type)
+                                 SequenceType sequence_type,
+                                 SequenceMessages messages)
 {
     this->clock_period = clock_period;
+    this->messages = messages;
 
     if (sequence_type == SequenceType::DRIVER_SEQUENCE) {
         driven_values.clear();
@@ -53,11 +57,13 @@ test::TestSequence::TestSequence(std::chrono::nanoseconds clock_period,
 }
 
 
-test::TestSequence::TestSequence(std::chrono::nanoseconds clock_period,
+test::TestSequence::TestSequence(PliFemtoseconds clock_period,
                                  can::BitFrame& driver_frame,
-                                 can::BitFrame& monitor_frame)
+                                 can::BitFrame& monitor_frame,
+                                 SequenceMessages messages)
 {
     this->clock_period = clock_period;
+    this->messages = messages;
     monitored_values.clear();
     driven_values.clear();
 
@@ -69,29 +75,27 @@ test::TestSequence::TestSequence(std::chrono::nanoseconds clock_period,
 void test::TestSequence::AppendDriverFrame(can::BitFrame& driver_frame)
 {
     size_t bit_count = driver_frame.GetLen();
-    can::Bit *bit;
+    size_t items_before = driven_values.size();
 
     for (size_t i = 0; i < bit_count; i++)
-    {
-        bit = driver_frame.GetBit(i);
-        AppendDriverBit(bit);
-    }
+        AppendDriverBit(driver_frame.GetBit(i));
+
+    stats.bits += bit_count;
+    stats.driver_items_after += driven_values.size() - items_before;
 }
 
 
 void test::TestSequence::AppendMonitorFrame(can::BitFrame& monitor_frame)
 {
     size_t bit_count = monitor_frame.GetLen();
-    can::Bit *bit;
-    can::Bit *next_bit = nullptr;
+    size_t items_before = monitored_values.size();
 
     for (size_t i = 0; i < bit_count; i++)
     {
-        bit = monitor_frame.GetBit(i);
+        can::Bit *bit = monitor_frame.GetBit(i);
 
-        // Ugly and low performing, I know, but we dont care here!
-        if (i < bit_count - 1)
-            next_bit = monitor_frame.GetBit(i + 1);
+        // Last bit is checked against itself (it has no next bit)
+        can::Bit *next_bit = (i < bit_count - 1) ? monitor_frame.GetBit(i + 1) : bit;
 
         if (bit->kind_ == can::BitKind::Brs ||
             bit->kind_ == can::BitKind::CrcDelim ||
@@ -107,194 +111,163 @@ void test::TestSequence::AppendMonitorFrame(can::BitFrame& monitor_frame)
         else
             appendMonitorNotShift(bit);
     }
+
+    stats.bits += bit_count;
+    stats.monitor_items_after += monitored_values.size() - items_before;
 }
 
 
-void test::TestSequence::AppendDriverBit(can::Bit* bit)
+test::MonItem* test::TestSequence::GetMonitorItem(int index)
+{
+    if (index < 0 || static_cast<size_t>(index) >= monitored_values.size())
+        return nullptr;
+    return &monitored_values[static_cast<size_t>(index)];
+}
+
+
+test::DrvItem* test::TestSequence::GetDriverItem(int index)
 {
-    size_t time_quantas = bit->GetLenTQ();
-    size_t cycles;
+    if (index < 0 || static_cast<size_t>(index) >= driven_values.size())
+        return nullptr;
+    return &driven_values[static_cast<size_t>(index)];
+}
 
-    can::BitVal bit_val = bit->val_;
-    can::BitVal last_val = bit_val;
-    can::BitVal curr_val;
-    can::TimeQuanta *time_quanta;
-    can::Cycle* cycle;
 
-    std::chrono::nanoseconds duration (0);
+void test::TestSequence::AppendDriverItem(DrvItem driver_item)
+{
+    driven_values.push_back(driver_item);
+    driver_mergeable = false;
+}
 
-    for (size_t i = 0; i < time_quantas; i++)
+
+void test::TestSequence::AppendMonitorItem(MonItem monitor_item)
+{
+    monitored_values.push_back(monitor_item);
+    monitor_mergeable = false;
+}
+
+
+void test::TestSequence::AppendDriverBit(can::Bit* bit)
+{
+    size_t len_cycles = bit->GetLenCycles();
+    can::BitVal val;
+
+    // Each run of cycles with equal value is single driven item, and first run is merged
+    // with last item when its value is equal. Note that this merges also forced values
+    // equal to default value of a bit into single item!
+    for (size_t offset = 0; offset < len_cycles;)
     {
-        time_quanta = bit->GetTQ(i);
-        cycles = time_quanta->getLengthCycles();
-
-        for (size_t j = 0; j < cycles; j++)
-        {
-            cycle = time_quanta->getCycleBitValue(j);
-
-            // Obtain value of current cycle
-            // Note: This ignores non-default values which are equal to
-            //       its default value (as expected) and merges them into
-            //       single monitored / driven item!
-            if (cycle->has_def_val())
-                curr_val = bit_val;
-            else
-                curr_val = cycle->bit_val();
-
-            // Did not detect bit value change -> it still belongs to the same segment
-            // -> legnthen it
-            if (curr_val == last_val)
-                duration += clock_period;
-
-            // Detected value change, push previous item
-            if (curr_val != last_val)
-            {
-                pushDriverValue(duration, last_val, bit->GetBitKindName());
-
-                duration = clock_period;
-                last_val = curr_val;
-            }
-
-            // Reach last cycle of bit, push rest
-            if ((i == time_quantas - 1) && (j == cycles - 1))
-                pushDriverValue(duration, last_val, bit->GetBitKindName());
-        }
+        size_t end = bit->GetValRunEnd(offset, &val);
+        appendDriverRun(end - offset, val, bit);
+        offset = end;
     }
 }
 
 void test::TestSequence::appendMonitorBitWithShift(can::Bit *bit)
 {
-    std::chrono::nanoseconds tseg_1_duration (0);
-    std::chrono::nanoseconds tseg_2_duration (0);
-
     // Currently this function does not support translation with forcing on Bits
     // with Bit-rate shift, check it!
-    for (size_t i = 0; i < bit->GetLenTQ(); i++)
-        for (size_t j = 0; j < bit->GetTQ(i)->getLengthCycles(); j++)
-            assert(bit->GetTQ(i)->getCycleBitValue(j)->has_def_val()
-                    && "Forcing not supported on Bits with Bit-rate shift!");
+    assert(!bit->HasNonDefVals() && "Forcing not supported on Bits with Bit-rate shift!");
 
     /* Count Tseg1 duration */
     size_t tseg_1_len = bit->GetPhaseLenTQ(can::BitPhase::Sync);
     tseg_1_len += bit->GetPhaseLenTQ(can::BitPhase::Prop);
     tseg_1_len += bit->GetPhaseLenTQ(can::BitPhase::Ph1);
 
-    /* Count Tseg2 duration */
-    size_t tseg_2_len = bit->GetPhaseLenTQ(can::BitPhase::Ph2);
-
-    /* Count lenghts in nanoseconds */
-    for (size_t i = 0; i < tseg_1_len; i++)
-        for (size_t j = 0; j < bit->GetTQ(i)->getLengthCycles(); j++)
-            tseg_1_duration += clock_period;
-
-    for (size_t i = 0; i < tseg_2_len; i++)
-        for (size_t j = 0; j < bit->GetTQ(can::BitPhase::Ph2, i)->getLengthCycles(); j++)
-            tseg_2_duration += clock_period;
+    /* Count lenghts in clock cycles */
+    size_t tseg_1_cycles = bit->GetPhaseLenCycles(can::BitPhase::Sync) +
+                           bit->GetPhaseLenCycles(can::BitPhase::Prop) +
+                           bit->GetPhaseLenCycles(can::BitPhase::Ph1);
+    size_t tseg_2_cycles = bit->GetPhaseLenCycles(can::BitPhase::Ph2);
 
     // Get sample rate for each phase and push monitor item. Push only if the phase has non-zero
     // lenght. No need to monitor time sequences with 0 duration. Also, if e.g TSEG2 is 0 due
     // to its shortening in the test, we would not be able to query its Time Quanta 0!
-    if (tseg_1_duration > std::chrono::nanoseconds(0))
+    if (tseg_1_cycles > 0)
     {
-        size_t brp = bit->GetTQ(can::BitPhase::Sync, 0)->getLengthCycles();
-        std::chrono::nanoseconds sampleRateNominal = brp * clock_period;
-        pushMonitorValue(tseg_1_duration, sampleRateNominal, bit->val_, bit->GetBitKindName());
+        size_t brp = bit->GetTQLenCycles(0);
+        appendMonitorRun(tseg_1_cycles, brp, bit->val_, bit);
     }
 
-    if (tseg_2_duration > std::chrono::nanoseconds(0))
+    if (tseg_2_cycles > 0)
     {
-        size_t brp_fd = bit->GetTQ(can::BitPhase::Ph2, 0)->getLengthCycles();
-        std::chrono::nanoseconds sampleRateData = brp_fd * clock_period;
-        pushMonitorValue(tseg_2_duration, sampleRateData, bit->val_, bit->GetBitKindName());
+        size_t brp_fd = bit->GetTQLenCycles(tseg_1_len);
+        appendMonitorRun(tseg_2_cycles, brp_fd, bit->val_, bit);
     }
 }
 
 void test::TestSequence::appendMonitorNotShift(can::Bit *bit)
 {
-    size_t time_quantas = bit->GetLenTQ();
-    size_t cycles;
-
-    can::BitVal bit_val = bit->val_;
-    can::BitVal last_value = bit_val;
-    can::BitVal current_value;
-    can::TimeQuanta *time_quanta;
-    can::Cycle* cycle;
-
-    std::chrono::nanoseconds duration (0);
-
+    size_t len_cycles = bit->GetLenCycles();
+    can::BitVal val;
 
     // Assume first Time quanta length is the same as rest (which is reasonable)!
-    size_t brp = bit->GetTQ(0)->getLengthCycles();
-    std::chrono::nanoseconds sample_rate = brp * clock_period;
+    size_t brp = bit->GetTQLenCycles(0);
 
-    for (size_t i = 0; i < time_quantas; i++)
+    // Each run of cycles with equal value is single monitored item, and first run is
+    // merged with last item when its value and sample rate are equal. Note that this
+    // merges also forced values equal to default value of a bit into single item!
+    for (size_t offset = 0; offset < len_cycles;)
     {
-        time_quanta = bit->GetTQ(i);
-        cycles = time_quanta->getLengthCycles();
-
-        for (size_t j = 0; j < cycles; j++)
-        {
-            cycle = time_quanta->getCycleBitValue(j);
-
-            // Obtain value of current cycle
-            // Note: This ignores non-default values which are equal to
-            //       its default value (as expected) and merges them into
-            //       single monitored / driven item!
-            if (cycle->has_def_val())
-                current_value = bit_val;
-            else
-                current_value = cycle->bit_val();
-
-            // Did not detect bit value change -> it still belongs to the same segment
-            // -> legnthen it
-            if (current_value == last_value)
-                duration += clock_period;
-
-            // Detected value change, push previous item
-            if (current_value != last_value)
-            {
-                pushMonitorValue(duration, sample_rate, last_value, bit->GetBitKindName());
-
-                duration = clock_period;
-                last_value = current_value;
-            }
-
-            // Reach last cycle of bit, push rest
-            if ((i == time_quantas - 1) && (j == cycles - 1))
-            {
-                pushMonitorValue(duration, sample_rate, last_value, bit->GetBitKindName());
-            }
-        }
+        size_t end = bit->GetValRunEnd(offset, &val);
+        appendMonitorRun(end - offset, brp, val, bit);
+        offset = end;
     }
 }
 
 
-void test::TestSequence::pushDriverValue(std::chrono::nanoseconds duration,
-                                             can::BitVal bit_value,
-                                             std::string message)
+PliMessageId test::TestSequence::GetKindMessage(can::Bit *bit)
 {
-    StdLogic logic_val;
-    if (bit_value == can::BitVal::Dominant)
-        logic_val = StdLogic::LOGIC_0;
-    else
-        logic_val = StdLogic::LOGIC_1;
-
-    driven_values.push_back(DrvItem(duration, logic_val, message));
+    PliMessageId &msg_id = kind_messages[static_cast<size_t>(bit->kind_)];
+    if (msg_id == PLI_MESSAGE_NONE)
+        msg_id = SimulatorChannelInternMessage(bit->GetBitKindName());
+    return msg_id;
 }
 
 
-void test::TestSequence::pushMonitorValue(std::chrono::nanoseconds duration,
-                                              std::chrono::nanoseconds sample_rate,
-                                              can::BitVal bit_value,
-                                              std::string message)
+void test::TestSequence::appendDriverRun(size_t cycles, can::BitVal bit_value, can::Bit *bit)
 {
-    StdLogic logic_val;
-    if (bit_value == can::BitVal::Dominant)
-        logic_val = StdLogic::LOGIC_0;
+    StdLogic logic_val = (bit_value == can::BitVal::Dominant) ? StdLogic::LOGIC_0 :
+                                                                  StdLogic::LOGIC_1;
+    uint32_t run_cycles = static_cast<uint32_t>(cycles);
+    stats.driver_items_before++;
+
+    if (driver_mergeable && driven_values.back().value_ == logic_val &&
+        driven_values.back().cycles_ <= UINT32_MAX - run_cycles) {
+        driven_values.back().cycles_ += run_cycles;
+        return;
+    }
+
+    if (messages == SequenceMessages::RunStart)
+        driven_values.push_back(DrvItem(run_cycles, logic_val, GetKindMessage(bit)));
     else
-        logic_val = StdLogic::LOGIC_1;
+        driven_values.push_back(DrvItem(run_cycles, logic_val));
+    driver_mergeable = true;
+}
+
+
+void test::TestSequence::appendMonitorRun(size_t cycles, size_t sample_cycles,
+                                          can::BitVal bit_value, can::Bit *bit)
+{
+    StdLogic logic_val = (bit_value == can::BitVal::Dominant) ? StdLogic::LOGIC_0 :
+                                                                  StdLogic::LOGIC_1;
+    uint32_t run_cycles = static_cast<uint32_t>(cycles);
+    uint32_t run_sample_cycles = static_cast<uint32_t>(sample_cycles);
+    stats.monitor_items_before++;
+
+    if (monitor_mergeable && monitored_values.back().value_ == logic_val &&
+        monitored_values.back().sample_cycles_ == run_sample_cycles &&
+        monitored_values.back().cycles_ <= UINT32_MAX - run_cycles) {
+        monitored_values.back().cycles_ += run_cycles;
+        return;
+    }
 
-    monitored_values.push_back(MonItem(duration, logic_val, sample_rate, message));
+    if (messages == SequenceMessages::RunStart)
+        monitored_values.push_back(MonItem(run_cycles, logic_val, run_sample_cycles,
+                                           GetKindMessage(bit)));
+    else
+        monitored_values.push_back(MonItem(run_cycles, logic_val, run_sample_cycles));
+    monitor_mergeable = true;
 }
 
 
@@ -317,26 +290,15 @@ void test::TestSequence::PrintMonitoredValues()
 void test::TestSequence::PushDriverValuesToSimulator()
 {
     for (auto &tmp : driven_values)
-    {
-        if (tmp.HasMessage())
-            CanAgentDriverPushItem((char)tmp.value_, tmp.duration_, tmp.message_);
-        else
-            CanAgentDriverPushItem((char)tmp.value_, tmp.duration_);
-    }
+        CanAgentDriverPushItem((char)tmp.value_, tmp.cycles_ * clock_period, tmp.message_id_);
 }
 
 
 void test::TestSequence::PushMonitorValuesToSimulator()
 {
     for (auto &tmp : monitored_values)
-    {
-        if (tmp.HasMessage())
-            CanAgentMonitorPushItem((char)tmp.value_, tmp.duration_,
-                                    tmp.sample_rate_, tmp.message_);
-        else
-            CanAgentMonitorPushItem((char)tmp.value_, tmp.duration_,
-                                    tmp.sample_rate_);
-    }
+        CanAgentMonitorPushItem((char)tmp.value_, tmp.cycles_ * clock_period,
+                                tmp.sample_cycles_ * clock_period, tmp.message_id_);
 }
 
 void test::TestSequence::Print(bool driven)
@@ -344,7 +306,7 @@ void test::TestSequence::Print(bool driven)
     std::cout
         << std::setw (20) << "Field"
         << std::setw (20) << "Value"
-        << std::setw (20) << "Duration (ns)"<< std::endl;
+        << std::setw (20) << "Duration (cycles)"<< std::endl;
 
     if (driven) {
         for (auto &tmp : driven_values)
@@ -354,4 +316,13 @@ void test::TestSequence::Print(bool driven)
             tmp.Print();
     }
 
-}
\ No newline at end of file
+}
+
+void test::TestSequence::PrintStats()
+{
+    std::cout << "Compiled bits: " << stats.bits
+              << ", driver items: " << stats.driver_items_before << " -> "
+              << stats.driver_items_after
+              << ", monitor items: " << stats.monitor_items_before << " -> "
+              << stats.monitor_items_after << std::endl;
+}
@@ -28,6 +28,7 @@
  *
  *****************************************************************************/
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <chrono>
@@ -48,15 +49,44 @@
  * Test sequence contains sequence for CAN Agent driver and for CAN Agent
  * monitor. Driver sequence will be driven by CAN agent to "can_rx" of DUT
  * and Monitor sequence will be checked by CAN agent on "can_tx" of DUT.
+ *
+ * Frames are compiled to items in single pass over bits of the frame. Each run
+ * of cycles with equal value is single item, also when the run spans several
+ * bits (e.g. recessive bits of EOF, intermission and idle). Monitor items are
+ * merged only when they have equal sample rate.
+ *
+ * Items hold durations and sample rates in clock cycles. Clock period is held
+ * once by the sequence, and durations are converted to simulator time only when
+ * items are pushed to simulator.
  */
 class test::TestSequence
 {
     public:
-        TestSequence(std::chrono::nanoseconds clock_period);
-        TestSequence(std::chrono::nanoseconds clock_period, can::BitFrame& frame,
-                     SequenceType sequence_type);
-        TestSequence(std::chrono::nanoseconds clock_period, can::BitFrame& driver_frame,
-                     can::BitFrame& monitor_frame);
+        /**
+         * @struct Statistics of compilation of frames to items.
+         */
+        struct Stats
+        {
+            /* Number of compiled bits */
+            size_t bits = 0;
+
+            /* Number of items if each run of cycles within a bit was single item */
+            size_t driver_items_before = 0;
+            size_t monitor_items_before = 0;
+
+            /* Number of items after merging runs across bits */
+            size_t driver_items_after = 0;
+            size_t monitor_items_after = 0;
+        };
+
+        TestSequence(PliFemtoseconds clock_period,
+                     SequenceMessages messages = SequenceMessages::RunStart);
+        TestSequence(PliFemtoseconds clock_period, can::BitFrame& frame,
+                     SequenceType sequence_type,
+                     SequenceMessages messages = SequenceMessages::RunStart);
+        TestSequence(PliFemtoseconds clock_period, can::BitFrame& driver_frame,
+                     can::BitFrame& monitor_frame,
+                     SequenceMessages messages = SequenceMessages::RunStart);
 
         /**
          * @brief Gets pointer to n-th monitor item.
@@ -82,6 +112,23 @@ class test::TestSequence
          */
         void AppendDriverItem(DrvItem driver_item);
 
+        /**
+         * @brief Appends monitor item to monitor sequence
+         * @param monitor_item Item to be apended.
+         */
+        void AppendMonitorItem(MonItem monitor_item);
+
+        /**
+         * @returns Number of items in driver / monitor sequence.
+         */
+        size_t GetNumDriverItems() const { return driven_values.size(); }
+        size_t GetNumMonitorItems() const { return monitored_values.size(); }
+
+        /**
+         * @returns Clock period for which sequence was compiled.
+         */
+        PliFemtoseconds GetClockPeriod() const { return clock_period; }
+
         /**
          * @brief Prints items in driver sequence.
          */
@@ -116,6 +163,16 @@ class test::TestSequence
          */
          void Print(bool driven);
 
+        /**
+         * @returns Statistics of compilation of frames to items.
+         */
+        const Stats& GetStats() const { return stats; }
+
+        /**
+         * @brief Prints statistics of compilation of frames to items.
+         */
+        void PrintStats();
+
     private:
 
         /**
@@ -125,18 +182,42 @@ class test::TestSequence
         std::vector<MonItem> monitored_values;
 
         /**
-         * Clock period configured in simulator for DUT operation. This
-         * information is used to calculate proper duration of each monitor/driver
-         * item.
+         * Clock period configured in simulator for DUT operation. Durations of
+         * monitor/driver items (in clock cycles) are multiplied by it when items
+         * are pushed to simulator.
+         */
+        PliFemtoseconds clock_period;
+
+        /**
+         * Messages attached to compiled items.
+         */
+        SequenceMessages messages;
+
+        Stats stats;
+
+        /**
+         * Last item of driver / monitor sequence may be extended by next run of
+         * cycles with equal value. False when last item was appended explicitly.
+         */
+        bool driver_mergeable = false;
+        bool monitor_mergeable = false;
+
+        /**
+         * Ids of interned names of bit kinds (messages of items), indexed by bit kind.
+         */
+        PliMessageId kind_messages[static_cast<size_t>(can::BitKind::Undefined) + 1] = {};
+
+        /**
+         * @returns Id of interned name of kind of bit.
          */
-        std::chrono::nanoseconds clock_period;
+        PliMessageId GetKindMessage(can::Bit *bit);
 
         /**
          * @brief Appends CAN frame to driver sequence.
          *
          * CAN frame is converted to sequence of driver items for CAN Agent
-         * driver and appended to "drivenValues". Each bit on CAN bus is converted
-         * to single driver item.
+         * driver and appended to "drivenValues". Each run of cycles with equal
+         * value is converted to single driver item.
          *
          * @param bit_frame Reference to CAN frame to be converted. Not modified.
          */
@@ -149,9 +230,10 @@ class test::TestSequence
          * monitor and appended to "monitorValues".
          *
          * Bits BRS and CRC delimiters are converted to two monitor items. All
-         * other bits are converted to single monitor item. Duration of monitor
-         * item is equal to duration of the bit on CAN bus. Sample rate of each
-         * item is equal to Baud rate prescaler used during that bit.
+         * other bits are converted to monitor item per run of cycles with equal
+         * value. Runs with equal value and sample rate are merged across bits.
+         * Sample rate of each item is equal to Baud rate prescaler used during
+         * that bit.
          *
          * @warning BRS and CRC delimiter encoding causes that CAN agent monitor
          *          does not perform check exactly in sample point of these bits!
@@ -163,7 +245,8 @@ class test::TestSequence
         /**
          * @brief Appends single CAN bit to driver items sequence.
          *
-         * CAN bit is converted to single driver item sequence.
+         * Runs of cycles of the bit are appended to driver items sequence. First
+         * run is merged with last item if it has equal value.
          *
          * @param bit CAN bit to append. Not modified
          */
@@ -192,26 +275,24 @@ class test::TestSequence
         void appendMonitorNotShift(can::Bit *bit);
 
         /**
-         * @brief Pushes an item into driver FIFO.
-         * @param duration Duration of item for which it shall be driven.
-         * @param bit_value Bit value to be driven.
-         * @param message Message to be printed when driving starts.
+         * @brief Appends run of cycles to driver sequence. Extends last item if it has
+         *        equal value, otherwise pushes new item.
+         * @param cycles Duration of the run in clock cycles.
+         * @param bit_value Value of the run.
+         * @param bit Bit in which the run is (name of its kind is message of new item).
          */
-        void pushDriverValue(std::chrono::nanoseconds duration,
-                             can::BitVal bit_value,
-                             std::string message);
+        void appendDriverRun(size_t cycles, can::BitVal bit_value, can::Bit *bit);
 
         /**
-         * @brief Pushes an item into monitor FIFO.
-         * @param duration Duration of item for which it shall be monitored.
-         * @param sample_rate How often monitor shall check the value during monitoring.
-         * @param bit_value Bit value to be monitored.
-         * @param message Message to be printed when monitoring starts.
+         * @brief Appends run of cycles to monitor sequence. Extends last item if it has
+         *        equal value and sample rate, otherwise pushes new item.
+         * @param cycles Duration of the run in clock cycles.
+         * @param sample_cycles Sample rate of the run in clock cycles.
+         * @param bit_value Value of the run.
+         * @param bit Bit in which the run is (name of its kind is message of new item).
          */
-        void pushMonitorValue(std::chrono::nanoseconds duration,
-                              std::chrono::nanoseconds sample_rate,
-                              can::BitVal bit_value,
-                              std::string message);
+        void appendMonitorRun(size_t cycles, size_t sample_cycles, can::BitVal bit_value,
+                              can::Bit *bit);
 };
 
 #endif
\ No newline at end of file
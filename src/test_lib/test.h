@@ -49,6 +49,16 @@ namespace test
         MONITOR_SEQUENCE
     };
 
+    /*
+     * Messages attached to items of test sequence. Message is printed by simulator
+     * when CAN agent starts driving / monitoring an item.
+     */
+    enum class SequenceMessages
+    {
+        None,               /* Items have no message */
+        RunStart            /* Item has name of field (bit kind) in which it starts */
+    };
+
     enum class TestVariant
     {
         Common,             /* Common for FD Enabled, Tolerant, 2.0 implementations */
@@ -124,8 +134,10 @@ namespace test
     class DrvItem;
     class MonItem;
     class TestSequence;
+    class SequenceFile;
 
     class TestBase;
+    struct PreparedElemTest;
     class ElemTest;
     class TestDemo;
 
@@ -33,6 +33,7 @@
 #include "DrvItem.h"
 #include "ElemTest.h"
 #include "MonItem.h"
+#include "SequenceFile.h"
 #include "TestBase.h"
 #include "TestLoader.h"
 #include "TestSequence.h"
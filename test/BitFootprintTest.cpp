@@ -0,0 +1,126 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *
+ * @brief Memory footprint test of "Bit" and "BitFrame". Checks size of a bit and number
+ *        of bytes allocated by frames of all kinds and data lengths against budget.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "../src/can_lib/can.h"
+#include "../src/can_lib/Frame.h"
+#include "../src/can_lib/FrameFlags.h"
+#include "../src/can_lib/BitTiming.h"
+#include "../src/can_lib/BitFrame.h"
+#include "../src/can_lib/Bit.h"
+
+using namespace can;
+
+/* Budgets */
+#define BIT_SIZE_MAX 16
+#define FRAME_BYTES_PER_BIT_MAX 96
+#define FRAME_BYTES_MAX (48 * 1024)
+
+static size_t n_alloc_bytes = 0;
+
+void* operator new(std::size_t size)
+{
+    n_alloc_bytes += size;
+    void *ptr = std::malloc(size ? size : 1);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+int main()
+{
+    static_assert(sizeof(Bit) <= BIT_SIZE_MAX, "Bit exceeds its size budget");
+
+    BitTiming nbt = BitTiming(7, 5, 6, 4, 3);
+    BitTiming dbt = BitTiming(5, 3, 4, 1, 2);
+
+    FrameKind frame_kinds[] = {FrameKind::Can20, FrameKind::CanFd};
+    IdentKind ident_kinds[] = {IdentKind::Base, IdentKind::Ext};
+    BrsFlag brs_flags[] = {BrsFlag::NoShift, BrsFlag::DoShift};
+
+    uint8_t data[64];
+    for (int i = 0; i < 64; i++)
+        data[i] = static_cast<uint8_t>(rand() % 256);
+
+    size_t max_bytes = 0;
+    size_t max_bytes_len = 0;
+
+    for (auto frame_kind : frame_kinds)
+        for (auto ident_kind : ident_kinds)
+            for (auto brs_flag : brs_flags)
+                for (uint8_t dlc = 0; dlc < 16; dlc++)
+                {
+                    if (frame_kind == FrameKind::Can20 && (brs_flag == BrsFlag::DoShift ||
+                                                           dlc > 8))
+                        continue;
+                    FrameFlags flags = FrameFlags(frame_kind, ident_kind, RtrFlag::Data,
+                                                  brs_flag, EsiFlag::ErrAct);
+                    Frame frm(flags, dlc, 0x5A5, data);
+
+                    // Frame as compliance test uses it: built, cycles walked, error frame
+                    size_t bytes_before = n_alloc_bytes;
+                    BitFrame bit_frm(frm, &nbt, &dbt);
+                    bit_frm.GetLenCycles();
+                    bit_frm.InsertActErrFrm(0, BitKind::Ack);
+                    size_t bytes = n_alloc_bytes - bytes_before;
+
+                    assert(bytes <= bit_frm.GetLen() * FRAME_BYTES_PER_BIT_MAX &&
+                           "Frame exceeds its memory budget per bit");
+                    assert(bytes <= FRAME_BYTES_MAX && "Frame exceeds its memory budget");
+
+                    if (bytes > max_bytes) {
+                        max_bytes = bytes;
+                        max_bytes_len = bit_frm.GetLen();
+                    }
+                }
+
+    std::cout << "Size of bit:             " << sizeof(Bit) << " bytes" << std::endl;
+    std::cout << "Largest frame allocates: " << max_bytes << " bytes ("
+              << max_bytes_len << " bits)" << std::endl;
+
+    return 0;
+}
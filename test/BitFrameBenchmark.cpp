@@ -0,0 +1,211 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Benchmark of "BitFrame" model. Builds frames the same way as
+ *        compliance tests do (driven + monitored frame, error frame, update
+ *        of frame) and walks all cycles of the frames. Reports number of heap
+ *        allocations (nodes), allocated memory and wall time.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "../src/can_lib/can.h"
+#include "../src/can_lib/Frame.h"
+#include "../src/can_lib/FrameFlags.h"
+#include "../src/can_lib/BitTiming.h"
+#include "../src/can_lib/BitFrame.h"
+#include "../src/can_lib/Bit.h"
+#include "../src/can_lib/TimeQuanta.h"
+#include "../src/can_lib/Cycle.h"
+
+using namespace can;
+
+static size_t n_allocs = 0;
+static size_t n_alloc_bytes = 0;
+
+void* operator new(std::size_t size)
+{
+    n_allocs++;
+    n_alloc_bytes += size;
+    void *ptr = std::malloc(size ? size : 1);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+/**
+ * Walks all cycles of a frame by runs of cycles with equal value (as Test sequence does).
+ * @returns Number of cycles in frame
+ */
+size_t walk_cycles(BitFrame &frm)
+{
+    size_t n_cycles = 0;
+    size_t n_runs = 0;
+
+    for (size_t i = 0; i < frm.GetLen(); i++)
+    {
+        Bit *bit = frm.GetBit(i);
+        size_t len = bit->GetLenCycles();
+        for (size_t offset = 0; offset < len; n_runs++)
+        {
+            BitVal val;
+            size_t end = bit->GetValRunEnd(offset, &val);
+            n_cycles += end - offset;
+            offset = end;
+        }
+        assert(n_runs <= n_cycles);
+    }
+
+    return n_cycles;
+}
+
+
+size_t frame_len_cycles(BitFrame &frm)
+{
+    size_t n_cycles = 0;
+    for (size_t i = 0; i < frm.GetLen(); i++)
+        n_cycles += frm.GetBit(i)->GetLenCycles();
+    return n_cycles;
+}
+
+
+/**
+ * Builds frame the way compliance test does it, and returns number of walked cycles.
+ */
+size_t run_one(FrameFlags flags, uint8_t dlc, BitTiming *nbt, BitTiming *dbt)
+{
+    uint8_t data[64];
+    for (int i = 0; i < 64; i++)
+        data[i] = static_cast<uint8_t>(rand() % 256);
+
+    Frame gold_frm(flags, dlc, rand() % CAN_BASE_ID_MAX, data);
+
+    BitFrame drv_bit_frm(gold_frm, nbt, dbt);
+    BitFrame mon_bit_frm(drv_bit_frm);
+
+    drv_bit_frm.ConvRXFrame();
+    drv_bit_frm.GetBit(2)->FlipVal();
+    drv_bit_frm.UpdateFrame();
+    drv_bit_frm.GetBitOf(0, BitKind::Ack)->GetTQ(0)->Lengthen(3);
+    drv_bit_frm.GetBitOf(0, BitKind::Ack)->ForceTQ(1, BitVal::Dominant);
+
+    mon_bit_frm.InsertActErrFrm(0, BitKind::Ack);
+
+    size_t n_cycles = walk_cycles(drv_bit_frm) + walk_cycles(mon_bit_frm);
+    assert(n_cycles == frame_len_cycles(drv_bit_frm) + frame_len_cycles(mon_bit_frm));
+
+    // Time index shall follow lengthening of bits
+    assert(drv_bit_frm.GetLenCycles() == frame_len_cycles(drv_bit_frm));
+    size_t ack_index = drv_bit_frm.GetBitIndex(drv_bit_frm.GetBitOf(0, BitKind::Ack));
+    size_t ack_start = drv_bit_frm.GetBitStartCycle(ack_index);
+    assert(drv_bit_frm.GetBitAtCycle(ack_start) == ack_index);
+    assert(drv_bit_frm.GetBitAtCycle(ack_start - 1) == ack_index - 1);
+    assert(drv_bit_frm.GetCyclePos(drv_bit_frm.MoveCyclesBack(
+            drv_bit_frm.GetBitOf(0, BitKind::Ack)->GetCycle(0), 10)) == ack_start - 10);
+
+    return n_cycles;
+}
+
+
+int main()
+{
+    srand(1234);
+
+    BitTiming nbt = BitTiming(7, 5, 6, 4, 3);
+    BitTiming dbt = BitTiming(5, 3, 4, 1, 2);
+
+    // Update re-stuffs frame as whole, kept stuff bits shall lose their timing too
+    {
+        uint8_t zero_data[8] = {};
+        FrameFlags zero_flags = FrameFlags(FrameKind::Can20, IdentKind::Base, RtrFlag::Data);
+        Frame zero_frm(zero_flags, 8, 0, zero_data);
+        BitFrame frm(zero_frm, &nbt, &dbt);
+        size_t def_len = frm.GetStuffBit(0)->GetLenTQ();
+        frm.GetStuffBit(0)->LengthenPhase(BitPhase::Ph2, 3);
+        frm.GetBitOf(30, BitKind::Data)->FlipVal();
+        frm.UpdateFrame();
+        assert(frm.GetStuffBit(0)->GetLenTQ() == def_len);
+        assert(frm.GetLenCycles() == frame_len_cycles(frm));
+    }
+
+    FrameKind frame_kinds[] = {FrameKind::Can20, FrameKind::CanFd};
+    IdentKind ident_kinds[] = {IdentKind::Base, IdentKind::Ext};
+    BrsFlag brs_flags[] = {BrsFlag::NoShift, BrsFlag::DoShift};
+
+    const int n_iterations = 20;
+    size_t n_frames = 0;
+    size_t n_cycles = 0;
+    size_t allocs_before = n_allocs;
+    size_t alloc_bytes_before = n_alloc_bytes;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int iter = 0; iter < n_iterations; iter++)
+        for (auto frame_kind : frame_kinds)
+            for (auto ident_kind : ident_kinds)
+                for (auto brs_flag : brs_flags)
+                    for (uint8_t dlc = 0; dlc < 16; dlc++)
+                    {
+                        if (frame_kind == FrameKind::Can20 && brs_flag == BrsFlag::DoShift)
+                            continue;
+                        FrameFlags flags = FrameFlags(frame_kind, ident_kind, RtrFlag::Data,
+                                                      brs_flag, EsiFlag::ErrAct);
+                        n_cycles += run_one(flags, dlc, &nbt, &dbt);
+                        n_frames++;
+                    }
+
+    auto end = std::chrono::steady_clock::now();
+    size_t allocs = n_allocs - allocs_before;
+    size_t alloc_bytes = n_alloc_bytes - alloc_bytes_before;
+    auto time_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::cout << "Frames built:          " << n_frames << std::endl;
+    std::cout << "Cycles walked:         " << n_cycles << std::endl;
+    std::cout << "Heap allocations:      " << allocs << std::endl;
+    std::cout << "Allocations per frame: " << allocs / n_frames << std::endl;
+    std::cout << "Allocated bytes:       " << alloc_bytes << std::endl;
+    std::cout << "Bytes per frame:       " << alloc_bytes / n_frames << std::endl;
+    std::cout << "Wall time:             " << time_us << " us" << std::endl;
+
+    assert(n_frames > 0 && n_cycles > 0);
+
+    return 0;
+}
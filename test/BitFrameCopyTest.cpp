@@ -0,0 +1,148 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Unit Test for copy and move of "BitFrame". Copy of a frame shall have
+ *        the same bits, cycles and values as original frame, and its bits shall
+ *        refer to the copy. Moved frame shall keep bits in place.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "../src/can_lib/can.h"
+#include "../src/can_lib/Frame.h"
+#include "../src/can_lib/FrameFlags.h"
+#include "../src/can_lib/BitTiming.h"
+#include "../src/can_lib/Bit.h"
+#include "../src/can_lib/BitFrame.h"
+#include "../src/can_lib/TimeQuanta.h"
+#include "../src/can_lib/Cycle.h"
+
+using namespace can;
+
+
+/**
+ * Checks that two frames have the same bits (with the same cycles), and that bits of
+ * each frame refer to the frame.
+ */
+void check_frames_equal(BitFrame &a, BitFrame &b)
+{
+    assert(a.GetLen() == b.GetLen());
+    assert(a.GetLenCycles() == b.GetLenCycles());
+
+    for (size_t i = 0; i < a.GetLen(); i++)
+    {
+        Bit *bit_a = a.GetBit(i);
+        Bit *bit_b = b.GetBit(i);
+        assert(bit_a != bit_b);
+        assert(bit_a->kind_ == bit_b->kind_);
+        assert(bit_a->val_ == bit_b->val_);
+        assert(bit_a->stuff_kind_ == bit_b->stuff_kind_);
+        assert(a.GetBitIndex(bit_a) == i);
+        assert(b.GetBitIndex(bit_b) == i);
+        assert(bit_a->GetLenTQ() == bit_b->GetLenTQ());
+        assert(bit_a->GetLenCycles() == bit_b->GetLenCycles());
+
+        for (size_t j = 0; j < bit_a->GetLenCycles(); j++)
+            assert(bit_a->GetCycle(j).bit_val() == bit_b->GetCycle(j).bit_val());
+
+        // Time quantas shall refer to bit of its own frame
+        if (bit_b->IsMaterialized())
+            assert(bit_b->GetTQ(0)->getCycleBitValue(0).bit() == bit_b);
+    }
+}
+
+
+int main()
+{
+    srand(1234);
+
+    BitTiming nbt = BitTiming(7, 5, 6, 4, 3);
+    BitTiming dbt = BitTiming(5, 3, 4, 1, 2);
+
+    uint8_t data[64];
+    for (int i = 0; i < 64; i++)
+        data[i] = static_cast<uint8_t>(rand() % 256);
+
+    FrameFlags flags = FrameFlags(FrameKind::CanFd, IdentKind::Ext, RtrFlag::Data,
+                                  BrsFlag::DoShift, EsiFlag::ErrAct);
+    BitFrame frm(flags, 0xA, 0x1234, data, &nbt, &dbt);
+
+    // Modify timing and values of some bits, so that frame has non-default bits
+    frm.ConvRXFrame();
+    frm.GetBitOf(3, BitKind::Data)->FlipVal();
+    frm.UpdateFrame();
+    frm.GetBitOf(0, BitKind::Ack)->GetTQ(0)->Lengthen(3);
+    frm.GetBitOf(0, BitKind::Ack)->ForceTQ(1, BitVal::Dominant);
+    frm.GetBitOf(0, BitKind::Brs)->ShortenPhase(BitPhase::Ph2, 1);
+    frm.GetBitOf(2, BitKind::Crc)->LengthenPhase(BitPhase::Ph1, 2);
+    frm.InsertActErrFrm(0, BitKind::Eof);
+
+    // Copy shall be equal to original
+    BitFrame copy(frm);
+    check_frames_equal(frm, copy);
+    assert(copy.crc() == frm.crc());
+
+    // Modification of copy shall not affect original
+    size_t len_cycles = frm.GetLenCycles();
+    Bit *ack = copy.GetBitOf(0, BitKind::Ack);
+    ack->GetTQ(0)->Lengthen(5, BitVal::Recessive);
+    ack->ForceTQ(0, BitVal::Recessive);
+    assert(copy.GetLenCycles() == len_cycles + 5);
+    assert(frm.GetLenCycles() == len_cycles);
+    assert(frm.GetBitOf(0, BitKind::Ack)->GetCycle(0).has_def_val());
+
+    // Update of copy shall give the same CRC as update of original
+    copy.GetBitOf(0, BitKind::Data)->FlipVal();
+    frm.GetBitOf(0, BitKind::Data)->FlipVal();
+    copy.UpdateFrame();
+    frm.UpdateFrame();
+    assert(copy.crc() == frm.crc());
+
+    // Moved frame shall keep the bits where they are and link them to itself
+    std::vector<Bit*> bits;
+    for (size_t i = 0; i < copy.GetLen(); i++)
+        bits.push_back(copy.GetBit(i));
+    BitFrame moved(std::move(copy));
+    for (size_t i = 0; i < moved.GetLen(); i++)
+        assert(moved.GetBit(i) == bits[i]);
+    assert(moved.GetLenCycles() == len_cycles + 5);
+
+    ack->GetTQ(0)->Shorten(5);
+    ack->ForceTQ(0, BitVal::Dominant);
+    check_frames_equal(frm, moved);
+
+    // Bits appended from other frame shall be copied
+    BitFrame appended(flags, 0x0, 0x1, data, &nbt, &dbt);
+    appended.RemoveBitsFrom(0);
+    appended.AppendBitFrame(&moved);
+    check_frames_equal(moved, appended);
+
+    return 0;
+}
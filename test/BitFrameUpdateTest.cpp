@@ -0,0 +1,139 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Unit Test for incremental update of "BitFrame". Removes regular stuff
+ *        bits, or inserts bits just before them, and checks that "UpdateFrame"
+ *        re-stuffs the frame the same way as frame built from scratch.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+#include "../src/can_lib/can.h"
+#include "../src/can_lib/Frame.h"
+#include "../src/can_lib/FrameFlags.h"
+#include "../src/can_lib/BitTiming.h"
+#include "../src/can_lib/Bit.h"
+#include "../src/can_lib/BitFrame.h"
+
+using namespace can;
+
+
+/**
+ * Checks that frames have the same bits (kinds, values and stuff bits).
+ */
+void check_frames_equal(BitFrame &a, BitFrame &b)
+{
+    assert(a.GetLen() == b.GetLen());
+
+    for (size_t i = 0; i < a.GetLen(); i++)
+    {
+        assert(a.GetBit(i)->kind_ == b.GetBit(i)->kind_);
+        assert(a.GetBit(i)->val_ == b.GetBit(i)->val_);
+        assert(a.GetBit(i)->stuff_kind_ == b.GetBit(i)->stuff_kind_);
+    }
+}
+
+
+/**
+ * Applies modifications around each regular stuff bit of frame, and checks updated
+ * frame against frame built from scratch.
+ * @returns Number of checked modifications
+ */
+size_t check_frame(Frame &frm, BitTiming *nbt, BitTiming *dbt)
+{
+    BitFrame gold(frm, nbt, dbt);
+    size_t n_checks = 0;
+
+    for (size_t i = 1; i < gold.GetLen(); i++)
+    {
+        if (gold.GetBit(i)->stuff_kind_ != StuffKind::Normal)
+            continue;
+
+        // Removed stuff bit shall be inserted again
+        BitFrame removed(frm, nbt, dbt);
+        removed.RemoveBit(i);
+        removed.UpdateFrame();
+        check_frames_equal(removed, gold);
+
+        // Bit inserted just before stuff bit (of both values) and removed again
+        for (BitVal val : {BitVal::Dominant, BitVal::Recessive})
+        {
+            BitFrame inserted(frm, nbt, dbt);
+            inserted.InsertBit(inserted.GetBit(i - 1)->kind_, val, i);
+            Bit *bit = inserted.GetBit(i);
+            inserted.UpdateFrame();
+            inserted.RemoveBit(bit);
+            inserted.UpdateFrame();
+            check_frames_equal(inserted, gold);
+        }
+        n_checks += 3;
+    }
+
+    return n_checks;
+}
+
+
+int main()
+{
+    srand(1234);
+
+    BitTiming nbt = BitTiming(7, 5, 6, 4, 3);
+    BitTiming dbt = BitTiming(5, 3, 4, 1, 2);
+    size_t n_checks = 0;
+
+    // CAN 2.0 frame with all zeroes (stuff bit in DLC)
+    uint8_t data[64] = {};
+    FrameFlags can20_flags = FrameFlags(FrameKind::Can20, IdentKind::Base, RtrFlag::Data);
+    Frame zero_frm(can20_flags, 8, 0, data);
+    n_checks += check_frame(zero_frm, &nbt, &dbt);
+
+    FrameKind frame_kinds[] = {FrameKind::Can20, FrameKind::CanFd};
+    IdentKind ident_kinds[] = {IdentKind::Base, IdentKind::Ext};
+
+    for (int iter = 0; iter < 5; iter++)
+        for (auto frame_kind : frame_kinds)
+            for (auto ident_kind : ident_kinds)
+                for (uint8_t dlc = 0; dlc < 16; dlc++)
+                {
+                    // Data with long runs of equal bits, so that frame has many stuff bits
+                    for (int i = 0; i < 64; i++)
+                        data[i] = (rand() % 2) ? 0x00 : static_cast<uint8_t>(rand() % 256);
+                    FrameFlags flags = FrameFlags(frame_kind, ident_kind, RtrFlag::Data,
+                                                  BrsFlag::NoShift, EsiFlag::ErrAct);
+                    int ident = (rand() % 2) ? 0 : rand();
+                    ident %= (ident_kind == IdentKind::Base) ? CAN_BASE_ID_MAX
+                                                             : CAN_EXTENDED_ID_MAX;
+                    Frame frm(flags, dlc, ident, data);
+                    n_checks += check_frame(frm, &nbt, &dbt);
+                }
+
+    std::cout << "Checked " << n_checks << " updated frames" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Unit Test for "CrcEngine" class
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../src/can_lib/can.h"
+#include "../src/can_lib/CrcEngine.h"
+
+using namespace can;
+
+
+/**
+ * Reference bit-by-bit CRC calculation as in CAN FD specification.
+ */
+uint32_t ref_crc(std::vector<int> &bits, size_t width, uint32_t poly, uint32_t init)
+{
+    uint32_t crc = init;
+    uint32_t mask = (1U << width) - 1;
+
+    for (int bit : bits)
+    {
+        uint32_t crc_nxt = static_cast<uint32_t>(bit) ^ ((crc >> (width - 1)) & 0x1);
+        crc = (crc << 1) & mask;
+        if (crc_nxt)
+            crc ^= poly;
+        crc &= mask;
+    }
+    return crc;
+}
+
+
+/**
+ * Feeds bits to engine in randomly sized words.
+ */
+uint32_t engine_crc(std::vector<int> &bits, CrcKind kind)
+{
+    CrcEngine engine = CrcEngine(kind);
+    size_t pos = 0;
+
+    while (pos < bits.size())
+    {
+        size_t n_bits = static_cast<size_t>(rand() % 65);
+        if (n_bits > bits.size() - pos)
+            n_bits = bits.size() - pos;
+
+        uint64_t word = 0;
+        for (size_t i = 0; i < n_bits; i++)
+            word = (word << 1) | static_cast<uint64_t>(bits[pos + i]);
+
+        engine.Update(word, n_bits);
+        pos += n_bits;
+    }
+    return engine.crc();
+}
+
+
+int main()
+{
+    srand(1234);
+
+    for (int i = 0; i < 10000; i++)
+    {
+        std::vector<int> bits(static_cast<size_t>(rand() % 700));
+        for (auto &bit : bits)
+            bit = rand() % 2;
+
+        assert(engine_crc(bits, CrcKind::Crc15) == ref_crc(bits, 15, 0xC599, 0));
+        assert(engine_crc(bits, CrcKind::Crc17) == ref_crc(bits, 17, 0x3685B, 1U << 16));
+        assert(engine_crc(bits, CrcKind::Crc21) == ref_crc(bits, 21, 0x302899, 1U << 20));
+    }
+
+    std::cout << "CRC engine matches reference calculation" << std::endl;
+
+    return 0;
+}
@@ -24,36 +24,157 @@
  * @author Ondrej Ille, <ondrej.ille@gmail.com>
  * @date 29.5.2021
  *
- * @brief Unit Test for "CycleBitValue" class
+ * @brief Unit Test for "Cycle" class. Forced values of cycles within a bit are
+ *        compared against reference model which holds value of each cycle.
  *****************************************************************************/
 
 #undef NDEBUG
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <vector>
 
-#include "can_lib/CycleBitValue.h"
-
-#include "can_lib/can.h"
+#include "../src/can_lib/can.h"
+#include "../src/can_lib/FrameFlags.h"
+#include "../src/can_lib/BitTiming.h"
+#include "../src/can_lib/Bit.h"
+#include "../src/can_lib/BitFrame.h"
+#include "../src/can_lib/TimeQuanta.h"
+#include "../src/can_lib/Cycle.h"
 
 using namespace can;
 
+/* Reference value of cycle: -1 default, otherwise forced value */
+typedef std::vector<int> RefCycles;
 
-int main()
+
+void check_bit(Bit &bit, RefCycles &ref)
+{
+    assert(bit.GetLenCycles() == ref.size());
+
+    bool has_forced = false;
+    for (size_t i = 0; i < ref.size(); i++)
+    {
+        Cycle cycle = bit.GetCycle(i);
+        assert(cycle.has_def_val() == (ref[i] == -1));
+        BitVal exp_val = (ref[i] == -1) ? bit.val_ : static_cast<BitVal>(ref[i]);
+        assert(cycle.bit_val() == exp_val);
+        has_forced |= (ref[i] != -1);
+    }
+    assert(bit.HasNonDefVals() == has_forced);
+
+    // Runs of equal value shall cover whole bit and shall be maximal
+    size_t offset = 0;
+    while (offset < ref.size())
+    {
+        BitVal val;
+        size_t end = bit.GetValRunEnd(offset, &val);
+        assert(end > offset && end <= ref.size());
+        for (size_t i = offset; i < end; i++)
+            assert(bit.GetCycle(i).bit_val() == val);
+        if (end < ref.size())
+            assert(bit.GetCycle(end).bit_val() != val);
+        offset = end;
+    }
+}
+
+
+/* Start of time quanta in reference cycles */
+size_t tq_offset(Bit &bit, size_t tq_index)
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < tq_index; i++)
+        offset += bit.GetTQ(i)->getLengthCycles();
+    return offset;
+}
+
+
+void test_random(FrameFlags *flags, BitTiming *nbt, BitTiming *dbt)
 {
-    Cycle cv = Cycle(nullptr, BitVal::Dominant);
-    Cycle cv2 = Cycle(nullptr, BitVal::Recessive);
+    uint8_t data[1] = {0xFF};
+    BitFrame frm(*flags, 0x1, 0x5, data, nbt, dbt);
+    Bit &bit = *frm.GetBitOf(0, BitKind::Data);
+    RefCycles ref(bit.GetLenCycles(), -1);
+
+    for (int op = 0; op < 2000; op++)
+    {
+        size_t n_tqs = bit.GetLenTQ();
+        size_t tq_index = static_cast<size_t>(rand()) % n_tqs;
+        TimeQuanta *tq = bit.GetTQ(tq_index);
+        size_t start = tq_offset(bit, tq_index);
+        size_t len = tq->getLengthCycles();
+        int val = rand() % 2;
+
+        switch (rand() % 7)
+        {
+        case 0:
+            tq->ForceVal(static_cast<BitVal>(val));
+            for (size_t i = 0; i < len; i++)
+                ref[start + i] = val;
+            break;
+        case 1:
+            tq->SetAllDefVals();
+            for (size_t i = 0; i < len; i++)
+                ref[start + i] = -1;
+            break;
+        case 2:
+            if (len > 0) {
+                size_t i = static_cast<size_t>(rand()) % len;
+                tq->ForceCycleValue(i, static_cast<BitVal>(val));
+                ref[start + i] = val;
+            }
+            break;
+        case 3:
+            if (len > 0) {
+                size_t i = static_cast<size_t>(rand()) % len;
+                tq->getCycleBitValue(i).ReleaseVal();
+                ref[start + i] = -1;
+            }
+            break;
+        case 4:
+            if (len < 8) {
+                tq->Lengthen(2);
+                ref.insert(ref.begin() + static_cast<long>(start + len), 2, -1);
+            }
+            break;
+        case 5:
+            if (len < 8) {
+                tq->Lengthen(1, static_cast<BitVal>(val));
+                ref.insert(ref.begin() + static_cast<long>(start + len), 1, val);
+            }
+            break;
+        case 6:
+            if (len > 1) {
+                tq->Shorten(1);
+                ref.erase(ref.begin() + static_cast<long>(start + len - 1));
+            }
+            break;
+        }
+
+        assert(tq->HasNonDefVals() == (std::count_if(
+            ref.begin() + static_cast<long>(start),
+            ref.begin() + static_cast<long>(start + tq->getLengthCycles()),
+            [](int v) { return v != -1; }) > 0));
+        check_bit(bit, ref);
+    }
 
-    assert(cv.bit_value() == BitVal::Dominant);
-    assert(cv2.bit_value() == BitVal::Recessive);
+    // Bit within copy of a frame shall have the same values
+    BitFrame copy(frm);
+    check_bit(*copy.GetBit(frm.GetBitIndex(&bit)), ref);
+}
+
+
+int main()
+{
+    srand(12);
 
-    // Force and check it was forced
-    cv.ForceValue(BitVal::Recessive);
-    assert(cv.bit_value() == BitVal::Recessive);
-    assert(cv.has_def_val() == false);
+    FrameFlags flags = FrameFlags(FrameKind::Can20, IdentKind::Base, RtrFlag::Data,
+                                  BrsFlag::NoShift, EsiFlag::ErrAct);
+    BitTiming nbt = BitTiming(2, 3, 3, 2, 1);
+    BitTiming dbt = BitTiming(1, 2, 2, 1, 1);
 
-    // Release and check it was released.
-    cv.ReleaseValue();
-    assert(cv.has_def_val() == true);
-    //assert(cv.bit_value() == BitValue::Dominant);
+    for (int i = 0; i < 20; i++)
+        test_random(&flags, &nbt, &dbt);
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,110 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Unit Test for logging. Checks that messages are filtered by level of
+ *        their category, that debug messages are compiled out, and that writer
+ *        thread writes all messages and std::cout output in order.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "../src/cosimulation/Log.hpp"
+
+
+static int n_evaluated = 0;
+
+static int Evaluate()
+{
+    return ++n_evaluated;
+}
+
+
+static std::string ReadOutput(FILE *output)
+{
+    LogFlush();
+
+    std::string content;
+    char buf[256];
+    size_t len;
+
+    rewind(output);
+    while ((len = fread(buf, 1, sizeof(buf), output)) > 0)
+        content.append(buf, len);
+
+    return content;
+}
+
+
+int main()
+{
+    FILE *output = tmpfile();
+    assert(output != nullptr);
+    LogSetOutput(output);
+
+    // Levels are per category
+    LogSetLevel(LogCategory::Pli, LogSeverity::Error);
+    LogSetLevel(LogCategory::Test, LogSeverity::Info);
+    assert(!LogIsEnabled(LogCategory::Pli, LogSeverity::Info));
+    assert(LogIsEnabled(LogCategory::Pli, LogSeverity::Error));
+    assert(LogIsEnabled(LogCategory::Test, LogSeverity::Info));
+    assert(!LogPliIsEnabled(1));
+
+    // Debug messages are compiled out, their parameters are not evaluated
+    LogSetLevel(LogCategory::Test, LogSeverity::Debug);
+    if (LOG_ENABLED(LogCategory::Test, LogSeverity::Debug))
+        LogPrintf(LogCategory::Test, LogSeverity::Debug, "%d", Evaluate());
+    assert(n_evaluated == (LOG_MIN_SEVERITY == 0 ? 1 : 0));
+
+    // All messages are written in order
+    const int n_lines = 10000;
+    for (int i = 0; i < n_lines; i++)
+        LogPrintf(LogCategory::Test, LogSeverity::Info, "Line %d", i);
+    LogPliWrite(2, "Error");
+
+    // Output of std::cout (e.g. Frame::Print) keeps order with messages
+    std::cout << "Printed " << 1;
+    std::cout << " frame" << std::endl;
+    LogPrintf(LogCategory::Test, LogSeverity::Info, "Last");
+
+    std::string content = ReadOutput(output);
+    size_t pos = (LOG_MIN_SEVERITY == 0) ? content.find('\n') + 1 : 0;
+    for (int i = 0; i < n_lines; i++)
+    {
+        std::string line = "Line " + std::to_string(i) + "\n";
+        assert(content.compare(pos, line.size(), line) == 0);
+        pos += line.size();
+    }
+    assert(content.compare(pos, std::string::npos, "Error\nPrinted 1 frame\nLast\n") == 0);
+
+    LogSetOutput(stdout);
+    fclose(output);
+
+    return 0;
+}
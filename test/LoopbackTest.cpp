@@ -0,0 +1,157 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Test of loopback simulator. Stand-in test (instead of compliance test
+ *        library) runs PLI library functions against loopback simulator, and
+ *        checks their results.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "../src/cosimulation/LoopbackSimulator.hpp"
+#include "../src/cosimulation/PliComplianceLib.hpp"
+
+using namespace std::chrono_literals;
+
+static const char *loopback_test_name = "loopback_test";
+static std::thread test_thread;
+
+
+/**
+ * Drives and monitors the same bits. Monitor is triggered by start of driver.
+ * @param mon_first Value of first monitored bit.
+ * @returns State of monitor once it finished.
+ */
+static CanAgentMonitorState DriveAndMonitor(char mon_first)
+{
+    CanAgentDriverPushItem('0', 1000ns);
+    CanAgentDriverPushItem('1', 1000ns);
+    CanAgentDriverPushItem('0', 500ns, "Last bit");
+
+    CanAgentMonitorPushItem(mon_first, 1000ns, 10ns);
+    CanAgentMonitorPushItem('1', 1000ns, 10ns);
+    CanAgentMonitorPushItem('0', 500ns, 10ns, "Last bit");
+
+    CanAgentMonitorStart();
+    CanAgentDriverStart();
+    CanAgentMonitorWaitFinish();
+    CanAgentDriverWaitFinish();
+
+    return CanAgentMonitorGetState();
+}
+
+
+static void RunLoopbackTest()
+{
+    ClockAgentSetPeriod(10ns);
+    ClockAgentSetDuty(45);
+    assert(ClockAgentGetPeriod() == 10ns);
+    assert(ClockAgentGetDuty() == 45);
+
+    MemBusAgentWrite32(0x10, 0xDEADBEEF);
+    MemBusAgentWrite8(0x14, 0x5A);
+    auto read32 = MemBusAgentRead32Async(0x10);
+    auto read16 = MemBusAgentRead16Async(0x12);
+    auto read8 = MemBusAgentRead8Async(0x14);
+    assert(read32.Get() == 0xDEADBEEF);
+    assert(read16.Get() == 0xDEAD);
+    assert(read8.Get() == 0x5A);
+
+    // Clock period which is not whole nanoseconds is not truncated
+    assert(TestControllerAgentGetCfgDutClockPeriod() == PliFemtoseconds(12500000));
+    assert(TestControllerAgentGetBitTimingElement("CFG_DUT_PROP") == 15);
+    assert(TestControllerAgentGetSeed() == 1234);
+
+    // Monitor sees what driver drives
+    CanAgentMonitorSetTrigger(CanAgentMonitorTrigger::DriverStart);
+    assert(CanAgentMonitorGetTrigger() == CanAgentMonitorTrigger::DriverStart);
+    assert(DriveAndMonitor('0') == CanAgentMonitorState::Passed);
+    assert(!CanAgentDriverGetProgress());
+    CanAgentCheckResult();
+
+    assert(DriveAndMonitor('1') == CanAgentMonitorState::Failed);
+    CanAgentMonitorStop();
+    assert(CanAgentMonitorGetState() == CanAgentMonitorState::Disabled);
+
+    // Monitored line is delayed by input delay, monitor starts by input delay later
+    CanAgentSetMonitorInputDelay(20ns);
+    assert(DriveAndMonitor('0') == CanAgentMonitorState::Passed);
+    CanAgentSetMonitorInputDelay(0ns);
+
+    // Monitor triggered by falling edge of bus
+    CanAgentMonitorSetTrigger(CanAgentMonitorTrigger::RxFalling);
+    CanAgentDriverPushItem('1', 300ns);
+    CanAgentDriverPushItem('0', 1000ns);
+    CanAgentDriverPushItem('1', 1000ns);
+    CanAgentMonitorPushItem('0', 1000ns, 10ns);
+    CanAgentMonitorPushItem('1', 1000ns, 10ns);
+    CanAgentMonitorStart();
+    CanAgentDriverStart();
+    CanAgentMonitorWaitFinish();
+    CanAgentDriverWaitFinish();
+    assert(CanAgentMonitorGetState() == CanAgentMonitorState::Passed);
+    CanAgentMonitorStop();
+
+    CanAgentDriveSingleItem('0', 100ns);
+    assert(CanAgentDriverGetDrivenVal() == '1');
+
+    TestControllerAgentEndTest(true);
+}
+
+
+/**
+ * Called by PLI library once simulator passes control to test.
+ */
+extern "C" void RunCppTest(char *test_name)
+{
+    assert(strcmp(test_name, loopback_test_name) == 0);
+    test_thread = std::thread(RunLoopbackTest);
+}
+
+
+int main()
+{
+    LoopbackConfig config;
+    config.seed = 1234;
+    config.generics["CFG_DUT_CLOCK_PERIOD"] = 12500000;
+
+    LoopbackResult result = LoopbackSimulatorRun(loopback_test_name, config);
+    test_thread.join();
+
+    assert(result.test_ended);
+    assert(result.passed);
+
+    // Monitor which failed is not checked, so test passes. Simulation took at least
+    // time of all driven bits.
+    assert(result.sim_time > 4 * 2500000000ULL);
+    assert(result.n_commands > 50);
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Benchmark of "SimulatorChannel". Stand-in testbench answers PLI
+ *        handshake instead of HDL simulator. Reports number of PLI clock
+ *        callbacks per command and wall time per command, for testbench which
+ *        answers right away, and for testbench which answers on next clock.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "../src/cosimulation/PliComplianceLib.hpp"
+#include "../src/cosimulation/SimulatorChannel.hpp"
+
+
+/**
+ * Stand-in for test controller agent of CTU CAN FD VIP. Answers "pli_req" by
+ * "pli_ack" "ack_delay" clock cycles after "pli_req" changed. With zero delay,
+ * it answers within the same clock cycle (as soon as "pli_ack" is read). As
+ * data out, it returns number of commands it received.
+ */
+struct StandInTb
+{
+    uint64_t req = 0;
+    uint64_t ack = 0;
+    uint64_t data_out = 0;
+    uint64_t n_commands = 0;
+    size_t ack_delay = 0;
+    size_t wait = 0;
+
+    void Answer()
+    {
+        if (req == ack)
+            return;
+        if (req)
+            n_commands++;
+        data_out = n_commands;
+        ack = req;
+        wait = 0;
+    }
+
+    /* Testbench process on rising edge of "pli_clk" */
+    void Clock()
+    {
+        if (req != ack && ack_delay > 0 && ++wait >= ack_delay)
+            Answer();
+    }
+};
+
+static StandInTb tb;
+
+
+int pli_drive_vector_value(enum pli_signal signal, const uint32_t *aval, const uint32_t *)
+{
+    if (signal == PLI_SIG_REQ)
+        tb.req = aval[0] & 0x1;
+    return 0;
+}
+
+
+int pli_drive_word_value(enum pli_signal signal, uint64_t aval, uint64_t bval)
+{
+    uint32_t aval_words[2] = {static_cast<uint32_t>(aval), static_cast<uint32_t>(aval >> 32)};
+    uint32_t bval_words[2] = {static_cast<uint32_t>(bval), static_cast<uint32_t>(bval >> 32)};
+    return pli_drive_vector_value(signal, aval_words, bval_words);
+}
+
+
+int pli_read_word_value(enum pli_signal signal, uint64_t *aval, uint64_t *bval)
+{
+    *bval = 0;
+    if (signal == PLI_SIG_ACK) {
+        if (tb.ack_delay == 0)
+            tb.Answer();
+        *aval = tb.ack;
+    } else {
+        *aval = tb.data_out;
+    }
+    return 0;
+}
+
+
+/**
+ * Queues commands, and runs simulator till it processes them.
+ * @returns Number of PLI clock callbacks it took.
+ */
+uint64_t run_queued(size_t n_commands)
+{
+    for (size_t i = 0; i < n_commands; i++)
+        CanAgentDriverPushItem('0', std::chrono::nanoseconds(10));
+
+    uint64_t n_clocks = 0;
+    while (SimulatorChannelIsRequestPending())
+    {
+        tb.Clock();
+        ProcessPliClkCallback();
+        n_clocks++;
+    }
+    SimulatorChannelWaitRequestDone();
+
+    return n_clocks;
+}
+
+
+void run_benchmark(size_t ack_delay, size_t max_batch)
+{
+    const size_t n_commands = SIMULATOR_CHANNEL_QUEUE_DEPTH / 2;
+    const size_t n_rounds = 200;
+
+    tb.ack_delay = ack_delay;
+    SimulatorChannelSetMaxBatch(max_batch);
+
+    uint64_t n_clocks = 0;
+    uint64_t first_command = tb.n_commands;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < n_rounds; i++)
+        n_clocks += run_queued(n_commands);
+
+    auto end = std::chrono::steady_clock::now();
+    auto time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    size_t total = n_commands * n_rounds;
+
+    assert(tb.n_commands - first_command == total);
+
+    std::cout << "TB ack delay: " << ack_delay << ", max batch: " << max_batch
+              << ", callbacks per command: "
+              << static_cast<double>(n_clocks) / static_cast<double>(total)
+              << ", time per command: " << time_ns / static_cast<long>(total) << " ns"
+              << std::endl;
+}
+
+
+int main()
+{
+    // Callback finishes commands as fast as testbench answers them
+    tb.ack_delay = 0;
+    SimulatorChannelSetMaxBatch(1);
+    assert(run_queued(10) == 10);
+    SimulatorChannelSetMaxBatch(4);
+    assert(run_queued(10) == 3);
+
+    tb.ack_delay = 1;
+    SimulatorChannelSetMaxBatch(SIMULATOR_CHANNEL_MAX_BATCH);
+    assert(run_queued(10) == 21);
+
+    // Blocking read returns data of its own command, issued after queued commands
+    uint64_t n_commands = tb.n_commands;
+    std::atomic<bool> stop{false};
+    std::thread simulator([&]() {
+        while (!stop.load()) {
+            tb.Clock();
+            ProcessPliClkCallback();
+            std::this_thread::yield();
+        }
+    });
+    for (size_t i = 0; i < 5; i++)
+        CanAgentDriverPushItem('1', std::chrono::nanoseconds(10));
+    assert(static_cast<uint64_t>(TestControllerAgentGetSeed()) == n_commands + 6);
+
+    // Several reads in flight, each returns data of its own command
+    n_commands = tb.n_commands;
+    auto seed = TestControllerAgentGetSeedAsync();
+    CanAgentDriverPushItem('1', std::chrono::nanoseconds(10));
+    auto brp = TestControllerAgentGetBitTimingElementAsync("CFG_DUT_BRP");
+    auto mem_read = MemBusAgentRead32Async(0x4);
+    assert(static_cast<uint64_t>(mem_read.Get()) == n_commands + 4);
+    assert(static_cast<uint64_t>(brp.Get()) == n_commands + 3);
+    assert(static_cast<uint64_t>(seed.Get()) == n_commands + 1);
+    stop.store(true);
+    simulator.join();
+
+    run_benchmark(0, 1);
+    run_benchmark(0, SIMULATOR_CHANNEL_MAX_BATCH);
+    run_benchmark(1, 1);
+    run_benchmark(1, SIMULATOR_CHANNEL_MAX_BATCH);
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Unit Test for "SpscRing" class. Producer and consumer thread pass
+ *        items via the ring, consumer checks that all items arrive in order.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <cstdint>
+#include <thread>
+
+#include "../src/cosimulation/SpscRing.hpp"
+
+/* Record of similar shape as command to simulator (larger than a cache line) */
+struct Item
+{
+    uint64_t seq;
+    char payload[120];
+};
+
+
+int main()
+{
+    const uint64_t n_items = 200000;
+
+    // Full and empty queue
+    SpscRing<Item, 4> small;
+    Item item = {};
+    assert(small.Empty());
+    assert(small.Front() == nullptr);
+    for (uint64_t i = 0; i < 4; i++) {
+        item.seq = i;
+        assert(small.TryPush(item));
+    }
+    assert(!small.TryPush(item));
+    assert(small.Size() == 4);
+    assert(small.Front()->seq == 0);
+    small.Pop();
+    assert(small.TryPush(item));
+    assert(small.Front()->seq == 1);
+
+    // Items pass between threads in order
+    static SpscRing<Item, 256> ring;
+
+    std::thread producer([&]() {
+        Item prod_item = {};
+        for (uint64_t i = 0; i < n_items; i++) {
+            prod_item.seq = i;
+            prod_item.payload[i % sizeof(prod_item.payload)] = static_cast<char>(i);
+            while (!ring.TryPush(prod_item))
+                std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    while (expected < n_items) {
+        Item *front = ring.Front();
+        if (front == nullptr) {
+            std::this_thread::yield();
+            continue;
+        }
+        assert(front->seq == expected);
+        assert(front->payload[expected % sizeof(front->payload)] ==
+               static_cast<char>(expected));
+        ring.Pop();
+        expected++;
+    }
+
+    producer.join();
+    assert(ring.Empty());
+
+    return 0;
+}
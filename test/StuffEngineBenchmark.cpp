@@ -0,0 +1,165 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ *
+ * @brief Benchmark of "StuffEngine" class. Stuffs bit streams of frames of all kinds and
+ *        data lengths (as "BitFrame" does) by word-parallel and by reference (bit by bit)
+ *        implementation, and reports wall time of both.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../src/can_lib/can.h"
+#include "../src/can_lib/Frame.h"
+#include "../src/can_lib/FrameFlags.h"
+#include "../src/can_lib/BitTiming.h"
+#include "../src/can_lib/BitFrame.h"
+#include "../src/can_lib/Bit.h"
+#include "../src/can_lib/StuffEngine.h"
+
+using namespace can;
+
+
+/**
+ * Stream of bits of a frame which is stuffed by regular stuff bits.
+ */
+struct Stream
+{
+    std::vector<uint64_t> words;
+    size_t n_bits;
+    bool stuff_last;
+    size_t n_stuff;
+};
+
+
+/**
+ * Packs bits of frame after SOF till Stuff count (CAN FD) or CRC delimiter (CAN 2.0),
+ * without stuff bits.
+ */
+Stream pack_frame(BitFrame &frm)
+{
+    Stream stream = {{}, 0, true, 0};
+
+    for (size_t i = 1; i < frm.GetLen(); i++)
+    {
+        Bit *bit = frm.GetBit(i);
+        if (bit->kind_ == BitKind::StuffCnt)
+            stream.stuff_last = false;
+        if (bit->kind_ == BitKind::StuffCnt || bit->kind_ == BitKind::CrcDelim)
+            break;
+        if (bit->stuff_kind_ == StuffKind::Normal) {
+            stream.n_stuff++;
+            continue;
+        }
+        if (stream.n_bits % 64 == 0)
+            stream.words.push_back(0);
+        stream.words.back() |= static_cast<uint64_t>(bit->val_) << (stream.n_bits % 64);
+        stream.n_bits++;
+    }
+    return stream;
+}
+
+
+int main()
+{
+    srand(1234);
+
+    BitTiming nbt = BitTiming(7, 5, 6, 4, 3);
+    BitTiming dbt = BitTiming(5, 3, 4, 1, 2);
+
+    FrameKind frame_kinds[] = {FrameKind::Can20, FrameKind::CanFd};
+    IdentKind ident_kinds[] = {IdentKind::Base, IdentKind::Ext};
+
+    // Frames with random and with constant data (long runs of equal bits)
+    std::vector<Stream> streams;
+    for (int iter = 0; iter < 10; iter++)
+        for (auto frame_kind : frame_kinds)
+            for (auto ident_kind : ident_kinds)
+                for (uint8_t dlc = 0; dlc < 16; dlc++)
+                {
+                    uint8_t data[64];
+                    for (int i = 0; i < 64; i++)
+                        data[i] = (iter % 2) ? static_cast<uint8_t>(rand() % 256) : 0x00;
+
+                    FrameFlags flags = FrameFlags(frame_kind, ident_kind, RtrFlag::Data,
+                                                  BrsFlag::NoShift, EsiFlag::ErrAct);
+                    Frame frm(flags, dlc, rand() % CAN_BASE_ID_MAX, data);
+                    BitFrame bit_frm(frm, &nbt, &dbt);
+                    streams.push_back(pack_frame(bit_frm));
+                }
+
+    const int n_rounds = 200;
+    std::vector<uint32_t> stuff_pos;
+    std::vector<uint32_t> stuff_pos_ref;
+    size_t n_bits = 0;
+    size_t n_stuff = 0;
+    StuffEngine engine;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < n_rounds; round++)
+        for (auto &stream : streams)
+        {
+            stuff_pos.clear();
+            engine.Reset();
+            n_stuff += engine.Stuff(stream.words.data(), stream.n_bits, stream.stuff_last,
+                                    nullptr, &stuff_pos);
+            n_bits += stream.n_bits;
+        }
+    auto mid = std::chrono::steady_clock::now();
+    size_t n_stuff_ref = 0;
+    for (int round = 0; round < n_rounds; round++)
+        for (auto &stream : streams)
+        {
+            stuff_pos_ref.clear();
+            engine.Reset();
+            n_stuff_ref += engine.StuffRef(stream.words.data(), stream.n_bits,
+                                           stream.stuff_last, nullptr, &stuff_pos_ref);
+        }
+    auto end = std::chrono::steady_clock::now();
+
+    // Both implementations shall insert as many stuff bits as BitFrame did
+    size_t n_stuff_frm = 0;
+    for (auto &stream : streams)
+        n_stuff_frm += stream.n_stuff;
+    assert(n_stuff == n_stuff_ref);
+    assert(n_stuff == n_stuff_frm * n_rounds);
+
+    auto time_us = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+    auto time_ref_us = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+
+    std::cout << "Streams stuffed:       " << streams.size() * n_rounds << std::endl;
+    std::cout << "Bits stuffed:          " << n_bits << std::endl;
+    std::cout << "Stuff bits inserted:   " << n_stuff << std::endl;
+    std::cout << "Word-parallel time:    " << time_us << " us" << std::endl;
+    std::cout << "Bit by bit time:       " << time_ref_us << " us" << std::endl;
+
+    return 0;
+}
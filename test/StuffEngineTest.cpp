@@ -0,0 +1,190 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Unit Test for "StuffEngine" class. Compares word-parallel stuffing against
+ *        reference implementation which processes bits one by one.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../src/can_lib/can.h"
+#include "../src/can_lib/StuffEngine.h"
+
+using namespace can;
+
+
+/**
+ * Generates stream of bits with runs of equal bits of random length (so that stream
+ * contains long runs which need to be stuffed).
+ */
+std::vector<uint64_t> rand_stream(size_t n_bits)
+{
+    std::vector<uint64_t> words((n_bits + 63) / 64 + 1, 0);
+    uint64_t val = static_cast<uint64_t>(rand() % 2);
+    size_t pos = 0;
+
+    while (pos < n_bits)
+    {
+        size_t run = static_cast<size_t>(rand() % 9) + 1;
+        for (size_t i = 0; i < run && pos < n_bits; i++, pos++)
+            words[pos / 64] |= val << (pos % 64);
+        val ^= 0x1;
+    }
+    return words;
+}
+
+
+void compare_engines(StuffEngine &fast, StuffEngine &ref, std::vector<uint64_t> &in,
+                     size_t n_bits, bool stuff_last)
+{
+    std::vector<uint64_t> out_fast, out_ref;
+    std::vector<uint32_t> pos_fast, pos_ref;
+
+    size_t n_fast = fast.Stuff(in.data(), n_bits, stuff_last, &out_fast, &pos_fast);
+    size_t n_ref = ref.StuffRef(in.data(), n_bits, stuff_last, &out_ref, &pos_ref);
+
+    assert(n_fast == n_ref);
+    assert(pos_fast == pos_ref);
+    assert(out_fast == out_ref);
+    assert(fast.prev_val() == ref.prev_val());
+    assert(fast.same_bits() == ref.same_bits());
+    assert(fast.stuff_cnt() == ref.stuff_cnt());
+}
+
+
+/**
+ * Stuffs stream from scratch, and again in two parts, resuming at each run of 5 equal
+ * bits which ends by stuff bit. Bits before the stuff bit end by run of 5 equal bits
+ * (state which can't be resumed), so stuffing is resumed from first bit of the run.
+ * Both shall give the same stuffed stream.
+ */
+void check_resume_before_stuff_bit(std::vector<uint64_t> &in, size_t n_bits)
+{
+    StuffEngine whole;
+    std::vector<uint64_t> out_whole;
+    std::vector<uint32_t> pos_whole;
+    whole.Stuff(in.data(), n_bits, true, &out_whole, &pos_whole);
+
+    for (uint32_t stuff_pos : pos_whole)
+    {
+        // Run of 5 equal bits ending with 'stuff_pos' starts by stuff bit, or by input bit
+        size_t from = (stuff_pos >= 4) ? stuff_pos - 4 : 0;
+        bool after_stuff = std::find(pos_whole.begin(), pos_whole.end(),
+                                     static_cast<uint32_t>(from)) != pos_whole.end();
+        if (stuff_pos >= 4 && after_stuff)
+            from++;
+
+        std::vector<uint64_t> head(in.size(), 0), tail(in.size(), 0);
+        for (size_t j = 0; j < from; j++)
+            head[j / 64] |= ((in[j / 64] >> (j % 64)) & 0x1) << (j % 64);
+        for (size_t j = from; j < n_bits; j++)
+            tail[(j - from) / 64] |= ((in[j / 64] >> (j % 64)) & 0x1) << ((j - from) % 64);
+
+        StuffEngine parts;
+        std::vector<uint64_t> out_head, out_tail;
+        std::vector<uint32_t> pos_head, pos_tail;
+        parts.Stuff(head.data(), from, true, &out_head, &pos_head);
+        assert(parts.same_bits() < 5);
+        parts.Stuff(tail.data(), n_bits - from, true, &out_tail, &pos_tail);
+
+        // Concatenate stuffed parts and compare them with stream stuffed at once
+        std::vector<uint32_t> pos_parts = pos_head;
+        for (uint32_t pos : pos_tail)
+            pos_parts.push_back(pos + static_cast<uint32_t>(from));
+        assert(pos_parts == pos_whole);
+
+        size_t head_len = from + pos_head.size();
+        size_t tail_len = n_bits - from + pos_tail.size();
+        for (size_t j = 0; j < head_len + tail_len; j++)
+        {
+            uint64_t exp = (out_whole[j / 64] >> (j % 64)) & 0x1;
+            uint64_t act = (j < head_len) ?
+                            (out_head[j / 64] >> (j % 64)) & 0x1 :
+                            (out_tail[(j - head_len) / 64] >> ((j - head_len) % 64)) & 0x1;
+            assert(exp == act);
+        }
+        assert(parts.prev_val() == whole.prev_val());
+        assert(parts.same_bits() == whole.same_bits());
+        assert(parts.stuff_cnt() == whole.stuff_cnt());
+    }
+}
+
+
+int main()
+{
+    srand(1234);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        size_t n_bits = static_cast<size_t>(rand() % 700);
+        std::vector<uint64_t> in = rand_stream(n_bits);
+        bool stuff_last = rand() % 2;
+
+        // Random initial state, stream is stuffed in two parts
+        StuffEngine fast, ref;
+        BitVal prev_val = static_cast<BitVal>(rand() % 2);
+        size_t same_bits = static_cast<size_t>(rand() % 4) + 1;
+        fast.SetState(prev_val, same_bits, 0);
+        ref.SetState(prev_val, same_bits, 0);
+
+        size_t split = n_bits ? static_cast<size_t>(rand()) % n_bits : 0;
+        std::vector<uint64_t> tail = std::vector<uint64_t>(in.size(), 0);
+        for (size_t j = split; j < n_bits; j++)
+            tail[(j - split) / 64] |= ((in[j / 64] >> (j % 64)) & 0x1) << ((j - split) % 64);
+
+        compare_engines(fast, ref, in, split, true);
+        compare_engines(fast, ref, tail, n_bits - split, stuff_last);
+    }
+
+    // Bits which end by run of 5 equal bits are stuffed again from first bit of the run
+    for (int i = 0; i < 2000; i++)
+    {
+        size_t n_bits = static_cast<size_t>(rand() % 300);
+        std::vector<uint64_t> in = rand_stream(n_bits);
+        check_resume_before_stuff_bit(in, n_bits);
+    }
+
+    // Stuff count is encoded in Gray code, parity is even parity of encoded value
+    uint8_t exp_enc[] = {0b000, 0b001, 0b011, 0b010, 0b110, 0b111, 0b101, 0b100};
+    uint8_t exp_par[] = {0, 1, 0, 1, 0, 1, 0, 1};
+    for (size_t cnt = 0; cnt < 16; cnt++)
+    {
+        StuffEngine engine;
+        engine.SetState(BitVal::Dominant, 1, cnt);
+        assert(engine.stuff_cnt() == cnt % 8);
+        assert(engine.stuff_cnt_encoded() == exp_enc[cnt % 8]);
+        assert(engine.stuff_parity() == exp_par[cnt % 8]);
+    }
+
+    std::cout << "Stuff engine matches reference implementation" << std::endl;
+
+    return 0;
+}
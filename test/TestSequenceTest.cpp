@@ -0,0 +1,255 @@
+/******************************************************************************
+ *
+ * ISO16845 Compliance tests
+ * Copyright (C) 2021-present Ondrej Ille
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this SW component and associated documentation files (the "Component"),
+ * to use, copy, modify, merge, publish, distribute the Component for
+ * educational, research, evaluation, self-interest purposes. Using the
+ * Component for commercial purposes is forbidden unless previously agreed with
+ * Copyright holder.
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Component.
+ *
+ * THE COMPONENT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHTHOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE COMPONENT OR THE USE OR OTHER DEALINGS
+ * IN THE COMPONENT.
+ *
+ * @author Ondrej Ille, <ondrej.ille@gmail.com>
+ * @date 16.10.2026
+ *
+ * @brief Unit Test for compilation of frames to test sequence. Items of test
+ *        sequence shall have the same values and durations as cycles of the
+ *        frame, runs of equal value shall be merged across bits, and messages
+ *        shall be only at start of runs. Sequence written to sequence file
+ *        shall be read back equal. Compiled sequence is then driven and
+ *        monitored in loopback simulator.
+ *****************************************************************************/
+
+#undef NDEBUG
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "../src/can_lib/can.h"
+#include "../src/can_lib/Frame.h"
+#include "../src/can_lib/FrameFlags.h"
+#include "../src/can_lib/BitTiming.h"
+#include "../src/can_lib/BitFrame.h"
+#include "../src/can_lib/Bit.h"
+#include "../src/test_lib/TestSequence.h"
+#include "../src/test_lib/SequenceFile.h"
+#include "../src/cosimulation/LoopbackSimulator.hpp"
+
+using namespace can;
+using namespace test;
+
+static const std::chrono::nanoseconds clk_period = std::chrono::nanoseconds(10);
+static const char *sequence_test_name = "sequence_test";
+static std::thread test_thread;
+static TestSequence *loopback_seq = nullptr;
+
+
+/**
+ * Checks that driver items cover cycles of the frame with equal values.
+ * @returns Number of driver items.
+ */
+static size_t check_driver_items(TestSequence &seq, BitFrame &frm)
+{
+    size_t n_items = 0;
+    size_t item_end = 0;
+    DrvItem *item = nullptr;
+    size_t cycle = 0;
+
+    for (size_t i = 0; i < frm.GetLen(); i++)
+    {
+        Bit *bit = frm.GetBit(i);
+        for (size_t j = 0; j < bit->GetLenCycles(); j++, cycle++)
+        {
+            if (cycle == item_end) {
+                DrvItem *next = seq.GetDriverItem(static_cast<int>(n_items++));
+                assert(next != nullptr);
+
+                // Adjacent items differ, and each of them starts a run of some field
+                assert(item == nullptr || item->value_ != next->value_);
+                assert(next->HasMessage());
+                item = next;
+                item_end = cycle + item->cycles_;
+            }
+            char val = (bit->GetCycle(j).bit_val() == BitVal::Dominant) ? '0' : '1';
+            assert(static_cast<char>(item->value_) == val);
+        }
+    }
+    assert(cycle == item_end);
+    assert(seq.GetDriverItem(static_cast<int>(n_items)) == nullptr);
+
+    return n_items;
+}
+
+
+/**
+ * Drives and monitors compiled sequence in loopback simulator.
+ */
+static void RunSequenceTest()
+{
+    ClockAgentSetPeriod(loopback_seq->GetClockPeriod());
+    CanAgentMonitorSetTrigger(CanAgentMonitorTrigger::DriverStart);
+
+    loopback_seq->PushDriverValuesToSimulator();
+    loopback_seq->PushMonitorValuesToSimulator();
+    CanAgentMonitorStart();
+    CanAgentDriverStart();
+    CanAgentMonitorWaitFinish();
+    CanAgentDriverWaitFinish();
+
+    bool passed = (CanAgentMonitorGetState() == CanAgentMonitorState::Passed);
+    CanAgentMonitorStop();
+    TestControllerAgentEndTest(passed);
+}
+
+
+/**
+ * Called by PLI library once simulator passes control to test.
+ */
+extern "C" void RunCppTest(char *test_name)
+{
+    assert(strcmp(test_name, sequence_test_name) == 0);
+    test_thread = std::thread(RunSequenceTest);
+}
+
+
+int main()
+{
+    BitTiming nbt = BitTiming(7, 5, 6, 4, 3);
+    BitTiming dbt = BitTiming(5, 3, 4, 1, 2);
+    uint8_t data[64] = {0x00, 0xFF, 0xAA, 0x55};
+
+    FrameFlags flags = FrameFlags(FrameKind::CanFd, IdentKind::Base, RtrFlag::Data,
+                                  BrsFlag::DoShift, EsiFlag::ErrAct);
+    Frame gold_frm(flags, 0x4, 0x2AA, data);
+
+    BitFrame drv_bit_frm(gold_frm, &nbt, &dbt);
+    BitFrame mon_bit_frm(drv_bit_frm);
+
+    drv_bit_frm.ConvRXFrame();
+    drv_bit_frm.GetBitOf(0, BitKind::Ack)->ForceTQ(1, BitVal::Recessive);
+    mon_bit_frm.InsertActErrFrm(0, BitKind::Data);
+
+    TestSequence seq(clk_period, drv_bit_frm, mon_bit_frm);
+    const TestSequence::Stats &stats = seq.GetStats();
+    seq.PrintStats();
+
+    assert(stats.bits == drv_bit_frm.GetLen() + mon_bit_frm.GetLen());
+    assert(stats.driver_items_after == check_driver_items(seq, drv_bit_frm));
+
+    // Recessive bits (error delimiter, EOF, intermission) are merged into few items
+    assert(stats.driver_items_after * 10 < stats.driver_items_before);
+    assert(stats.monitor_items_after < stats.monitor_items_before);
+
+    // Monitor items cover monitored frame, adjacent items differ
+    size_t mon_cycles = 0;
+    for (size_t i = 0; i < stats.monitor_items_after; i++)
+    {
+        MonItem *item = seq.GetMonitorItem(static_cast<int>(i));
+        MonItem *prev = (i > 0) ? seq.GetMonitorItem(static_cast<int>(i - 1)) : nullptr;
+        assert(item != nullptr && item->HasMessage());
+        assert(prev == nullptr || prev->value_ != item->value_ ||
+               prev->sample_cycles_ != item->sample_cycles_);
+        mon_cycles += item->cycles_;
+    }
+    assert(mon_cycles == mon_bit_frm.GetLenCycles());
+
+    // Without messages, items are the same
+    TestSequence seq_no_msg(clk_period, drv_bit_frm, mon_bit_frm, SequenceMessages::None);
+    assert(seq_no_msg.GetStats().driver_items_after == stats.driver_items_after);
+    assert(seq_no_msg.GetStats().monitor_items_after == stats.monitor_items_after);
+    assert(!seq_no_msg.GetDriverItem(0)->HasMessage());
+    assert(!seq_no_msg.GetMonitorItem(0)->HasMessage());
+
+    // Items refer to interned names of bit kinds
+    PliMessageId sof_msg = SimulatorChannelInternMessage("SOF");
+    assert(sof_msg != PLI_MESSAGE_NONE);
+    assert(SimulatorChannelInternMessage("SOF") == sof_msg);
+    assert(SimulatorChannelGetMessage(sof_msg) == "SOF");
+    assert(seq.GetMonitorItem(0)->message_id_ == sof_msg);
+    assert(SimulatorChannelInternMessage("") == PLI_MESSAGE_NONE);
+    assert(SimulatorChannelGetMessage(PLI_MESSAGE_NONE).empty());
+
+    std::string long_msg(PLI_STR_BUF_MAX_MSG_LEN + 10, 'a');
+    PliMessageId long_msg_id = SimulatorChannelInternMessage(long_msg);
+    assert(SimulatorChannelGetMessage(long_msg_id).size() == PLI_STR_BUF_MAX_MSG_LEN);
+    assert(SimulatorChannelInternMessage(long_msg.substr(0, PLI_STR_BUF_MAX_MSG_LEN)) ==
+           long_msg_id);
+    assert(sizeof(DrvItem) == 8);
+
+    // Sequence file holds the same items
+    std::string path = "test_sequence_test.seq";
+    assert(SequenceFile::Write(path, seq));
+    SequenceFile file;
+    assert(file.Open(path));
+    assert(file.GetClockPeriod() == clk_period);
+    assert(file.GetNumDriverItems() == stats.driver_items_after);
+    assert(file.GetNumMonitorItems() == stats.monitor_items_after);
+
+    TestSequence read_seq(clk_period);
+    file.Read(read_seq);
+    for (size_t i = 0; i < stats.driver_items_after; i++)
+    {
+        DrvItem *item = seq.GetDriverItem(static_cast<int>(i));
+        DrvItem *read_item = read_seq.GetDriverItem(static_cast<int>(i));
+        assert(item->value_ == read_item->value_ && item->cycles_ == read_item->cycles_ &&
+               item->message_id_ == read_item->message_id_);
+    }
+    for (size_t i = 0; i < stats.monitor_items_after; i++)
+    {
+        MonItem *item = seq.GetMonitorItem(static_cast<int>(i));
+        MonItem *read_item = read_seq.GetMonitorItem(static_cast<int>(i));
+        assert(item->value_ == read_item->value_ && item->cycles_ == read_item->cycles_ &&
+               item->sample_cycles_ == read_item->sample_cycles_ &&
+               item->message_id_ == read_item->message_id_);
+    }
+    std::cout << "Sequence file: " << file.GetSize() << " bytes" << std::endl;
+    file.Close();
+
+    // Corrupted file is refused
+    {
+        std::ofstream corrupted(path, std::ios::binary | std::ios::in | std::ios::out);
+        corrupted.seekp(SEQUENCE_FILE_HEADER_SIZE);
+        corrupted.put('\xFF');
+    }
+    assert(!file.Open(path));
+
+    // File with value of item which is not std_logic is refused (sequence without
+    // messages, so that first driver item follows header)
+    assert(SequenceFile::Write(path, seq_no_msg));
+    assert(file.Open(path));
+    file.Close();
+    {
+        std::ofstream corrupted(path, std::ios::binary | std::ios::in | std::ios::out);
+        corrupted.seekp(SEQUENCE_FILE_HEADER_SIZE);
+        corrupted.put('Q');
+    }
+    assert(!file.Open(path));
+    std::remove(path.c_str());
+
+    // Monitor shall see exactly what driver drives. Clock period which is not whole
+    // nanoseconds is not truncated.
+    TestSequence loop_seq(PliFemtoseconds(2500000), mon_bit_frm, mon_bit_frm);
+    loopback_seq = &loop_seq;
+    LoopbackResult result = LoopbackSimulatorRun(sequence_test_name);
+    test_thread.join();
+    assert(result.test_ended && result.passed);
+    assert(result.sim_time >= mon_bit_frm.GetLenCycles() * 2500000ULL);
+
+    return 0;
+}